@@ -10,25 +10,22 @@
 #include "mcb.h"
 #include <string.h>
 
+#ifdef MCB_READ_CACHE
+/** Read cache slot of a register */
+#define Mcb_CacheIdx(u16Node, u16Addr) \
+    ((uint16_t)(((uint16_t)(u16Addr) ^ (uint16_t)((u16Node) << 8U)) % MCB_READ_CACHE_SZ))
+#endif
+
 #define ADDR_COMM_STATE     (uint16_t)0x640
 #define ADDR_CYCLIC_MODE    (uint16_t)0x641
 #define RX_MAP_BASE         (uint16_t)0x650
 #define TX_MAP_BASE         (uint16_t)0x660
+/** Every Rx & Tx mapping entry to be written */
+#define MCB_MAP_STALE_ALL   (uint32_t)0xFFFFFFFFUL
 
 #define WORDSIZE_16BIT      1
 #define WORDSIZE_32BIT      2
 
-/**
- * Handles a MCB config request received in cyclic mode.
- *
- * @param[in] ptInst
- *  Specifies the target MCB instance.
- * @param[in] pMcbMsg
- *  Pointer to the received config request.
- */
-static void
-Mcb_ConfigOverCyclicCompl(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
-
 /**
  * Generic blocking getinfo function
  *
@@ -95,6 +92,311 @@ Mcb_NonBlockingRead(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
 static void
 Mcb_NonBlockingWrite(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
 
+/**
+ * Computes the signature of the current Rx & Tx mapping lists
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ *
+ * @retval Mapping signature
+ */
+static uint32_t
+Mcb_MapSignature(const Mcb_TInst* ptInst);
+
+/**
+ * Computes the cyclic size of a batch mapping table
+ *
+ * @param[in] ptTable
+ *  Mapping table
+ * @param[in] u8Num
+ *  Number of entries
+ *
+ * @retval Cyclic size (words) of the whole table
+ */
+static uint32_t
+Mcb_MapTableSize(const Mcb_TMapEntry* ptTable, uint8_t u8Num);
+
+/**
+ * Reads a mapping register of the slave
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] u16Addr
+ *  Mapping counter or entry address
+ * @param[out] pu16Data
+ *  Read data, MCB_MAX_DATA_SZ words
+ *
+ * @retval true if read, false otherwise
+ */
+static bool
+Mcb_MapRead(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t* pu16Data);
+
+/**
+ * Checks if the slave keeps the current mapping, reading back its counters
+ * and every entry
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[out] pu32Stale
+ *  Entries not matching the mapping lists, bit i for Rx entry i and bit
+ *  MAX_MAPPED_REG + i for Tx entry i
+ *
+ * @retval true if the slave mapping matches the mapping lists, false otherwise
+ */
+static bool
+Mcb_MapVerify(Mcb_TInst* ptInst, uint32_t* pu32Stale);
+
+/**
+ * Writes the Rx & Tx mapping entries into the slave, then both counters,
+ * pipelined
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] u32Stale
+ *  Entries to be written, as reported by Mcb_MapVerify
+ *
+ * @retval CYCLIC_MODE_OK if written, error code otherwise
+ */
+static int32_t
+Mcb_MapReplay(Mcb_TInst* ptInst, uint32_t u32Stale);
+
+/**
+ * Serves a config read from the read cache
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in, out] pMcbMsg
+ *  Request to be served, loaded with the cached reply on hit
+ * @param[in] isLearn
+ *  If true and the register access type is unknown, it is requested
+ *  through a blocking get info
+ *
+ * @retval true on cache hit, false otherwise
+ */
+static bool
+Mcb_CacheLoad(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg, bool isLearn);
+
+/**
+ * Stores the reply of a config read into the read cache, if its policy allows it
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] pMcbMsg
+ *  Successful read reply
+ */
+static void
+Mcb_CacheStore(Mcb_TInst* ptInst, const Mcb_TMsg* pMcbMsg);
+
+/**
+ * Sets the read cache policy of a register from its get info reply
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] pMcbInfoMsg
+ *  Successful get info reply
+ */
+static void
+Mcb_CacheLearn(Mcb_TInst* ptInst, const Mcb_TInfoMsg* pMcbInfoMsg);
+
+/**
+ * Drops the cached value of a register written through the instance
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] u16Node
+ *  Register node
+ * @param[in] u16Addr
+ *  Register address
+ */
+static void
+Mcb_CacheInvalidate(Mcb_TInst* ptInst, uint16_t u16Node, uint16_t u16Addr);
+
+/**
+ * Sleeps until the next IRQ event, bounded by the blocking timeout
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] u32Millis
+ *  Start time of the blocking request
+ */
+static void
+Mcb_BlockingWait(Mcb_TInst* ptInst, uint32_t u32Millis);
+
+/**
+ * Writes the communication state to start cyclic mode with the current
+ * mapping
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ *
+ * @retval > 0 if transition successful, indicating the cyclic size.
+ *         < 0 indicates an errorcode.
+ */
+static int32_t
+Mcb_CyclicStart(Mcb_TInst* ptInst);
+
+/**
+ * Queues a config over cyclic request
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] pMcbMsg
+ *  Request to be queued
+ * @param[in] ptUsr
+ *  Submitted user message completed through its callback, NULL if none
+ * @param[out] pu8Slot
+ *  Slot of the queued request, may be NULL
+ *
+ * @retval true if the request has been queued, false if the queue is full,
+ *         or not empty for a write larger than a queue slot
+ */
+static bool
+Mcb_CfgQueuePush(Mcb_TInst* ptInst, const Mcb_TMsg* pMcbMsg, Mcb_TMsg* ptUsr, uint8_t* pu8Slot);
+
+/**
+ * Queues a config over cyclic request and waits for its reply
+ *
+ * @note A full queue is waited on. If the timeout expires the request is
+ *       given up, the reply is then dropped by the consumer instead of being
+ *       written into the message
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in,out] pMcbMsg
+ *  Request to be sent and loaded with the reply
+ * @param[in] u32Millis
+ *  Start time of the request
+ *
+ * @retval true if the reply has been received, false otherwise
+ */
+static bool
+Mcb_CfgQueueSend(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg, uint32_t u32Millis);
+
+/**
+ * Loads the oldest queued request as active config over cyclic request
+ *
+ * @note Nothing is done if a config request is still in progress. Requests
+ *       given up by their caller are dropped, even if they are on the bus
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ *
+ * @retval true if a new request has been loaded, false otherwise
+ */
+static bool
+Mcb_CfgQueuePop(Mcb_TInst* ptInst);
+
+/**
+ * Loads a queued request into the config message
+ *
+ * @note The data of writes larger than a queue slot is already there
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] ptEntry
+ *  Queued request
+ */
+static void
+Mcb_CfgQueueLoad(Mcb_TInst* ptInst, const Mcb_TCfgQueueEntry* ptEntry);
+
+/**
+ * Serves the active config over cyclic request, on the config message
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[out] pisCfgData
+ *  Indicates if the next frame carries config data
+ *
+ * @retval Status of the active request, MCB_STANDBY if there is none
+ */
+static Mcb_EStatus
+Mcb_CfgQueueServe(Mcb_TInst* ptInst, bool* pisCfgData);
+
+/**
+ * Completes the oldest queued request, publishing the reply held by the
+ * config message and releasing its slot
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] isReply
+ *  Indicates if the slot holds a reply, false if the request has been dropped
+ */
+static void
+Mcb_CfgQueueDone(Mcb_TInst* ptInst, bool isReply);
+
+/**
+ * Checks if config over cyclic requests are queued or in progress
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ *
+ * @retval true if busy, false otherwise
+ */
+static bool
+Mcb_CfgQueueIsBusy(const Mcb_TInst* ptInst);
+
+/**
+ * Discards all queued config over cyclic requests
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ */
+static void
+Mcb_CfgQueueFlush(Mcb_TInst* ptInst);
+
+/**
+ * Completes a submitted request, copying its reply and calling its callback
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ * @param[in] ptUsr
+ *  Submitted user message
+ * @param[in] pMcbMsg
+ *  Reply, NULL if it is already stored in the user message
+ */
+static void
+Mcb_SubmitCompl(Mcb_TInst* ptInst, Mcb_TMsg* ptUsr, const Mcb_TMsg* pMcbMsg);
+
+/**
+ * Gets the cyclic transmission data to be sent
+ *
+ * @note With MCB_CYCLIC_TX_TRIPLE, it picks up the newest published set
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ *
+ * @retval Cyclic transmission data
+ */
+static uint16_t*
+Mcb_CyclicTxFront(Mcb_TInst* ptInst);
+
+/**
+ * Flags the cyclic reception buffer as being updated
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ */
+static void
+Mcb_CyclicRxBegin(Mcb_TInst* ptInst);
+
+/**
+ * Publishes the update of the cyclic reception buffer
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ */
+static void
+Mcb_CyclicRxEnd(Mcb_TInst* ptInst);
+
+/**
+ * Discards all submitted requests
+ *
+ * @param[in] ptInst
+ *  Specifies the target instance
+ */
+static void
+Mcb_SubmitFlush(Mcb_TInst* ptInst);
+
 
 int32_t Mcb_Init(Mcb_TInst* ptInst, Mcb_EMode eMode, uint16_t u16Id, bool bCalcCrc, uint32_t u32Timeout)
 {
@@ -107,7 +409,7 @@ int32_t Mcb_Init(Mcb_TInst* ptInst, Mcb_EMode eMode, uint16_t u16Id, bool bCalcC
         ptInst->Mcb_GetInfo = Mcb_BlockingGetInfo;
         ptInst->Mcb_Read = Mcb_BlockingRead;
         ptInst->Mcb_Write = Mcb_BlockingWrite;
-        ptInst->CfgOverCyclicEvnt = Mcb_ConfigOverCyclicCompl;
+        ptInst->CfgOverCyclicEvnt = NULL;
     }
     else
     {
@@ -118,6 +420,15 @@ int32_t Mcb_Init(Mcb_TInst* ptInst, Mcb_EMode eMode, uint16_t u16Id, bool bCalcC
     }
     ptInst->u32Timeout = u32Timeout;
     ptInst->eSyncMode = MCB_CYC_NON_SYNC;
+    ptInst->u32CyclicRxSeq = (uint32_t)0UL;
+    Mcb_CfgQueueFlush(ptInst);
+    Mcb_SubmitFlush(ptInst);
+    ptInst->u32MapSign = (uint32_t)0UL;
+#ifdef MCB_READ_CACHE
+    Mcb_ReadCacheFlush(ptInst);
+    ptInst->tReadCache.u32Hits = (uint32_t)0UL;
+    ptInst->tReadCache.u32Misses = (uint32_t)0UL;
+#endif
 
     ptInst->tCyclicRxList.u8Mapped = (uint8_t)0;
     ptInst->tCyclicTxList.u8Mapped = (uint8_t)0;
@@ -135,6 +446,7 @@ int32_t Mcb_Init(Mcb_TInst* ptInst, Mcb_EMode eMode, uint16_t u16Id, bool bCalcC
     ptInst->tIntf.u16Id = u16Id;
     ptInst->tIntf.bCalcCrc = bCalcCrc;
     Mcb_IntfInit(&ptInst->tIntf);
+    ptInst->u16Node = DEFAULT_MOCO_NODE;
 
     if (Mcb_IntfReadIRQ(u16Id) == (uint8_t)0)
     {
@@ -154,6 +466,9 @@ void Mcb_Deinit(Mcb_TInst* ptInst)
     ptInst->Mcb_Read = NULL;
     ptInst->Mcb_Write = NULL;
     ptInst->CfgOverCyclicEvnt = NULL;
+    Mcb_CfgQueueFlush(ptInst);
+    Mcb_SubmitFlush(ptInst);
+    ptInst->u32MapSign = (uint32_t)0UL;
 
     ptInst->tCyclicRxList.u8Mapped = (uint8_t)0;
     ptInst->tCyclicTxList.u8Mapped = (uint8_t)0;
@@ -187,26 +502,26 @@ static void Mcb_BlockingGetInfo(Mcb_TInst* ptInst, Mcb_TInfoMsg* pMcbInfoMsg)
                 Mcb_IntfReset(&ptInst->tIntf);
                 break;
             }
+
+            /** Sleep until the reply is clocked in */
+            if (pMcbInfoMsg->eStatus == MCB_GETINFO_ANSWER)
+            {
+                Mcb_BlockingWait(ptInst, u32Millis);
+            }
         } while ((pMcbInfoMsg->eStatus != MCB_GETINFO_ERROR)
                 && (pMcbInfoMsg->eStatus != MCB_GETINFO_SUCCESS));
+
+        if (pMcbInfoMsg->eStatus == MCB_GETINFO_SUCCESS)
+        {
+            Mcb_CacheLearn(ptInst, pMcbInfoMsg);
+        }
     }
     else
     {
-        memcpy((void*)&ptInst->tConfigReq, (const void*)pMcbInfoMsg, sizeof(Mcb_TMsg));
-        memcpy((void*)&ptInst->tConfigRpy, (const void*)pMcbInfoMsg, sizeof(Mcb_TMsg));
-        ptInst->ptUsrConfig = (Mcb_TMsg*)pMcbInfoMsg;
-        ptInst->tIntf.isNewCfgOverCyclic = true;
-
-        do
+        if (Mcb_CfgQueueSend(ptInst, (Mcb_TMsg*)pMcbInfoMsg, u32Millis) == false)
         {
-            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
-            {
-                pMcbInfoMsg->eStatus = MCB_GETINFO_ERROR;
-                Mcb_IntfReset(&ptInst->tIntf);
-                break;
-            }
-        } while ((ptInst->tIntf.isNewCfgOverCyclic == true)
-                || (ptInst->tIntf.isCfgOverCyclic == true));
+            pMcbInfoMsg->eStatus = MCB_GETINFO_ERROR;
+        }
     }
 
     if (pMcbInfoMsg->eStatus == MCB_GETINFO_ERROR)
@@ -226,37 +541,40 @@ static void Mcb_BlockingRead(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
 
     if (ptInst->isCyclic == false)
     {
-        do
+        if (Mcb_CacheLoad(ptInst, pMcbMsg, true) == false)
         {
-            pMcbMsg->eStatus = Mcb_IntfRead(&ptInst->tIntf, pMcbMsg->u16Node, pMcbMsg->u16Addr,
-                                            &pMcbMsg->u16Data[0], &pMcbMsg->u16Size);
+            do
+            {
+                pMcbMsg->eStatus = Mcb_IntfRead(&ptInst->tIntf, pMcbMsg->u16Node, pMcbMsg->u16Addr,
+                                                &pMcbMsg->u16Data[0], &pMcbMsg->u16Size);
 
-            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
+                if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
+                {
+                    pMcbMsg->eStatus = MCB_READ_ERROR;
+                    Mcb_IntfReset(&ptInst->tIntf);
+                    break;
+                }
+
+                /** Sleep until the reply is clocked in */
+                if (pMcbMsg->eStatus == MCB_READ_ANSWER)
+                {
+                    Mcb_BlockingWait(ptInst, u32Millis);
+                }
+            } while((pMcbMsg->eStatus != MCB_READ_ERROR)
+                    && (pMcbMsg->eStatus != MCB_READ_SUCCESS));
+
+            if (pMcbMsg->eStatus == MCB_READ_SUCCESS)
             {
-                pMcbMsg->eStatus = MCB_READ_ERROR;
-                Mcb_IntfReset(&ptInst->tIntf);
-                break;
+                Mcb_CacheStore(ptInst, pMcbMsg);
             }
-        } while((pMcbMsg->eStatus != MCB_READ_ERROR)
-                && (pMcbMsg->eStatus != MCB_READ_SUCCESS));
+        }
     }
     else
     {
-        memcpy((void*)&ptInst->tConfigReq, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        memcpy((void*)&ptInst->tConfigRpy, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        ptInst->ptUsrConfig = pMcbMsg;
-        ptInst->tIntf.isNewCfgOverCyclic = true;
-
-        do
+        if (Mcb_CfgQueueSend(ptInst, pMcbMsg, u32Millis) == false)
         {
-            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
-            {
-                pMcbMsg->eStatus = MCB_READ_ERROR;
-                Mcb_IntfReset(&ptInst->tIntf);
-                break;
-            }
-        }while ((ptInst->tIntf.isNewCfgOverCyclic == true)
-                || (ptInst->tIntf.isCfgOverCyclic == true));
+            pMcbMsg->eStatus = MCB_READ_ERROR;
+        }
     }
 
     if (pMcbMsg->eStatus == MCB_READ_ERROR)
@@ -273,6 +591,7 @@ static void Mcb_BlockingWrite(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
 {
     uint32_t u32Millis = Mcb_GetMillis();
     pMcbMsg->u16Cmd = MCB_REQ_WRITE;
+    Mcb_CacheInvalidate(ptInst, pMcbMsg->u16Node, pMcbMsg->u16Addr);
 
     if (ptInst->isCyclic == false)
     {
@@ -287,26 +606,21 @@ static void Mcb_BlockingWrite(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
                 Mcb_IntfReset(&ptInst->tIntf);
                 break;
             }
+
+            /** Sleep until the reply is clocked in */
+            if (pMcbMsg->eStatus == MCB_WRITE_ANSWER)
+            {
+                Mcb_BlockingWait(ptInst, u32Millis);
+            }
         }while ((pMcbMsg->eStatus != MCB_WRITE_ERROR)
                 && (pMcbMsg->eStatus != MCB_WRITE_SUCCESS));
     }
     else
     {
-        memcpy((void*)&ptInst->tConfigReq, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        memcpy((void*)&ptInst->tConfigRpy, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        ptInst->ptUsrConfig = pMcbMsg;
-        ptInst->tIntf.isNewCfgOverCyclic = true;
-
-        do
+        if (Mcb_CfgQueueSend(ptInst, pMcbMsg, u32Millis) == false)
         {
-            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
-            {
-                pMcbMsg->eStatus = MCB_WRITE_ERROR;
-                Mcb_IntfReset(&ptInst->tIntf);
-                break;
-            }
-        } while((ptInst->tIntf.isNewCfgOverCyclic == true)
-                || (ptInst->tIntf.isCfgOverCyclic == true));
+            pMcbMsg->eStatus = MCB_WRITE_ERROR;
+        }
     }
 
     if (pMcbMsg->eStatus == MCB_WRITE_ERROR)
@@ -328,13 +642,19 @@ static void Mcb_NonBlockingGetInfo(Mcb_TInst* ptInst, Mcb_TInfoMsg* pMcbInfoMsg)
     {
         pMcbInfoMsg->eStatus = Mcb_IntfGetInfo(&ptInst->tIntf, pMcbInfoMsg->u16Node, pMcbInfoMsg->u16Addr,
                                                (uint16_t*)&pMcbInfoMsg->tInfoMsgData, &pMcbInfoMsg->u16Size);
+
+        if (pMcbInfoMsg->eStatus == MCB_GETINFO_SUCCESS)
+        {
+            Mcb_CacheLearn(ptInst, pMcbInfoMsg);
+        }
     }
     else
     {
         pMcbInfoMsg->eStatus = MCB_STANDBY;
-        memcpy((void*)&ptInst->tConfigReq, (const void*)pMcbInfoMsg, sizeof(Mcb_TMsg));
-        memcpy((void*)&ptInst->tConfigRpy, (const void*)pMcbInfoMsg, sizeof(Mcb_TMsg));
-        ptInst->tIntf.isNewCfgOverCyclic = true;
+        if (Mcb_CfgQueuePush(ptInst, (const Mcb_TMsg*)pMcbInfoMsg, NULL, NULL) == false)
+        {
+            pMcbInfoMsg->eStatus = MCB_GETINFO_ERROR;
+        }
     }
 
     if (pMcbInfoMsg->eStatus == MCB_GETINFO_ERROR)
@@ -353,15 +673,24 @@ static void Mcb_NonBlockingRead(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
 
     if (ptInst->isCyclic == false)
     {
-        pMcbMsg->eStatus = Mcb_IntfRead(&ptInst->tIntf, pMcbMsg->u16Node, pMcbMsg->u16Addr,
-                                        &pMcbMsg->u16Data[0], &pMcbMsg->u16Size);
+        if (Mcb_CacheLoad(ptInst, pMcbMsg, false) == false)
+        {
+            pMcbMsg->eStatus = Mcb_IntfRead(&ptInst->tIntf, pMcbMsg->u16Node, pMcbMsg->u16Addr,
+                                            &pMcbMsg->u16Data[0], &pMcbMsg->u16Size);
+
+            if (pMcbMsg->eStatus == MCB_READ_SUCCESS)
+            {
+                Mcb_CacheStore(ptInst, pMcbMsg);
+            }
+        }
     }
     else
     {
         pMcbMsg->eStatus = MCB_STANDBY;
-        memcpy((void*)&ptInst->tConfigReq, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        memcpy((void*)&ptInst->tConfigRpy, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        ptInst->tIntf.isNewCfgOverCyclic = true;
+        if (Mcb_CfgQueuePush(ptInst, (const Mcb_TMsg*)pMcbMsg, NULL, NULL) == false)
+        {
+            pMcbMsg->eStatus = MCB_READ_ERROR;
+        }
     }
 
     if (pMcbMsg->eStatus == MCB_READ_ERROR)
@@ -377,6 +706,7 @@ static void Mcb_NonBlockingRead(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
 static void Mcb_NonBlockingWrite(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
 {
     pMcbMsg->u16Cmd = MCB_REQ_WRITE;
+    Mcb_CacheInvalidate(ptInst, pMcbMsg->u16Node, pMcbMsg->u16Addr);
 
     if (ptInst->isCyclic == false)
     {
@@ -386,9 +716,10 @@ static void Mcb_NonBlockingWrite(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
     else
     {
         pMcbMsg->eStatus = MCB_STANDBY;
-        memcpy((void*)&ptInst->tConfigReq, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        memcpy((void*)&ptInst->tConfigRpy, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
-        ptInst->tIntf.isNewCfgOverCyclic = true;
+        if (Mcb_CfgQueuePush(ptInst, (const Mcb_TMsg*)pMcbMsg, NULL, NULL) == false)
+        {
+            pMcbMsg->eStatus = MCB_WRITE_ERROR;
+        }
     }
 
     if (pMcbMsg->eStatus == MCB_WRITE_ERROR)
@@ -401,12 +732,158 @@ static void Mcb_NonBlockingWrite(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
     }
 }
 
-void Mcb_AttachCfgOverCyclicCB(Mcb_TInst* ptInst, void (*Evnt)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg))
+bool Mcb_SetNode(Mcb_TInst* ptInst, uint16_t u16Node)
 {
-    if (ptInst->eMode != MCB_BLOCKING)
+    bool isSet = false;
+
+    if ((u16Node < MCB_NUMBER_NODES) && (ptInst->isCyclic == false)
+        && (ptInst->tCyclicRxList.u8Mapped == (uint8_t)0U) && (ptInst->tCyclicTxList.u8Mapped == (uint8_t)0U))
     {
-        ptInst->CfgOverCyclicEvnt = Evnt;
+        ptInst->u16Node = u16Node;
+        isSet = true;
     }
+
+    return isSet;
+}
+
+bool Mcb_SetConfigSize(Mcb_TInst* ptInst, uint16_t u16CfgSz)
+{
+    bool isSet = false;
+
+    if ((ptInst->isCyclic == false) && (ptInst->tCyclicRxList.u8Mapped == (uint8_t)0U)
+        && (ptInst->tCyclicTxList.u8Mapped == (uint8_t)0U))
+    {
+        isSet = Mcb_IntfSetConfigSize(&ptInst->tIntf, u16CfgSz);
+    }
+
+    return isSet;
+}
+
+#ifdef MCB_READ_CACHE
+void Mcb_ReadCacheStats(const Mcb_TInst* ptInst, uint32_t* pu32Hits, uint32_t* pu32Misses)
+{
+    *pu32Hits = ptInst->tReadCache.u32Hits;
+    *pu32Misses = ptInst->tReadCache.u32Misses;
+}
+
+void Mcb_ReadCacheFlush(Mcb_TInst* ptInst)
+{
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < MCB_READ_CACHE_SZ; u16Idx++)
+    {
+        ptInst->tReadCache.tEntry[u16Idx].ePolicy = MCB_CACHE_UNKNOWN;
+        ptInst->tReadCache.tEntry[u16Idx].isValid = false;
+        ptInst->tReadCache.tEntry[u16Idx].u16Node = (uint16_t)0U;
+        ptInst->tReadCache.tEntry[u16Idx].u16Addr = (uint16_t)0U;
+    }
+}
+#endif
+
+void Mcb_AttachCfgOverCyclicCB(Mcb_TInst* ptInst, void (*Evnt)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg))
+{
+    if (ptInst->eMode != MCB_BLOCKING)
+    {
+        ptInst->CfgOverCyclicEvnt = Evnt;
+    }
+}
+
+bool Mcb_Submit(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg, bool isWrite)
+{
+    bool isSubmitted = false;
+    uint8_t u8Next;
+
+    if (ptInst->eMode == MCB_BLOCKING)
+    {
+        if (isWrite != false)
+        {
+            ptInst->Mcb_Write(ptInst, pMcbMsg);
+        }
+        else
+        {
+            ptInst->Mcb_Read(ptInst, pMcbMsg);
+        }
+
+        Mcb_SubmitCompl(ptInst, pMcbMsg, NULL);
+        isSubmitted = true;
+    }
+    else if (ptInst->isCyclic != false)
+    {
+        if (isWrite != false)
+        {
+            pMcbMsg->u16Cmd = MCB_REQ_WRITE;
+            Mcb_CacheInvalidate(ptInst, pMcbMsg->u16Node, pMcbMsg->u16Addr);
+        }
+        else
+        {
+            pMcbMsg->u16Cmd = MCB_REQ_READ;
+        }
+
+        pMcbMsg->eStatus = MCB_STANDBY;
+        isSubmitted = Mcb_CfgQueuePush(ptInst, (const Mcb_TMsg*)pMcbMsg, pMcbMsg, NULL);
+    }
+    else
+    {
+        u8Next = (uint8_t)((ptInst->u8SubmitHead + 1U) % (MCB_SUBMIT_QUEUE_SZ + 1U));
+
+        if (u8Next != ptInst->u8SubmitTail)
+        {
+            pMcbMsg->eStatus = MCB_STANDBY;
+            ptInst->tSubmit[ptInst->u8SubmitHead].ptMsg = pMcbMsg;
+            ptInst->tSubmit[ptInst->u8SubmitHead].isWrite = isWrite;
+            ptInst->u8SubmitHead = u8Next;
+            isSubmitted = true;
+        }
+    }
+
+    return isSubmitted;
+}
+
+uint8_t Mcb_Poll(Mcb_TInst* ptInst)
+{
+    Mcb_TSubmitEntry* ptEntry;
+    Mcb_TMsg* pMcbMsg;
+    bool isDone;
+
+    if ((ptInst->isCyclic == false) && (ptInst->u8SubmitTail != ptInst->u8SubmitHead))
+    {
+        ptEntry = &ptInst->tSubmit[ptInst->u8SubmitTail];
+        pMcbMsg = ptEntry->ptMsg;
+
+        if (ptInst->isSubmitStarted == false)
+        {
+            ptInst->isSubmitStarted = true;
+            ptInst->u32SubmitMillis = Mcb_GetMillis();
+        }
+
+        if (ptEntry->isWrite != false)
+        {
+            Mcb_NonBlockingWrite(ptInst, pMcbMsg);
+            isDone = ((pMcbMsg->eStatus == MCB_WRITE_SUCCESS) || (pMcbMsg->eStatus == MCB_WRITE_ERROR));
+        }
+        else
+        {
+            Mcb_NonBlockingRead(ptInst, pMcbMsg);
+            isDone = ((pMcbMsg->eStatus == MCB_READ_SUCCESS) || (pMcbMsg->eStatus == MCB_READ_ERROR));
+        }
+
+        if ((isDone == false) && ((Mcb_GetMillis() - ptInst->u32SubmitMillis) > ptInst->u32Timeout))
+        {
+            Mcb_IntfReset(&ptInst->tIntf);
+            pMcbMsg->eStatus = (ptEntry->isWrite != false) ? MCB_WRITE_ERROR : MCB_READ_ERROR;
+            pMcbMsg->u16Cmd |= MCB_REP_ERROR;
+            isDone = true;
+        }
+
+        if (isDone != false)
+        {
+            /** Release the slot first, so the callback can submit a new request */
+            ptInst->isSubmitStarted = false;
+            ptInst->u8SubmitTail = (uint8_t)((ptInst->u8SubmitTail + 1U) % (MCB_SUBMIT_QUEUE_SZ + 1U));
+            Mcb_SubmitCompl(ptInst, pMcbMsg, NULL);
+        }
+    }
+
+    return (uint8_t)((ptInst->u8SubmitHead + (MCB_SUBMIT_QUEUE_SZ + 1U) - ptInst->u8SubmitTail)
+                     % (MCB_SUBMIT_QUEUE_SZ + 1U));
 }
 
 void* Mcb_TxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
@@ -417,7 +894,7 @@ void* Mcb_TxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
     do
     {
         /** Check if the register is already mapped into mcb */
-        uint8_t* pu8ByOffset = (uint8_t*)ptInst->u16CyclicRx;
+        uint8_t* pu8ByOffset = (uint8_t*)MCB_CYCLIC_RX_BUF(ptInst);
         for (uint8_t u8TxMapCnt = (uint8_t)0; u8TxMapCnt < ptInst->tCyclicTxList.u8Mapped; ++u8TxMapCnt)
         {
             if (ptInst->tCyclicTxList.u16Addr[u8TxMapCnt] == u16Addr)
@@ -425,7 +902,8 @@ void* Mcb_TxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
                 pRet = pu8ByOffset;
                 break;
             }
-            pu8ByOffset += ptInst->tCyclicTxList.u16Sz[u8TxMapCnt];
+            /** Mapped registers are word aligned */
+            pu8ByOffset += (ptInst->tCyclicTxList.u16Sz[u8TxMapCnt] + (ptInst->tCyclicTxList.u16Sz[u8TxMapCnt] & (uint16_t)1U));
         }
 
         /** Set up internal struct and verify a proper configuration */
@@ -434,7 +912,7 @@ void* Mcb_TxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
             break;
         }
 
-        tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+        tMcbMsg.u16Node = ptInst->u16Node;
         tMcbMsg.u16Addr = TX_MAP_BASE + ptInst->tCyclicTxList.u8Mapped + (uint16_t)1U;
         tMcbMsg.u16Cmd = MCB_REQ_WRITE;
         tMcbMsg.u16Size = WORDSIZE_32BIT;
@@ -459,7 +937,8 @@ void* Mcb_TxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
         switch (tMcbMsg.eStatus)
         {
             case MCB_WRITE_SUCCESS:
-                pRet = &ptInst->u16CyclicRx[ptInst->tCyclicTxList.u16MappedSize];
+                pRet = &MCB_CYCLIC_RX_BUF(ptInst)[ptInst->tCyclicTxList.u16MappedSize];
+                ptInst->u32MapSign = (uint32_t)0UL;
                 ptInst->tCyclicTxList.u16Addr[ptInst->tCyclicTxList.u8Mapped] = u16Addr;
                 ptInst->tCyclicTxList.u16Sz[ptInst->tCyclicTxList.u8Mapped] = u16Sz;
                 ptInst->tCyclicTxList.u8Mapped++;
@@ -483,7 +962,7 @@ void* Mcb_RxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
     do
     {
         /** Check if the register is already mapped into mcb */
-        uint8_t* pu8ByOffset = (uint8_t*)ptInst->u16CyclicTx;
+        uint8_t* pu8ByOffset = (uint8_t*)MCB_CYCLIC_TX_BUF(ptInst);
         for (uint8_t u8RxMapCnt = (uint8_t)0; u8RxMapCnt < ptInst->tCyclicRxList.u8Mapped; ++u8RxMapCnt)
         {
             if (ptInst->tCyclicRxList.u16Addr[u8RxMapCnt] == u16Addr)
@@ -491,7 +970,8 @@ void* Mcb_RxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
                 pRet = pu8ByOffset;
                 break;
             }
-            pu8ByOffset += ptInst->tCyclicRxList.u16Sz[u8RxMapCnt];
+            /** Mapped registers are word aligned */
+            pu8ByOffset += (ptInst->tCyclicRxList.u16Sz[u8RxMapCnt] + (ptInst->tCyclicRxList.u16Sz[u8RxMapCnt] & (uint16_t)1U));
         }
 
         /** Set up internal struct and verify a proper configuration */
@@ -500,7 +980,7 @@ void* Mcb_RxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
             break;
         }
 
-        tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+        tMcbMsg.u16Node = ptInst->u16Node;
         tMcbMsg.u16Addr = RX_MAP_BASE + ptInst->tCyclicRxList.u8Mapped + (uint16_t)1U;
         tMcbMsg.u16Cmd = MCB_REQ_WRITE;
         tMcbMsg.u16Size = WORDSIZE_32BIT;
@@ -525,7 +1005,8 @@ void* Mcb_RxMap(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t u16Sz)
         switch (tMcbMsg.eStatus)
         {
             case MCB_WRITE_SUCCESS:
-                pRet = &ptInst->u16CyclicTx[ptInst->tCyclicRxList.u16MappedSize];
+                pRet = &MCB_CYCLIC_TX_BUF(ptInst)[ptInst->tCyclicRxList.u16MappedSize];
+                ptInst->u32MapSign = (uint32_t)0UL;
                 ptInst->tCyclicRxList.u16Addr[ptInst->tCyclicRxList.u8Mapped] = u16Addr;
                 ptInst->tCyclicRxList.u16Sz[ptInst->tCyclicRxList.u8Mapped] = u16Sz;
                 ptInst->tCyclicRxList.u8Mapped++;
@@ -546,8 +1027,11 @@ uint8_t Mcb_TxUnmap(Mcb_TInst* ptInst)
     Mcb_TMsg tMcbMsg;
     uint16_t u16SizeBytes;
 
+    /** Mapping is going to change, it is no longer the enabled one */
+    ptInst->u32MapSign = (uint32_t)0UL;
+
     /** Set up internal struct and verify a proper configuration */
-    tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+    tMcbMsg.u16Node = ptInst->u16Node;
     tMcbMsg.u16Addr = TX_MAP_BASE + ptInst->tCyclicTxList.u8Mapped + (uint16_t)1U;
     tMcbMsg.u16Cmd = MCB_REQ_WRITE;
     tMcbMsg.u16Size = WORDSIZE_32BIT;
@@ -592,8 +1076,11 @@ uint8_t Mcb_RxUnmap(Mcb_TInst* ptInst)
     Mcb_TMsg tMcbMsg;
     uint16_t u16SizeBytes;
 
+    /** Mapping is going to change, it is no longer the enabled one */
+    ptInst->u32MapSign = (uint32_t)0UL;
+
     /** Set up internal struct and verify a proper configuration */
-    tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+    tMcbMsg.u16Node = ptInst->u16Node;
     tMcbMsg.u16Addr = RX_MAP_BASE + ptInst->tCyclicRxList.u8Mapped + 1;
     tMcbMsg.u16Size = WORDSIZE_32BIT;
     tMcbMsg.u16Data[0] = (uint16_t)0U;
@@ -636,8 +1123,11 @@ void Mcb_UnmapAll(Mcb_TInst* ptInst)
 {
     Mcb_TMsg tMcbMsg;
 
+    /** Mapping is going to change, it is no longer the enabled one */
+    ptInst->u32MapSign = (uint32_t)0UL;
+
     /** Set up internal struct and verify a proper configuration */
-    tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+    tMcbMsg.u16Node = ptInst->u16Node;
     tMcbMsg.u16Addr = RX_MAP_BASE;
     tMcbMsg.u16Size = WORDSIZE_16BIT;
     tMcbMsg.u16Data[0] = (uint16_t)0U;
@@ -669,7 +1159,7 @@ void Mcb_UnmapAll(Mcb_TInst* ptInst)
     }
 
     /** Set up internal struct and verify a proper configuration */
-    tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+    tMcbMsg.u16Node = ptInst->u16Node;
     tMcbMsg.u16Addr = TX_MAP_BASE;
     tMcbMsg.u16Size = WORDSIZE_16BIT;
     tMcbMsg.u16Data[0] = (uint16_t)0U;
@@ -708,46 +1198,25 @@ int32_t Mcb_EnableCyclic(Mcb_TInst* ptInst)
 
     if (ptInst->isCyclic == false)
     {
+        uint32_t u32Sign = Mcb_MapSignature(ptInst);
         uint32_t u32Millis = Mcb_GetMillis();
+        uint32_t u32Stale = MCB_MAP_STALE_ALL;
 
-        /** Check and setup RX mapping */
-        tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
-        tMcbMsg.u16Addr = RX_MAP_BASE;
-        tMcbMsg.u16Size = WORDSIZE_16BIT;
-        tMcbMsg.u16Data[0] = ptInst->tCyclicRxList.u8Mapped;
-
-        do
+        if (ptInst->u32MapSign == u32Sign)
         {
-            ptInst->Mcb_Write(ptInst, &tMcbMsg);
-
-            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
+            /** Mapping already enabled once, only rewrite what the slave lost (i.e. reset) */
+            if (Mcb_MapVerify(ptInst, &u32Stale) == false)
             {
-                tMcbMsg.eStatus = MCB_WRITE_ERROR;
-                break;
+                i32Result = Mcb_MapReplay(ptInst, u32Stale);
             }
-
-        } while ((tMcbMsg.eStatus != MCB_WRITE_ERROR)
-                 && (tMcbMsg.eStatus != MCB_WRITE_SUCCESS));
-
-        switch (tMcbMsg.eStatus)
-        {
-            case MCB_WRITE_SUCCESS:
-                /** Do nothing */
-                break;
-            default:
-                i32Result = CYCLIC_ERR_RX_MAP;
-                break;
         }
-
-        if (i32Result == CYCLIC_MODE_OK)
+        else
         {
-            /** If RX mapping was OK, check and setup TX mapping */
-            tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
-            tMcbMsg.u16Addr = TX_MAP_BASE;
+            /** Check and setup RX mapping */
+            tMcbMsg.u16Node = ptInst->u16Node;
+            tMcbMsg.u16Addr = RX_MAP_BASE;
             tMcbMsg.u16Size = WORDSIZE_16BIT;
-            tMcbMsg.u16Data[0] = ptInst->tCyclicTxList.u8Mapped;
-
-            u32Millis = Mcb_GetMillis();
+            tMcbMsg.u16Data[0] = ptInst->tCyclicRxList.u8Mapped;
 
             do
             {
@@ -768,64 +1237,266 @@ int32_t Mcb_EnableCyclic(Mcb_TInst* ptInst)
                     /** Do nothing */
                     break;
                 default:
-                    i32Result = CYCLIC_ERR_TX_MAP;
+                    i32Result = CYCLIC_ERR_RX_MAP;
                     break;
             }
+
+            if (i32Result == CYCLIC_MODE_OK)
+            {
+                /** If RX mapping was OK, check and setup TX mapping */
+                tMcbMsg.u16Node = ptInst->u16Node;
+                tMcbMsg.u16Addr = TX_MAP_BASE;
+                tMcbMsg.u16Size = WORDSIZE_16BIT;
+                tMcbMsg.u16Data[0] = ptInst->tCyclicTxList.u8Mapped;
+
+                u32Millis = Mcb_GetMillis();
+
+                do
+                {
+                    ptInst->Mcb_Write(ptInst, &tMcbMsg);
+
+                    if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
+                    {
+                        tMcbMsg.eStatus = MCB_WRITE_ERROR;
+                        break;
+                    }
+
+                } while ((tMcbMsg.eStatus != MCB_WRITE_ERROR)
+                         && (tMcbMsg.eStatus != MCB_WRITE_SUCCESS));
+
+                switch (tMcbMsg.eStatus)
+                {
+                    case MCB_WRITE_SUCCESS:
+                        /** Do nothing */
+                        break;
+                    default:
+                        i32Result = CYCLIC_ERR_TX_MAP;
+                        break;
+                }
+            }
         }
 
         if (i32Result == CYCLIC_MODE_OK)
         {
-            /** If both mappings are OK, enable cyclic mode */
-            tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
-            tMcbMsg.u16Addr = ADDR_COMM_STATE;
-            tMcbMsg.u16Size = WORDSIZE_16BIT;
-            tMcbMsg.u16Data[0] = (uint16_t)2U;
+            i32Result = Mcb_CyclicStart(ptInst);
+        }
 
-            uint32_t u32Millis = Mcb_GetMillis();
+        if (i32Result > CYCLIC_MODE_OK)
+        {
+            ptInst->u32MapSign = u32Sign;
+        }
+    }
 
-            do
-            {
-                ptInst->Mcb_Write(ptInst, &tMcbMsg);
+    return i32Result;
+}
 
-                if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
-                {
-                    tMcbMsg.eStatus = MCB_WRITE_ERROR;
-                    break;
-                }
+int32_t Mcb_MapBatch(Mcb_TInst* ptInst, Mcb_TMapEntry* ptRxTable, uint8_t u8RxNum,
+                     Mcb_TMapEntry* ptTxTable, uint8_t u8TxNum)
+{
+    int32_t i32Result = CYCLIC_MODE_OK;
+    uint32_t u32Stale;
+    uint16_t u16Offset;
+    uint8_t u8Idx;
 
-            } while ((tMcbMsg.eStatus != MCB_WRITE_ERROR)
-                     && (tMcbMsg.eStatus != MCB_WRITE_SUCCESS));
+    do
+    {
+        if (ptInst->isCyclic != false)
+        {
+            i32Result = CYCLIC_ERR_STATE;
+            break;
+        }
 
-            switch (tMcbMsg.eStatus)
+        if (u8RxNum > MAX_MAPPED_REG)
+        {
+            i32Result = CYCLIC_ERR_RX_MAP;
+            break;
+        }
+
+        if (u8TxNum > MAX_MAPPED_REG)
+        {
+            i32Result = CYCLIC_ERR_TX_MAP;
+            break;
+        }
+
+        /** Each direction must fit in the cyclic area, checked before writing anything */
+        if (Mcb_MapTableSize(ptRxTable, u8RxNum) > MCB_FRM_MAX_CYCLIC_SZ)
+        {
+            i32Result = CYCLIC_ERR_RX_MAP;
+            break;
+        }
+
+        if (Mcb_MapTableSize(ptTxTable, u8TxNum) > MCB_FRM_MAX_CYCLIC_SZ)
+        {
+            i32Result = CYCLIC_ERR_TX_MAP;
+            break;
+        }
+
+        u16Offset = (uint16_t)0U;
+        for (u8Idx = (uint8_t)0U; u8Idx < u8RxNum; u8Idx++)
+        {
+            ptRxTable[u8Idx].pData = &MCB_CYCLIC_TX_BUF(ptInst)[u16Offset];
+            ptInst->tCyclicRxList.u16Addr[u8Idx] = ptRxTable[u8Idx].u16Addr;
+            ptInst->tCyclicRxList.u16Sz[u8Idx] = ptRxTable[u8Idx].u16Sz;
+            /** Ensure correct conversion from bytes to words */
+            u16Offset += ((ptRxTable[u8Idx].u16Sz + (ptRxTable[u8Idx].u16Sz & (uint16_t)1U)) >> (uint16_t)1U);
+        }
+        ptInst->tCyclicRxList.u8Mapped = u8RxNum;
+        ptInst->tCyclicRxList.u16MappedSize = u16Offset;
+
+        u16Offset = (uint16_t)0U;
+        for (u8Idx = (uint8_t)0U; u8Idx < u8TxNum; u8Idx++)
+        {
+            ptTxTable[u8Idx].pData = &MCB_CYCLIC_RX_BUF(ptInst)[u16Offset];
+            ptInst->tCyclicTxList.u16Addr[u8Idx] = ptTxTable[u8Idx].u16Addr;
+            ptInst->tCyclicTxList.u16Sz[u8Idx] = ptTxTable[u8Idx].u16Sz;
+            /** Ensure correct conversion from bytes to words */
+            u16Offset += ((ptTxTable[u8Idx].u16Sz + (ptTxTable[u8Idx].u16Sz & (uint16_t)1U)) >> (uint16_t)1U);
+        }
+        ptInst->tCyclicTxList.u8Mapped = u8TxNum;
+        ptInst->tCyclicTxList.u16MappedSize = u16Offset;
+
+        /** Same mapping as the last one enabled, only rewrite what the slave does not keep */
+        u32Stale = MCB_MAP_STALE_ALL;
+        if ((ptInst->u32MapSign != Mcb_MapSignature(ptInst)) || (Mcb_MapVerify(ptInst, &u32Stale) == false))
+        {
+            i32Result = Mcb_MapReplay(ptInst, u32Stale);
+        }
+
+        if (i32Result != CYCLIC_MODE_OK)
+        {
+            /** The slave mapping is unknown, forget the local one */
+            ptInst->tCyclicRxList.u8Mapped = (uint8_t)0U;
+            ptInst->tCyclicRxList.u16MappedSize = (uint16_t)0U;
+            ptInst->tCyclicTxList.u8Mapped = (uint8_t)0U;
+            ptInst->tCyclicTxList.u16MappedSize = (uint16_t)0U;
+            ptInst->u32MapSign = (uint32_t)0UL;
+            break;
+        }
+
+        i32Result = Mcb_CyclicStart(ptInst);
+
+        if (i32Result > CYCLIC_MODE_OK)
+        {
+            ptInst->u32MapSign = Mcb_MapSignature(ptInst);
+        }
+    } while (false);
+
+    return i32Result;
+}
+
+uint16_t Mcb_ReadBatch(Mcb_TInst* ptInst, uint16_t u16Node, const uint16_t* pu16Addr, Mcb_TMsg* ptMsg, uint16_t u16Num)
+{
+    uint16_t u16Data[MCB_READ_BATCH_SZ * MCB_FRM_MAX_CONFIG_SZ];
+    uint16_t u16CfgSz = ptInst->tIntf.u16CfgSz;
+    Mcb_EStatus eState;
+    uint16_t u16Read = (uint16_t)0U;
+    uint16_t u16Idx = (uint16_t)0U;
+    uint16_t u16Chunk;
+    uint16_t u16Done;
+    uint32_t u32Millis;
+    bool isTimeout = false;
+
+    while ((ptInst->isCyclic == false) && (ptInst->eMode == MCB_BLOCKING) && (isTimeout == false)
+           && (u16Idx < u16Num))
+    {
+        u16Chunk = ((u16Num - u16Idx) < MCB_READ_BATCH_SZ) ? (u16Num - u16Idx) : MCB_READ_BATCH_SZ;
+        u16Done = (uint16_t)0U;
+        u32Millis = Mcb_GetMillis();
+
+        do
+        {
+            eState = Mcb_IntfReadPipe(&ptInst->tIntf, u16Node, &pu16Addr[u16Idx], u16Data, u16Chunk, &u16Done);
+
+            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
             {
-                case MCB_WRITE_SUCCESS:
-                    /** Do nothing*/
-                    break;
-                default:
-                    i32Result = CYCLIC_ERR_VALIDATION;
-                    break;
+                eState = MCB_READ_ERROR;
+                Mcb_IntfReset(&ptInst->tIntf);
+                isTimeout = true;
+                break;
+            }
+
+            /** Sleep until the next reply is clocked in */
+            if (eState == MCB_READ_ANSWER)
+            {
+                Mcb_BlockingWait(ptInst, u32Millis);
             }
+        } while ((eState != MCB_READ_ERROR) && (eState != MCB_READ_SUCCESS));
+
+        for (uint16_t u16Pos = (uint16_t)0U; u16Pos < u16Done; u16Pos++)
+        {
+            ptMsg[u16Idx].u16Node = u16Node;
+            ptMsg[u16Idx].u16Addr = pu16Addr[u16Idx];
+            ptMsg[u16Idx].u16Cmd = MCB_REP_ACK;
+            ptMsg[u16Idx].u16Size = u16CfgSz;
+            memcpy((void*)ptMsg[u16Idx].u16Data, (const void*)&u16Data[u16Pos * u16CfgSz],
+                   (u16CfgSz * sizeof(uint16_t)));
+            ptMsg[u16Idx].eStatus = MCB_READ_SUCCESS;
+            u16Read++;
+            u16Idx++;
         }
 
-        /** If cyclic mode is correctly enabled */
-        if (i32Result == CYCLIC_MODE_OK)
+        if ((eState != MCB_READ_SUCCESS) && (isTimeout == false))
         {
-            /** Check bigger mapping and set up generated frame size */
-            if (ptInst->tCyclicRxList.u16MappedSize > ptInst->tCyclicTxList.u16MappedSize)
+            /** Segmented or failed register, drained by the pipelined read, the regular read handles it and reports its error */
+            ptMsg[u16Idx].u16Node = u16Node;
+            ptMsg[u16Idx].u16Addr = pu16Addr[u16Idx];
+            ptInst->Mcb_Read(ptInst, &ptMsg[u16Idx]);
+
+            if (ptMsg[u16Idx].eStatus == MCB_READ_SUCCESS)
             {
-                ptInst->u16CyclicSize = ptInst->tCyclicRxList.u16MappedSize;
+                u16Read++;
             }
-            else
+            u16Idx++;
+        }
+    }
+
+    /** Registers not reached */
+    for (; u16Idx < u16Num; u16Idx++)
+    {
+        ptMsg[u16Idx].u16Node = u16Node;
+        ptMsg[u16Idx].u16Addr = pu16Addr[u16Idx];
+        ptMsg[u16Idx].eStatus = MCB_READ_ERROR;
+    }
+
+    return u16Read;
+}
+
+uint16_t Mcb_WriteBatch(Mcb_TInst* ptInst, uint16_t u16Node, const Mcb_TIntfPipeReq* ptReq, uint16_t u16Num,
+                        bool isReplay)
+{
+    Mcb_EStatus eState = MCB_STANDBY;
+    uint16_t u16Done = (uint16_t)0U;
+    uint32_t u32Millis;
+
+    if ((ptInst->isCyclic == false) && (u16Num != (uint16_t)0U))
+    {
+        /** Writes do not go through the instance, drop what they change from the cache */
+        for (uint16_t u16Idx = (uint16_t)0U; u16Idx < u16Num; u16Idx++)
+        {
+            Mcb_CacheInvalidate(ptInst, u16Node, ptReq[u16Idx].u16Addr);
+        }
+
+        u32Millis = Mcb_GetMillis();
+
+        do
+        {
+            eState = Mcb_IntfWritePipe(&ptInst->tIntf, u16Node, ptReq, u16Num, isReplay, &u16Done);
+
+            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
             {
-                ptInst->u16CyclicSize = ptInst->tCyclicTxList.u16MappedSize;
+                Mcb_IntfReset(&ptInst->tIntf);
+                break;
             }
 
-            ptInst->isCyclic = true;
-            i32Result = ptInst->u16CyclicSize;
-        }
+            /** Sleep until the next reply is clocked in */
+            if (eState == MCB_WRITE_ANSWER)
+            {
+                Mcb_BlockingWait(ptInst, u32Millis);
+            }
+        } while ((eState != MCB_WRITE_ERROR) && (eState != MCB_WRITE_SUCCESS));
     }
 
-    return i32Result;
+    return u16Done;
 }
 
 Mcb_EStatus  Mcb_DisableCyclic(Mcb_TInst* ptInst)
@@ -835,10 +1506,9 @@ Mcb_EStatus  Mcb_DisableCyclic(Mcb_TInst* ptInst)
 
     if (ptInst->isCyclic != false)
     {
-        if ((ptInst->tIntf.isCfgOverCyclic == false)
-            && (ptInst->tIntf.isNewCfgOverCyclic == false))
+        if (Mcb_CfgQueueIsBusy(ptInst) == false)
         {
-            tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+            tMcbMsg.u16Node = ptInst->u16Node;
             tMcbMsg.u16Addr = ADDR_COMM_STATE;
             tMcbMsg.u16Size = WORDSIZE_16BIT;
             tMcbMsg.u16Data[0] = (uint16_t)1U;
@@ -864,7 +1534,7 @@ Mcb_ECyclicMode Mcb_GetCyclicMode(Mcb_TInst* ptInst)
     Mcb_TMsg tMcbMsg;
     uint32_t u32Millis = Mcb_GetMillis();
 
-    tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+    tMcbMsg.u16Node = ptInst->u16Node;
     tMcbMsg.u16Addr = ADDR_CYCLIC_MODE;
     tMcbMsg.u16Size = WORDSIZE_16BIT;
 
@@ -899,7 +1569,7 @@ Mcb_ECyclicMode Mcb_SetCyclicMode(Mcb_TInst* ptInst, Mcb_ECyclicMode eNewCycMode
     Mcb_TMsg tMcbMsg;
     uint32_t u32Millis = Mcb_GetMillis();
 
-    tMcbMsg.u16Node = DEFAULT_MOCO_NODE;
+    tMcbMsg.u16Node = ptInst->u16Node;
     tMcbMsg.u16Addr = ADDR_CYCLIC_MODE;
     tMcbMsg.u16Size = WORDSIZE_16BIT;
     tMcbMsg.u16Data[0] = (uint16_t)eNewCycMode;
@@ -941,35 +1611,47 @@ bool Mcb_CyclicProcessLatch(Mcb_TInst* ptInst, Mcb_EStatus* peCfgStat)
     {
         isTransfer = true;
 
-        eState = Mcb_IntfCfgOverCyclic(&ptInst->tIntf, ptInst->tConfigRpy.u16Node, ptInst->tConfigRpy.u16Addr,
-                                       &ptInst->tConfigRpy.u16Cmd, ptInst->tConfigRpy.u16Data,
-                                       &ptInst->tConfigRpy.u16Size, &isCfgData);
+        (void)Mcb_CfgQueuePop(ptInst);
+        eState = Mcb_CfgQueueServe(ptInst, &isCfgData);
 
         if ((eState == MCB_WRITE_SUCCESS) || (eState == MCB_WRITE_ERROR) ||
             (eState == MCB_READ_SUCCESS) || (eState == MCB_READ_ERROR) ||
             (eState == MCB_GETINFO_SUCCESS) || (eState == MCB_GETINFO_ERROR))
         {
-            ptInst->tConfigRpy.eStatus = eState;
+            ptInst->ptCfgMsg->eStatus = eState;
 
             if (ptInst->CfgOverCyclicEvnt != NULL)
             {
-                ptInst->CfgOverCyclicEvnt(ptInst, &ptInst->tConfigRpy);
+                ptInst->CfgOverCyclicEvnt(ptInst, ptInst->ptCfgMsg);
+            }
+
+            if (ptInst->tCfgQueue[ptInst->u8CfgQueueTail].ptUsr != NULL)
+            {
+                Mcb_SubmitCompl(ptInst, ptInst->tCfgQueue[ptInst->u8CfgQueueTail].ptUsr, ptInst->ptCfgMsg);
             }
 
             /* If the communication state has been written succesfully with the stop command,
              * set the interface as non-cyclic */
-            if ((ptInst->tConfigReq.u16Addr == ADDR_COMM_STATE) &&
-                (eState == MCB_WRITE_SUCCESS) &&
-                (ptInst->tConfigReq.u16Data[0] == (uint16_t)1U))
+            if ((ptInst->isCfgStop != false) && (eState == MCB_WRITE_SUCCESS))
             {
                 isTransfer = false;
                 ptInst->isCyclic = false;
+                Mcb_IntfSetCyclic(&ptInst->tIntf, false);
+            }
+
+            /** Hand the reply back to the producer, its slot can be reused from now on */
+            Mcb_CfgQueueDone(ptInst, true);
+
+            /** Chain the next queued request into this same frame */
+            if ((isTransfer != false) && (Mcb_CfgQueuePop(ptInst) != false))
+            {
+                (void)Mcb_CfgQueueServe(ptInst, &isCfgData);
             }
         }
 
         if (isTransfer != false)
         {
-            Mcb_IntfCyclicLatch(&ptInst->tIntf, ptInst->u16CyclicTx,
+            Mcb_IntfCyclicLatch(&ptInst->tIntf, Mcb_CyclicTxFront(ptInst),
                             ptInst->u16CyclicSize, isCfgData);
         }
         else
@@ -982,18 +1664,705 @@ bool Mcb_CyclicProcessLatch(Mcb_TInst* ptInst, Mcb_EStatus* peCfgStat)
     return isTransfer;
 }
 
-void Mcb_CyclicFrameProcess(Mcb_TInst* ptInst)
+bool Mcb_CyclicPrepare(Mcb_TInst* ptInst)
+{
+    bool isPrepared = false;
+
+    if (ptInst->isCyclic != false)
+    {
+        isPrepared = Mcb_IntfCyclicPrepare(&ptInst->tIntf, Mcb_CyclicTxFront(ptInst), ptInst->u16CyclicSize);
+    }
+
+    return isPrepared;
+}
+
+bool Mcb_CyclicFrameProcess(Mcb_TInst* ptInst)
 {
+    bool isValid = false;
+
     if (ptInst->isCyclic != false)
     {
-        Mcb_IntfProcessCyclic(&ptInst->tIntf, ptInst->u16CyclicRx, ptInst->u16CyclicSize);
+        Mcb_CyclicRxBegin(ptInst);
+        isValid = Mcb_IntfProcessCyclic(&ptInst->tIntf, MCB_CYCLIC_RX_BUF(ptInst), ptInst->u16CyclicSize);
     }
+
+    Mcb_CyclicRxEnd(ptInst);
+
+    return isValid;
+}
+
+#ifdef MCB_CYCLIC_TX_TRIPLE
+void Mcb_CyclicTxPublish(Mcb_TInst* ptInst)
+{
+    memcpy((void*)ptInst->u16CyclicTxSet[ptInst->u8TxSetBack], (const void*)ptInst->u16CyclicTx,
+           (ptInst->u16CyclicSize * sizeof(uint16_t)));
+
+    /** Release the complete set and take the one left over by the cyclic functions */
+    ptInst->u8TxSetBack = (uint8_t)(MCB_EXCHANGE(ptInst->u8TxSetMiddle, (uint8_t)(ptInst->u8TxSetBack | MCB_TX_SET_FRESH))
+                                    & (uint8_t)~MCB_TX_SET_FRESH);
 }
+#endif
 
-static void Mcb_ConfigOverCyclicCompl(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
+uint32_t Mcb_CyclicRxSnapshot(const Mcb_TInst* ptInst, uint16_t* pu16Buf, uint16_t u16Sz)
 {
-    if ((ptInst->ptUsrConfig != NULL) && (pMcbMsg != NULL))
+    uint32_t u32Seq;
+
+    if (u16Sz > MCB_FRM_MAX_CYCLIC_SZ)
     {
-        memcpy((void*)ptInst->ptUsrConfig, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
+        u16Sz = MCB_FRM_MAX_CYCLIC_SZ;
     }
+
+    do
+    {
+        /** Wait for the end of the update in progress, if any */
+        do
+        {
+            u32Seq = MCB_LOAD_ACQUIRE(ptInst->u32CyclicRxSeq);
+        } while ((u32Seq & (uint32_t)1UL) != (uint32_t)0UL);
+
+        memcpy((void*)pu16Buf, (const void*)MCB_CYCLIC_RX_BUF(ptInst), (u16Sz * sizeof(uint16_t)));
+
+        /** The copy is complete before checking that no update started meanwhile */
+        MCB_FENCE_ACQUIRE();
+    } while (ptInst->u32CyclicRxSeq != u32Seq);
+
+    return u32Seq;
+}
+
+static int32_t Mcb_CyclicStart(Mcb_TInst* ptInst)
+{
+    Mcb_TMsg tMcbMsg;
+    int32_t i32Result = CYCLIC_MODE_OK;
+
+    /** Cyclic frames are exchanged with the mapping node */
+    ptInst->tIntf.u16CyclicNode = ptInst->u16Node;
+
+    tMcbMsg.u16Node = ptInst->u16Node;
+    tMcbMsg.u16Addr = ADDR_COMM_STATE;
+    tMcbMsg.u16Size = WORDSIZE_16BIT;
+    tMcbMsg.u16Data[0] = (uint16_t)2U;
+
+    uint32_t u32Millis = Mcb_GetMillis();
+
+    do
+    {
+        ptInst->Mcb_Write(ptInst, &tMcbMsg);
+
+        if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
+        {
+            tMcbMsg.eStatus = MCB_WRITE_ERROR;
+            break;
+        }
+
+    } while ((tMcbMsg.eStatus != MCB_WRITE_ERROR)
+             && (tMcbMsg.eStatus != MCB_WRITE_SUCCESS));
+
+    switch (tMcbMsg.eStatus)
+    {
+        case MCB_WRITE_SUCCESS:
+            /** Do nothing*/
+            break;
+        default:
+            i32Result = CYCLIC_ERR_VALIDATION;
+            break;
+    }
+
+    /** If cyclic mode is correctly enabled */
+    if (i32Result == CYCLIC_MODE_OK)
+    {
+        /** Check bigger mapping and set up generated frame size */
+        if (ptInst->tCyclicRxList.u16MappedSize > ptInst->tCyclicTxList.u16MappedSize)
+        {
+            ptInst->u16CyclicSize = ptInst->tCyclicRxList.u16MappedSize;
+        }
+        else
+        {
+            ptInst->u16CyclicSize = ptInst->tCyclicTxList.u16MappedSize;
+        }
+
+#ifdef MCB_CYCLIC_TX_TRIPLE
+        /** Start from the setpoints written so far */
+        for (uint8_t u8Idx = (uint8_t)0U; u8Idx < (uint8_t)3U; u8Idx++)
+        {
+            memcpy((void*)ptInst->u16CyclicTxSet[u8Idx], (const void*)ptInst->u16CyclicTx,
+                   sizeof(ptInst->u16CyclicTx));
+        }
+        ptInst->u8TxSetBack = (uint8_t)0U;
+        ptInst->u8TxSetMiddle = (uint8_t)1U;
+        ptInst->u8TxSetFront = (uint8_t)2U;
+#endif
+
+        Mcb_IntfSetCyclic(&ptInst->tIntf, true);
+        ptInst->isCyclic = true;
+        i32Result = ptInst->u16CyclicSize;
+    }
+
+    return i32Result;
+}
+
+static uint32_t Mcb_MapSignature(const Mcb_TInst* ptInst)
+{
+    /** FNV-1a over the counters and entries of both lists */
+    uint32_t u32Sign = (uint32_t)2166136261UL;
+    const Mcb_TMappingList* ptList[2] = { &ptInst->tCyclicRxList, &ptInst->tCyclicTxList };
+
+    for (uint8_t u8List = (uint8_t)0U; u8List < (uint8_t)2U; u8List++)
+    {
+        u32Sign = (u32Sign ^ ptList[u8List]->u8Mapped) * (uint32_t)16777619UL;
+        for (uint8_t u8Idx = (uint8_t)0U; u8Idx < ptList[u8List]->u8Mapped; u8Idx++)
+        {
+            u32Sign = (u32Sign ^ ptList[u8List]->u16Addr[u8Idx]) * (uint32_t)16777619UL;
+            u32Sign = (u32Sign ^ ptList[u8List]->u16Sz[u8Idx]) * (uint32_t)16777619UL;
+        }
+    }
+
+    return u32Sign;
+}
+
+static uint32_t Mcb_MapTableSize(const Mcb_TMapEntry* ptTable, uint8_t u8Num)
+{
+    uint32_t u32Words = (uint32_t)0UL;
+
+    for (uint8_t u8Idx = (uint8_t)0U; u8Idx < u8Num; u8Idx++)
+    {
+        /** Registers are word aligned */
+        u32Words += (((uint32_t)ptTable[u8Idx].u16Sz + (uint32_t)1UL) >> 1U);
+    }
+
+    return u32Words;
+}
+
+static bool Mcb_MapRead(Mcb_TInst* ptInst, uint16_t u16Addr, uint16_t* pu16Data)
+{
+    Mcb_EStatus eState;
+    uint16_t u16Sz = WORDSIZE_16BIT;
+    uint32_t u32Millis = Mcb_GetMillis();
+
+    /** Straight to the slave, a cached value would hide a reset */
+    do
+    {
+        eState = Mcb_IntfRead(&ptInst->tIntf, ptInst->u16Node, u16Addr, pu16Data, &u16Sz);
+
+        if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
+        {
+            eState = MCB_READ_ERROR;
+            Mcb_IntfReset(&ptInst->tIntf);
+            break;
+        }
+
+        /** Sleep until the reply is clocked in */
+        if (eState == MCB_READ_ANSWER)
+        {
+            Mcb_BlockingWait(ptInst, u32Millis);
+        }
+    } while ((eState != MCB_READ_ERROR) && (eState != MCB_READ_SUCCESS));
+
+    return (eState == MCB_READ_SUCCESS);
+}
+
+static bool Mcb_MapVerify(Mcb_TInst* ptInst, uint32_t* pu32Stale)
+{
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+    bool isMatch = true;
+    const uint16_t u16Base[2] = { RX_MAP_BASE, TX_MAP_BASE };
+    const Mcb_TMappingList* ptList[2] = { &ptInst->tCyclicRxList, &ptInst->tCyclicTxList };
+
+    *pu32Stale = (uint32_t)0UL;
+
+    for (uint8_t u8List = (uint8_t)0U; u8List < (uint8_t)2U; u8List++)
+    {
+        /** A slave reset clears the counters, entries are checked one by one to rewrite only the lost ones */
+        if ((Mcb_MapRead(ptInst, u16Base[u8List], u16Data) == false)
+            || (u16Data[0] != ptList[u8List]->u8Mapped))
+        {
+            isMatch = false;
+        }
+
+        for (uint8_t u8Idx = (uint8_t)0U; u8Idx < ptList[u8List]->u8Mapped; u8Idx++)
+        {
+            if ((Mcb_MapRead(ptInst, (uint16_t)(u16Base[u8List] + u8Idx + 1U), u16Data) == false)
+                || (u16Data[0] != ptList[u8List]->u16Addr[u8Idx])
+                || (u16Data[1] != ptList[u8List]->u16Sz[u8Idx]))
+            {
+                *pu32Stale |= ((uint32_t)1UL << ((u8List * MAX_MAPPED_REG) + u8Idx));
+                isMatch = false;
+            }
+        }
+    }
+
+    return isMatch;
+}
+
+static int32_t Mcb_MapReplay(Mcb_TInst* ptInst, uint32_t u32Stale)
+{
+    Mcb_TIntfPipeReq tReq[(2U * MAX_MAPPED_REG) + 2U];
+    int32_t i32Result = CYCLIC_MODE_OK;
+    uint16_t u16Num = (uint16_t)0U;
+    uint16_t u16Done;
+    uint16_t u16RxNum;
+    uint8_t u8Idx;
+
+    memset((void*)tReq, 0, sizeof(tReq));
+
+    /** Stale entries first, then the counters that make them effective */
+    for (u8Idx = (uint8_t)0U; u8Idx < ptInst->tCyclicRxList.u8Mapped; u8Idx++)
+    {
+        if ((u32Stale & ((uint32_t)1UL << u8Idx)) == (uint32_t)0UL)
+        {
+            continue;
+        }
+        tReq[u16Num].u16Addr = RX_MAP_BASE + u8Idx + (uint16_t)1U;
+        tReq[u16Num].u16Data[0] = ptInst->tCyclicRxList.u16Addr[u8Idx];
+        tReq[u16Num].u16Data[1] = ptInst->tCyclicRxList.u16Sz[u8Idx];
+        u16Num++;
+    }
+
+    u16RxNum = u16Num;
+
+    for (u8Idx = (uint8_t)0U; u8Idx < ptInst->tCyclicTxList.u8Mapped; u8Idx++)
+    {
+        if ((u32Stale & ((uint32_t)1UL << (MAX_MAPPED_REG + u8Idx))) == (uint32_t)0UL)
+        {
+            continue;
+        }
+        tReq[u16Num].u16Addr = TX_MAP_BASE + u8Idx + (uint16_t)1U;
+        tReq[u16Num].u16Data[0] = ptInst->tCyclicTxList.u16Addr[u8Idx];
+        tReq[u16Num].u16Data[1] = ptInst->tCyclicTxList.u16Sz[u8Idx];
+        u16Num++;
+    }
+
+    tReq[u16Num].u16Addr = RX_MAP_BASE;
+    tReq[u16Num].u16Data[0] = ptInst->tCyclicRxList.u8Mapped;
+    u16Num++;
+    tReq[u16Num].u16Addr = TX_MAP_BASE;
+    tReq[u16Num].u16Data[0] = ptInst->tCyclicTxList.u8Mapped;
+    u16Num++;
+
+    u16Done = Mcb_WriteBatch(ptInst, ptInst->u16Node, tReq, u16Num, true);
+
+    if (u16Done != u16Num)
+    {
+        if (u16Done < u16RxNum)
+        {
+            i32Result = CYCLIC_ERR_RX_MAP;
+        }
+        else
+        {
+            i32Result = CYCLIC_ERR_TX_MAP;
+        }
+    }
+
+    return i32Result;
+}
+
+static bool Mcb_CacheLoad(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg, bool isLearn)
+{
+    bool isHit = false;
+#ifdef MCB_READ_CACHE
+    Mcb_TReadCacheEntry* ptEntry = &ptInst->tReadCache.tEntry[Mcb_CacheIdx(pMcbMsg->u16Node, pMcbMsg->u16Addr)];
+    Mcb_TInfoMsg tInfoMsg;
+
+    if ((isLearn != false) && (ptEntry->ePolicy == MCB_CACHE_UNKNOWN))
+    {
+        /** First read of a register on a free slot, learn its access type. A register
+        colliding with a learnt one is read from the slave without evicting it */
+        tInfoMsg.u16Node = pMcbMsg->u16Node;
+        tInfoMsg.u16Addr = pMcbMsg->u16Addr;
+        Mcb_BlockingGetInfo(ptInst, &tInfoMsg);
+
+        if (tInfoMsg.eStatus != MCB_GETINFO_SUCCESS)
+        {
+            /** Do not retry on every read */
+            ptEntry->u16Node = pMcbMsg->u16Node;
+            ptEntry->u16Addr = pMcbMsg->u16Addr;
+            ptEntry->ePolicy = MCB_CACHE_NEVER;
+            ptEntry->isValid = false;
+        }
+    }
+
+    if ((ptEntry->isValid != false) && (ptEntry->u16Node == pMcbMsg->u16Node)
+        && (ptEntry->u16Addr == pMcbMsg->u16Addr))
+    {
+        pMcbMsg->u16Size = ptEntry->u16Size;
+        memcpy((void*)pMcbMsg->u16Data, (const void*)ptEntry->u16Data, (ptEntry->u16Size * sizeof(uint16_t)));
+        pMcbMsg->u16Cmd = MCB_REP_ACK;
+        pMcbMsg->eStatus = MCB_READ_SUCCESS;
+        ptInst->tReadCache.u32Hits++;
+        isHit = true;
+    }
+#else
+    (void)ptInst;
+    (void)pMcbMsg;
+    (void)isLearn;
+#endif
+    return isHit;
+}
+
+static void Mcb_CacheStore(Mcb_TInst* ptInst, const Mcb_TMsg* pMcbMsg)
+{
+#ifdef MCB_READ_CACHE
+    Mcb_TReadCacheEntry* ptEntry = &ptInst->tReadCache.tEntry[Mcb_CacheIdx(pMcbMsg->u16Node, pMcbMsg->u16Addr)];
+
+    /** Cached registers fit in an entry, the rest of a wide config reply is padding */
+    if ((ptEntry->u16Node == pMcbMsg->u16Node) && (ptEntry->u16Addr == pMcbMsg->u16Addr)
+        && ((ptEntry->ePolicy == MCB_CACHE_SESSION) || (ptEntry->ePolicy == MCB_CACHE_UNTIL_WRITE)))
+    {
+        ptInst->tReadCache.u32Misses++;
+        ptEntry->u16Size = (pMcbMsg->u16Size < MCB_FRM_CONFIG_SZ) ? pMcbMsg->u16Size : MCB_FRM_CONFIG_SZ;
+        memcpy((void*)ptEntry->u16Data, (const void*)pMcbMsg->u16Data, (ptEntry->u16Size * sizeof(uint16_t)));
+        ptEntry->isValid = true;
+    }
+#else
+    (void)ptInst;
+    (void)pMcbMsg;
+#endif
+}
+
+static void Mcb_CacheLearn(Mcb_TInst* ptInst, const Mcb_TInfoMsg* pMcbInfoMsg)
+{
+#ifdef MCB_READ_CACHE
+    Mcb_TReadCacheEntry* ptEntry = &ptInst->tReadCache.tEntry[Mcb_CacheIdx(pMcbInfoMsg->u16Node, pMcbInfoMsg->u16Addr)];
+    const Mcb_TInfoData* ptInfo = &pMcbInfoMsg->tInfoMsgData.tInfoData;
+
+    if ((ptEntry->u16Node != pMcbInfoMsg->u16Node) || (ptEntry->u16Addr != pMcbInfoMsg->u16Addr))
+    {
+        /** Evict the register sharing the slot */
+        ptEntry->u16Node = pMcbInfoMsg->u16Node;
+        ptEntry->u16Addr = pMcbInfoMsg->u16Addr;
+        ptEntry->isValid = false;
+    }
+
+    /** Cyclic capable registers are live data, never keep them */
+    if ((ptInfo->u8CyclicType != (uint8_t)0U)
+        || (((ptInfo->u8Size + 1U) >> 1U) > MCB_FRM_CONFIG_SZ))
+    {
+        ptEntry->ePolicy = MCB_CACHE_NEVER;
+    }
+    else if (ptInfo->u8AccessType == RO_ACCESS)
+    {
+        ptEntry->ePolicy = MCB_CACHE_SESSION;
+    }
+    else if (ptInfo->u8AccessType == RW_ACCESS)
+    {
+        ptEntry->ePolicy = MCB_CACHE_UNTIL_WRITE;
+    }
+    else
+    {
+        ptEntry->ePolicy = MCB_CACHE_NEVER;
+    }
+
+    if (ptEntry->ePolicy == MCB_CACHE_NEVER)
+    {
+        ptEntry->isValid = false;
+    }
+#else
+    (void)ptInst;
+    (void)pMcbInfoMsg;
+#endif
+}
+
+static void Mcb_CacheInvalidate(Mcb_TInst* ptInst, uint16_t u16Node, uint16_t u16Addr)
+{
+#ifdef MCB_READ_CACHE
+    Mcb_TReadCacheEntry* ptEntry = &ptInst->tReadCache.tEntry[Mcb_CacheIdx(u16Node, u16Addr)];
+
+    if ((ptEntry->u16Node == u16Node) && (ptEntry->u16Addr == u16Addr))
+    {
+        ptEntry->isValid = false;
+    }
+#else
+    (void)ptInst;
+    (void)u16Node;
+    (void)u16Addr;
+#endif
+}
+
+static void Mcb_BlockingWait(Mcb_TInst* ptInst, uint32_t u32Millis)
+{
+    uint32_t u32Elapsed = Mcb_GetMillis() - u32Millis;
+
+    if (u32Elapsed < ptInst->u32Timeout)
+    {
+        Mcb_IntfWaitEvent(ptInst->tIntf.u16Id, (ptInst->u32Timeout - u32Elapsed));
+    }
+}
+
+static bool Mcb_CfgQueuePush(Mcb_TInst* ptInst, const Mcb_TMsg* pMcbMsg, Mcb_TMsg* ptUsr, uint8_t* pu8Slot)
+{
+    bool isQueued = false;
+    uint8_t u8Head = ptInst->u8CfgQueueHead;
+    uint8_t u8Next = (uint8_t)((u8Head + 1U) % (MCB_CFG_QUEUE_SZ + 1U));
+    Mcb_TCfgQueueEntry* ptEntry = &ptInst->tCfgQueue[u8Head];
+    bool isLarge = ((pMcbMsg->u16Cmd == MCB_REQ_WRITE) && (pMcbMsg->u16Size > MCB_FRM_MAX_CONFIG_SZ));
+    /** Acquire pairs with the release of Mcb_CfgQueueDone, the slot is no longer read */
+    uint8_t u8Tail = MCB_LOAD_ACQUIRE(ptInst->u8CfgQueueTail);
+
+    /** On an empty queue the config message is not used by the consumer */
+    if ((u8Next != u8Tail) && ((isLarge == false) || (u8Head == u8Tail)))
+    {
+        ptInst->u32CfgTicket++;
+        if (ptInst->u32CfgTicket == (uint32_t)0UL)
+        {
+            ptInst->u32CfgTicket = (uint32_t)1UL;
+        }
+
+        ptEntry->u16Node = pMcbMsg->u16Node;
+        ptEntry->u16Addr = pMcbMsg->u16Addr;
+        ptEntry->u16Cmd = pMcbMsg->u16Cmd;
+        ptEntry->u16Size = (pMcbMsg->u16Size > MCB_MAX_DATA_SZ) ? (uint16_t)MCB_MAX_DATA_SZ : pMcbMsg->u16Size;
+        if (isLarge != false)
+        {
+            memcpy((void*)ptInst->tCfgMsg.u16Data, (const void*)pMcbMsg->u16Data,
+                   (ptEntry->u16Size * sizeof(uint16_t)));
+        }
+        else if (pMcbMsg->u16Cmd == MCB_REQ_WRITE)
+        {
+            memcpy((void*)ptEntry->u16Data, (const void*)pMcbMsg->u16Data, (ptEntry->u16Size * sizeof(uint16_t)));
+        }
+        else
+        {
+            /** Reads and get info requests carry no data */
+        }
+        ptEntry->ptUsr = ptUsr;
+        ptEntry->u32Ticket = ptInst->u32CfgTicket;
+
+        /** Publish the slot contents before the new head */
+        MCB_STORE_RELEASE(ptInst->u8CfgQueueHead, u8Next);
+
+        if (pu8Slot != NULL)
+        {
+            *pu8Slot = u8Head;
+        }
+        isQueued = true;
+    }
+
+    return isQueued;
+}
+
+static bool Mcb_CfgQueueSend(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg, uint32_t u32Millis)
+{
+    bool isDone = false;
+    bool isQueued;
+    uint8_t u8Slot;
+    Mcb_TCfgQueueEntry* ptEntry;
+
+    isQueued = Mcb_CfgQueuePush(ptInst, (const Mcb_TMsg*)pMcbMsg, NULL, &u8Slot);
+
+    /** Slots are released by the cyclic functions, even the ones given up */
+    while ((isQueued == false) && ((Mcb_GetMillis() - u32Millis) <= ptInst->u32Timeout))
+    {
+        Mcb_BlockingWait(ptInst, u32Millis);
+        isQueued = Mcb_CfgQueuePush(ptInst, (const Mcb_TMsg*)pMcbMsg, NULL, &u8Slot);
+    }
+
+    if (isQueued != false)
+    {
+        ptEntry = &ptInst->tCfgQueue[u8Slot];
+
+        while (MCB_LOAD_ACQUIRE(ptEntry->u32Done) != ptEntry->u32Ticket)
+        {
+            if ((Mcb_GetMillis() - u32Millis) > ptInst->u32Timeout)
+            {
+                MCB_STORE_RELEASE(ptEntry->u32Cancel, ptEntry->u32Ticket);
+                break;
+            }
+
+            /** Sleep until the next cyclic frame */
+            Mcb_BlockingWait(ptInst, u32Millis);
+        }
+
+        /** Neither the slot nor the config message are reused before the next push of this same producer */
+        if (MCB_LOAD_ACQUIRE(ptEntry->u32Done) == ptEntry->u32Ticket)
+        {
+            pMcbMsg->u16Cmd = ptInst->tCfgMsg.u16Cmd;
+            pMcbMsg->u16Size = ptInst->tCfgMsg.u16Size;
+            pMcbMsg->eStatus = ptInst->tCfgMsg.eStatus;
+            if (pMcbMsg->u16Size <= MCB_MAX_DATA_SZ)
+            {
+                memcpy((void*)pMcbMsg->u16Data, (const void*)ptInst->tCfgMsg.u16Data,
+                       (pMcbMsg->u16Size * sizeof(uint16_t)));
+            }
+            isDone = true;
+        }
+    }
+
+    return isDone;
+}
+
+static bool Mcb_CfgQueuePop(Mcb_TInst* ptInst)
+{
+    bool isLoaded = false;
+    Mcb_TCfgQueueEntry* ptEntry;
+
+    while (ptInst->u8CfgQueueTail != MCB_LOAD_ACQUIRE(ptInst->u8CfgQueueHead))
+    {
+        ptEntry = &ptInst->tCfgQueue[ptInst->u8CfgQueueTail];
+
+        if (MCB_LOAD_ACQUIRE(ptEntry->u32Cancel) == ptEntry->u32Ticket)
+        {
+            if (ptInst->ptCfgMsg != NULL)
+            {
+                /** Abort the transaction on the bus */
+                ptInst->tIntf.isNewCfgOverCyclic = false;
+                ptInst->tIntf.isCfgOverCyclic = false;
+                ptInst->tIntf.eState = MCB_STANDBY;
+            }
+            Mcb_CfgQueueDone(ptInst, false);
+        }
+        else
+        {
+            if (ptInst->ptCfgMsg == NULL)
+            {
+                /** The config message belongs to the consumer until the slot is released */
+                Mcb_CfgQueueLoad(ptInst, ptEntry);
+                ptInst->ptCfgMsg = &ptInst->tCfgMsg;
+                ptInst->isCfgStop = ((ptEntry->u16Addr == ADDR_COMM_STATE) && (ptEntry->u16Cmd == MCB_REQ_WRITE)
+                                     && (ptInst->tCfgMsg.u16Data[0] == (uint16_t)1U));
+                ptInst->tIntf.isNewCfgOverCyclic = true;
+                isLoaded = true;
+            }
+            break;
+        }
+    }
+
+    return isLoaded;
+}
+
+static void Mcb_CfgQueueLoad(Mcb_TInst* ptInst, const Mcb_TCfgQueueEntry* ptEntry)
+{
+    Mcb_TMsg* ptMsg = &ptInst->tCfgMsg;
+
+    ptMsg->u16Node = ptEntry->u16Node;
+    ptMsg->u16Addr = ptEntry->u16Addr;
+    ptMsg->u16Cmd = ptEntry->u16Cmd;
+    ptMsg->u16Size = ptEntry->u16Size;
+    ptMsg->eStatus = MCB_STANDBY;
+
+    if ((ptEntry->u16Cmd == MCB_REQ_WRITE) && (ptEntry->u16Size <= MCB_FRM_MAX_CONFIG_SZ))
+    {
+        memcpy((void*)ptMsg->u16Data, (const void*)ptEntry->u16Data, (ptEntry->u16Size * sizeof(uint16_t)));
+    }
+
+    /** Submitted messages keep their callback once the reply is copied back */
+    if (ptEntry->ptUsr != NULL)
+    {
+        ptMsg->ComplEvnt = ptEntry->ptUsr->ComplEvnt;
+        ptMsg->pUsrCtx = ptEntry->ptUsr->pUsrCtx;
+    }
+    else
+    {
+        ptMsg->ComplEvnt = NULL;
+        ptMsg->pUsrCtx = NULL;
+    }
+}
+
+static Mcb_EStatus Mcb_CfgQueueServe(Mcb_TInst* ptInst, bool* pisCfgData)
+{
+    Mcb_EStatus eState = MCB_STANDBY;
+    Mcb_TMsg* ptMsg = ptInst->ptCfgMsg;
+
+    *pisCfgData = false;
+
+    if (ptMsg != NULL)
+    {
+        eState = Mcb_IntfCfgOverCyclic(&ptInst->tIntf, ptMsg->u16Node, ptMsg->u16Addr, &ptMsg->u16Cmd,
+                                       ptMsg->u16Data, &ptMsg->u16Size, pisCfgData);
+    }
+
+    return eState;
+}
+
+static void Mcb_CfgQueueDone(Mcb_TInst* ptInst, bool isReply)
+{
+    Mcb_TCfgQueueEntry* ptEntry = &ptInst->tCfgQueue[ptInst->u8CfgQueueTail];
+
+    ptInst->ptCfgMsg = NULL;
+    ptInst->isCfgStop = false;
+
+    /** Publish the reply, then release the slot. Dropped requests may hold a partial reply */
+    if (isReply != false)
+    {
+        MCB_STORE_RELEASE(ptEntry->u32Done, ptEntry->u32Ticket);
+    }
+    MCB_STORE_RELEASE(ptInst->u8CfgQueueTail, (uint8_t)((ptInst->u8CfgQueueTail + 1U) % (MCB_CFG_QUEUE_SZ + 1U)));
+}
+
+static bool Mcb_CfgQueueIsBusy(const Mcb_TInst* ptInst)
+{
+    /** Requests are released once completed, so an empty queue is an idle one */
+    return (MCB_LOAD_ACQUIRE(ptInst->u8CfgQueueTail) != ptInst->u8CfgQueueHead);
+}
+
+static void Mcb_CfgQueueFlush(Mcb_TInst* ptInst)
+{
+    ptInst->u8CfgQueueHead = (uint8_t)0U;
+    ptInst->u8CfgQueueTail = (uint8_t)0U;
+    ptInst->u32CfgTicket = (uint32_t)0UL;
+    ptInst->ptCfgMsg = NULL;
+    ptInst->isCfgStop = false;
+    ptInst->tIntf.isNewCfgOverCyclic = false;
+
+    for (uint8_t u8Idx = (uint8_t)0U; u8Idx < (MCB_CFG_QUEUE_SZ + 1U); u8Idx++)
+    {
+        ptInst->tCfgQueue[u8Idx].u32Ticket = (uint32_t)0UL;
+        ptInst->tCfgQueue[u8Idx].u32Done = (uint32_t)0UL;
+        ptInst->tCfgQueue[u8Idx].u32Cancel = (uint32_t)0UL;
+    }
+}
+
+static void Mcb_SubmitCompl(Mcb_TInst* ptInst, Mcb_TMsg* ptUsr, const Mcb_TMsg* pMcbMsg)
+{
+    if (pMcbMsg != NULL)
+    {
+        memcpy((void*)ptUsr, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
+    }
+
+    if (ptUsr->ComplEvnt != NULL)
+    {
+        ptUsr->ComplEvnt(ptInst, ptUsr);
+    }
+}
+
+static void Mcb_SubmitFlush(Mcb_TInst* ptInst)
+{
+    ptInst->u8SubmitHead = (uint8_t)0U;
+    ptInst->u8SubmitTail = (uint8_t)0U;
+    ptInst->isSubmitStarted = false;
+}
+
+static void Mcb_CyclicRxBegin(Mcb_TInst* ptInst)
+{
+    uint32_t u32Seq = ptInst->u32CyclicRxSeq;
+
+    if ((u32Seq & (uint32_t)1UL) == (uint32_t)0UL)
+    {
+        ptInst->u32CyclicRxSeq = u32Seq + (uint32_t)1UL;
+        /** Readers see the odd version before any byte of the buffer changes */
+        MCB_FENCE_RELEASE();
+    }
+}
+
+static void Mcb_CyclicRxEnd(Mcb_TInst* ptInst)
+{
+    uint32_t u32Seq = ptInst->u32CyclicRxSeq;
+
+    if ((u32Seq & (uint32_t)1UL) != (uint32_t)0UL)
+    {
+        MCB_STORE_RELEASE(ptInst->u32CyclicRxSeq, (u32Seq + (uint32_t)1UL));
+    }
+}
+
+static uint16_t* Mcb_CyclicTxFront(Mcb_TInst* ptInst)
+{
+#ifdef MCB_CYCLIC_TX_TRIPLE
+    if ((MCB_LOAD_ACQUIRE(ptInst->u8TxSetMiddle) & MCB_TX_SET_FRESH) != (uint8_t)0U)
+    {
+        ptInst->u8TxSetFront = (uint8_t)(MCB_EXCHANGE(ptInst->u8TxSetMiddle, ptInst->u8TxSetFront)
+                                         & (uint8_t)~MCB_TX_SET_FRESH);
+    }
+
+    return ptInst->u16CyclicTxSet[ptInst->u8TxSetFront];
+#else
+    return MCB_CYCLIC_TX_BUF(ptInst);
+#endif
 }
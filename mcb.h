@@ -21,12 +21,84 @@
 
 #include "mcb_intf.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** Default timeout for blocking mode */
 #define MCB_DFLT_TIMEOUT (uint32_t)1000UL
 
 /** Maximum number of mapped registers simultaneously */
 #define MAX_MAPPED_REG (uint8_t)15U
 
+/**
+ * Compact instance mode. If defined, the limits below not given by the
+ * application default to small values, for targets running several buses:
+ * parked state for nodes 0 to 3 only, a single queued config over cyclic
+ * request, 2 submitted requests and batch reads of 4 registers.
+ */
+
+/** Number of registers read on a single pipelined sequence */
+#ifndef MCB_READ_BATCH_SZ
+#ifdef MCB_COMPACT
+#define MCB_READ_BATCH_SZ (uint16_t)4U
+#else
+#define MCB_READ_BATCH_SZ (uint16_t)16U
+#endif
+#endif
+
+/** Number of config over cyclic requests that can be queued */
+#ifndef MCB_CFG_QUEUE_SZ
+#ifdef MCB_COMPACT
+#define MCB_CFG_QUEUE_SZ (uint8_t)1U
+#else
+#define MCB_CFG_QUEUE_SZ (uint8_t)4U
+#endif
+#endif
+
+/** Number of requests that can be submitted out of cyclic mode */
+#ifndef MCB_SUBMIT_QUEUE_SZ
+#ifdef MCB_COMPACT
+#define MCB_SUBMIT_QUEUE_SZ (uint8_t)2U
+#else
+#define MCB_SUBMIT_QUEUE_SZ (uint8_t)8U
+#endif
+#endif
+
+/**
+ * Triple buffered cyclic transmission. If defined, the setpoints written
+ * through the Mcb_RxMap pointers are only sent once Mcb_CyclicTxPublish is
+ * called, and always as a complete set.
+ */
+#if defined(MCB_CYCLIC_TX_TRIPLE) && defined(MCB_CYCLIC_ZERO_COPY)
+#error "Triple buffered transmission requires the cyclic copy buffers"
+#endif
+
+#if defined(MCB_CYCLIC_TX_TRIPLE) && !defined(MCB_EXCHANGE)
+#error "Triple buffered transmission requires MCB_EXCHANGE"
+#endif
+
+#ifdef MCB_CYCLIC_TX_TRIPLE
+/** Flag of a published set not picked up by the cyclic functions yet */
+#define MCB_TX_SET_FRESH (uint8_t)0x80U
+#endif
+
+/**
+ * Zero-copy cyclic mode. If defined, the pointers returned by Mcb_RxMap point
+ * straight into the cyclic area of the transmission frame, so setpoints are
+ * not copied on every cycle. Config frames out of cyclic mode are assembled
+ * on a frame of their own.
+ *
+ * @note Received data is still copied into the buffer of the Mcb_TxMap
+ *       pointers, and only once the CRC of the frame has been checked.
+ */
+#ifdef MCB_CYCLIC_ZERO_COPY
+#define MCB_CYCLIC_TX_BUF(ptInst)   (&(ptInst)->tIntf.tTxfrm[0].u16Buf[MCB_FRM_CYCLIC_POS((ptInst)->tIntf.u16CfgSz)])
+#else
+#define MCB_CYCLIC_TX_BUF(ptInst)   ((ptInst)->u16CyclicTx)
+#endif
+#define MCB_CYCLIC_RX_BUF(ptInst)   ((ptInst)->u16CyclicRx)
+
 /* Return code list during enabling cyclic mode */
 /** Cyclic mode reached correctly */
 #define CYCLIC_MODE_OK (int32_t)0L
@@ -38,6 +110,8 @@
 #define CYCLIC_ERR_VALIDATION (int32_t)-3L
 /** Cyclic mode reached correctly */
 #define CYCLIC_ERR_SYNC (int32_t)-4L
+/** Mapping can not be changed, cyclic mode is already enabled */
+#define CYCLIC_ERR_STATE (int32_t)-5L
 
 /** Default MCB Coco Node */
 #define DEFAULT_COCO_NODE (uint16_t)0U
@@ -71,8 +145,13 @@ typedef enum
     MCB_CYC_SYNC0_SYNC1
 } Mcb_ECyclicMode;
 
+/** Motion control bus instance */
+typedef struct Mcb_TInst Mcb_TInst;
+
 /** Frame data struct */
-typedef struct
+typedef struct Mcb_TMsg Mcb_TMsg;
+
+struct Mcb_TMsg
 {
     /** Destination / source node */
     uint16_t u16Node;
@@ -86,7 +165,11 @@ typedef struct
     uint16_t u16Data[MCB_MAX_DATA_SZ];
     /** Message status */
     Mcb_EStatus eStatus;
-} Mcb_TMsg;
+    /** Completion callback of a submitted message, may be NULL */
+    void (*ComplEvnt)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+    /** User context of a submitted message */
+    void* pUsrCtx;
+};
 
 /** Info frame data struct */
 typedef struct
@@ -102,6 +185,10 @@ typedef struct
     Mcb_TInfoMsgData tInfoMsgData;
     /** Message status */
     Mcb_EStatus eStatus;
+    /** Unused, keeps the layout of Mcb_TMsg */
+    void (*ComplEvnt)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+    /** Unused, keeps the layout of Mcb_TMsg */
+    void* pUsrCtx;
 } Mcb_TInfoMsg;
 
 /** List struct to store mapped registers */
@@ -117,20 +204,155 @@ typedef struct
     uint16_t u16Sz[MAX_MAPPED_REG];
 } Mcb_TMappingList;
 
-/** Motion control bus instance */
-typedef struct Mcb_TInst Mcb_TInst;
+/** Entry of a batch mapping table */
+typedef struct
+{
+    /** Key address of the register to be mapped */
+    uint16_t u16Addr;
+    /** Size (bytes) of the register to be mapped */
+    uint16_t u16Sz;
+    /** Pointer to cyclic buffer where data is located, set once mapped */
+    void* pData;
+} Mcb_TMapEntry;
+
+#ifdef MCB_READ_CACHE
+/** Number of registers held by the read cache */
+#ifndef MCB_READ_CACHE_SZ
+#define MCB_READ_CACHE_SZ (uint16_t)32U
+#endif
+
+/** Read cache policy of a register */
+typedef enum
+{
+    /** Access type not known yet */
+    MCB_CACHE_UNKNOWN = 0,
+    /** Read only constant, valid for the whole session */
+    MCB_CACHE_SESSION,
+    /** Read / write, valid until it is written through this instance */
+    MCB_CACHE_UNTIL_WRITE,
+    /** Volatile or write only, never cached */
+    MCB_CACHE_NEVER
+} Mcb_ECachePolicy;
+
+/** Read cache entry */
+typedef struct
+{
+    /** Register node */
+    uint16_t u16Node;
+    /** Register address */
+    uint16_t u16Addr;
+    /** Register policy */
+    Mcb_ECachePolicy ePolicy;
+    /** Indicates if u16Data holds the register value */
+    bool isValid;
+    /** Register value size (words) */
+    uint16_t u16Size;
+    /** Register value, only single frame registers are cached */
+    uint16_t u16Data[MCB_FRM_CONFIG_SZ];
+} Mcb_TReadCacheEntry;
+
+/** Read cache of an instance */
+typedef struct
+{
+    /** Entries, indexed by a hash of node and address */
+    Mcb_TReadCacheEntry tEntry[MCB_READ_CACHE_SZ];
+    /** Reads served from the cache */
+    uint32_t u32Hits;
+    /** Reads of cached registers sent to the slave */
+    uint32_t u32Misses;
+} Mcb_TReadCache;
+#endif
+
+/**
+ * Queued config over cyclic request
+ *
+ * @note Requests are served on the instance config message, which holds
+ *       their reply. The data of writes larger than MCB_FRM_MAX_CONFIG_SZ
+ *       words is stored there when queued, so they are only queued on an
+ *       empty queue.
+ */
+typedef struct
+{
+    /** Destination node */
+    uint16_t u16Node;
+    /** Target register address */
+    uint16_t u16Addr;
+    /** Request command */
+    uint16_t u16Cmd;
+    /** Request data size (words) */
+    uint16_t u16Size;
+    /** Write data, if it fits in a config frame */
+    uint16_t u16Data[MCB_FRM_MAX_CONFIG_SZ];
+    /** Submitted user message completed through its callback, NULL if none */
+    Mcb_TMsg* ptUsr;
+    /** Ticket of the request, never 0 */
+    uint32_t u32Ticket;
+    /** Ticket of the last request completed on this slot */
+    volatile uint32_t u32Done;
+    /** Ticket of the last request given up on this slot */
+    volatile uint32_t u32Cancel;
+} Mcb_TCfgQueueEntry;
 
-/** Main motion control instance */
+/** Request submitted out of cyclic mode */
+typedef struct
+{
+    /** User message, in use until its completion */
+    Mcb_TMsg* ptMsg;
+    /** Write request if true, read request otherwise */
+    bool isWrite;
+} Mcb_TSubmitEntry;
+
+/**
+ * Main motion control instance
+ *
+ * @note Fields used on every cycle come first, so the cyclic functions touch
+ *       as few cache lines as possible. Fields only used by config requests,
+ *       mapping and mode changes follow.
+ */
 struct Mcb_TInst
 {
     /** Indicates if mcb is in cyclic mode */
     volatile bool isCyclic;
+    /** Indicates if the active config request stops cyclic mode */
+    bool isCfgStop;
+    /** Next free slot of the config queue, written by the producer only */
+    volatile uint8_t u8CfgQueueHead;
+    /** Oldest request not completed yet, written by the consumer only */
+    volatile uint8_t u8CfgQueueTail;
+    /** Cyclic transmission size */
+    uint16_t u16CyclicSize;
+#ifdef MCB_CYCLIC_TX_TRIPLE
+    /** Set filled by Mcb_CyclicTxPublish, owned by the application */
+    uint8_t u8TxSetBack;
+    /** Set exchanged between both sides, flagged with MCB_TX_SET_FRESH once published */
+    volatile uint8_t u8TxSetMiddle;
+    /** Set sent on the wire, owned by the cyclic functions */
+    uint8_t u8TxSetFront;
+#endif
+    /** Version of the cyclic reception buffer, odd while it is being updated */
+    volatile uint32_t u32CyclicRxSeq;
+    /** Active config over cyclic request, the config message. NULL if none */
+    Mcb_TMsg* ptCfgMsg;
+    /** Callback to config over cyclic frame reception */
+    void (*CfgOverCyclicEvnt)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+#ifndef MCB_CYCLIC_ZERO_COPY
+    /** Cyclic transmission (from MCB master point of view) buffer */
+    uint16_t u16CyclicTx[MCB_FRM_MAX_CYCLIC_SZ];
+#endif
+    /** Cyclic reception (from MCB master point of view) buffer */
+    uint16_t u16CyclicRx[MCB_FRM_MAX_CYCLIC_SZ];
+#ifdef MCB_CYCLIC_TX_TRIPLE
+    /** Published cyclic transmission sets */
+    uint16_t u16CyclicTxSet[3][MCB_FRM_MAX_CYCLIC_SZ];
+#endif
+    /** Linked mcb module */
+    Mcb_TIntf tIntf;
     /** Indicates the active syncrhonisation config */
     Mcb_ECyclicMode eSyncMode;
     /** Indicates the timeout applied for blocking transmissions */
     uint32_t u32Timeout;
-    /** Linked mcb module */
-    Mcb_TIntf tIntf;
+    /** Node used by mapping, cyclic and communication state requests */
+    uint16_t u16Node;
     /** Transmission mode */
     Mcb_EMode eMode;
     /** Callback to getinfo function */
@@ -139,24 +361,36 @@ struct Mcb_TInst
     void (*Mcb_Read)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
     /** Callback to write function */
     void (*Mcb_Write)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
-    /** Config transmission Msg request */
-    Mcb_TMsg tConfigReq;
-    /** Config transmission Msg reply */
-    Mcb_TMsg tConfigRpy;
-    /** Config message user pointer */
-    Mcb_TMsg* ptUsrConfig;
-    /** Cyclic transmission (from MCB master point of view) buffer */
-    uint16_t u16CyclicTx[MCB_FRM_MAX_CYCLIC_SZ];
-    /** Cyclic reception (from MCB master point of view) buffer */
-    uint16_t u16CyclicRx[MCB_FRM_MAX_CYCLIC_SZ];
-    /** Cyclic transmission size */
-    uint16_t u16CyclicSize;
+    /**
+     * Pending config over cyclic requests, one slot is kept empty. Single
+     * producer, single consumer: requests are queued by one application
+     * thread and served by Mcb_CyclicProcessLatch
+     */
+    Mcb_TCfgQueueEntry tCfgQueue[MCB_CFG_QUEUE_SZ + 1U];
+    /** Config over cyclic request being served, replaced by its reply */
+    Mcb_TMsg tCfgMsg;
+    /** Last ticket given to a queued request */
+    uint32_t u32CfgTicket;
+    /** Requests submitted out of cyclic mode, one slot is kept empty */
+    Mcb_TSubmitEntry tSubmit[MCB_SUBMIT_QUEUE_SZ + 1U];
+    /** Next free slot of the submit queue */
+    uint8_t u8SubmitHead;
+    /** Request being processed from the submit queue */
+    uint8_t u8SubmitTail;
+    /** Indicates if the first request of the submit queue is on the bus */
+    bool isSubmitStarted;
+    /** Time the first request of the submit queue went on the bus */
+    uint32_t u32SubmitMillis;
     /** RX mapping (from MCB slave point of view) list */
     Mcb_TMappingList tCyclicRxList;
     /** TX mapping (from MCB slave point of view) list */
     Mcb_TMappingList tCyclicTxList;
-    /** Callback to config over cyclic frame reception */
-    void (*CfgOverCyclicEvnt)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+    /** Signature of the mapping lists last enabled into the slave, 0 if none */
+    uint32_t u32MapSign;
+#ifdef MCB_READ_CACHE
+    /** Read cache of config registers */
+    Mcb_TReadCache tReadCache;
+#endif
 };
 
 /** 
@@ -188,6 +422,82 @@ int32_t Mcb_Init(Mcb_TInst* ptInst, Mcb_EMode eMode, uint16_t u16Id, bool bCalcC
  */
 void Mcb_Deinit(Mcb_TInst* ptInst);
 
+/**
+ * Selects the node used by mapping, cyclic and communication state requests
+ *
+ * @note Config requests address the node given on each message. The
+ *       default node is DEFAULT_MOCO_NODE.
+ * @note The node can only be changed out of cyclic mode and with empty
+ *       mapping lists, and only to nodes below MCB_NUMBER_NODES.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in] u16Node
+ *  Target node
+ *
+ * @retval true if the node has been changed, false if it is out of range or
+ *         the instance is mapped or in cyclic mode
+ */
+bool
+Mcb_SetNode(Mcb_TInst* ptInst, uint16_t u16Node);
+
+/**
+ * Sets the config data size of the frames exchanged with the slaves
+ *
+ * @note Registers larger than the config data size are transferred in
+ *       segments, so a wider config data size reduces the number of frames
+ *       of large transfers. The slaves must be configured with the same size.
+ * @note The size can only be changed out of cyclic mode and with empty
+ *       mapping lists. Mcb_Init restores the default size, MCB_FRM_CONFIG_SZ.
+ * @note MCB_FRM_MAX_CONFIG_SZ defaults to MCB_FRM_CONFIG_SZ, so wider sizes
+ *       require the library to be built with a wider maximum.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in] u16CfgSz
+ *  Config data size (words), a power of two from MCB_FRM_CONFIG_SZ
+ *  to MCB_FRM_MAX_CONFIG_SZ
+ *
+ * @retval true if the size has been changed, false otherwise
+ */
+bool
+Mcb_SetConfigSize(Mcb_TInst* ptInst, uint16_t u16CfgSz);
+
+#ifdef MCB_READ_CACHE
+/**
+ * Gets the read cache counters
+ *
+ * @note Only config reads out of cyclic mode use the cache. Access types
+ *       are learnt from get info replies, and blocking reads request them
+ *       the first time a register is read. Read only registers are kept for
+ *       the whole session, read / write ones until they are written through
+ *       the instance, and cyclic capable or write only ones are never kept.
+ * @note A slot holds the first register learnt on it until the cache is
+ *       flushed or another register of the slot gets a get info reply.
+ *       Reads of the registers colliding with it go to the slave, and
+ *       blocking reads do not request their info.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[out] pu32Hits
+ *  Reads served from the cache
+ * @param[out] pu32Misses
+ *  Reads of cached registers sent to the slave, reads of registers which
+ *  are never cached are not counted
+ */
+void
+Mcb_ReadCacheStats(const Mcb_TInst* ptInst, uint32_t* pu32Hits, uint32_t* pu32Misses);
+
+/**
+ * Drops every cached value and learnt access type, i.e. after a slave reset
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ */
+void
+Mcb_ReadCacheFlush(Mcb_TInst* ptInst);
+#endif
+
 /**
  * Attach an user callback to the reception event of a config frame over
  * Cyclic mode
@@ -202,6 +512,45 @@ void Mcb_Deinit(Mcb_TInst* ptInst);
 void
 Mcb_AttachCfgOverCyclicCB(Mcb_TInst* ptInst, void (*Evnt)(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg));
 
+/**
+ * Submits a read or write request, completed through the callback of the
+ * message
+ *
+ * @note The message is used by the library until its ComplEvnt is called,
+ *       with the reply and a terminal status. Out of cyclic mode, requests
+ *       are served in order by Mcb_Poll. In cyclic mode they are queued as
+ *       config over cyclic requests and completed by Mcb_CyclicProcessLatch.
+ *       In blocking mode the request is served before returning.
+ *       Requests submitted out of cyclic mode must be completed before
+ *       enabling cyclic mode.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in] pMcbMsg
+ *  Request, with its ComplEvnt and pUsrCtx set
+ * @param[in] isWrite
+ *  Write request if true, read request otherwise
+ *
+ * @retval true if the request has been submitted, false if the queue is full
+ */
+bool
+Mcb_Submit(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg, bool isWrite);
+
+/**
+ * Processes the requests submitted out of cyclic mode
+ *
+ * @note To be called from the main loop or the IRQ event. The completion
+ *       callbacks are called from here. A request not finished within the
+ *       instance timeout completes with an error status.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ *
+ * @retval Number of submitted requests not completed yet
+ */
+uint8_t
+Mcb_Poll(Mcb_TInst* ptInst);
+
 /**
  * Map a Tx cyclic register into the cyclic buffer
  *
@@ -273,10 +622,98 @@ Mcb_RxUnmap(Mcb_TInst* ptInst);
 void
 Mcb_UnmapAll(Mcb_TInst* ptInst);
 
+/**
+ * Reads a list of registers.
+ *
+ * @note Blocking function, out of cyclic mode. Registers are read pipelined:
+ *       the request of every register is sent on the frame which receives
+ *       the reply of the previous one. Registers larger than a config frame
+ *       and registers replying an error are read again through Mcb_Read.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in] u16Node
+ *  Target slave
+ * @param[in] pu16Addr
+ *  Register addresses
+ * @param[out] ptMsg
+ *  Results, one message per register with its data, size and status
+ * @param[in] u16Num
+ *  Number of registers
+ *
+ * @retval Number of registers read successfully
+ */
+uint16_t
+Mcb_ReadBatch(Mcb_TInst* ptInst, uint16_t u16Node, const uint16_t* pu16Addr, Mcb_TMsg* ptMsg, uint16_t u16Num);
+
+/**
+ * Writes a list of registers of a single config frame each.
+ *
+ * @note Blocking function whatever the instance mode, out of cyclic mode.
+ *       Writes are pipelined: the request of every register is sent on the
+ *       frame which receives the reply of the previous one. Without replay,
+ *       the list stops on the first lost reply and the registers from the
+ *       returned index on may or may not have been written. See
+ *       Mcb_IntfWritePipe.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in] u16Node
+ *  Target slave
+ * @param[in] ptReq
+ *  Register addresses and data
+ * @param[in] u16Num
+ *  Number of registers
+ * @param[in] isReplay
+ *  Replay the writes whose reply has been lost, only for idempotent writes
+ *
+ * @retval Number of registers written successfully, in list order
+ */
+uint16_t
+Mcb_WriteBatch(Mcb_TInst* ptInst, uint16_t u16Node, const Mcb_TIntfPipeReq* ptReq, uint16_t u16Num,
+               bool isReplay);
+
+/**
+ * Replaces the whole mapping and enables cyclic mode.
+ *
+ * @note Blocking function. Mapping entries and both counters are written
+ *       pipelined, one register per frame, then the communication state is
+ *       written as in @ref Mcb_EnableCyclic.
+ * @note If the tables match the mapping enabled last time, the slave
+ *       mapping is read back and only what does not match is written, as in
+ *       @ref Mcb_EnableCyclic.
+ * @note A table not fitting in MCB_FRM_MAX_CYCLIC_SZ words fails with
+ *       CYCLIC_ERR_RX_MAP or CYCLIC_ERR_TX_MAP, nothing is written.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in, out] ptRxTable
+ *  Rx (from MCB slave point of view) mapping table, pData is set on success
+ * @param[in] u8RxNum
+ *  Number of Rx entries, up to MAX_MAPPED_REG
+ * @param[in, out] ptTxTable
+ *  Tx (from MCB slave point of view) mapping table, pData is set on success
+ * @param[in] u8TxNum
+ *  Number of Tx entries, up to MAX_MAPPED_REG
+ *
+ *  @retval > 0 if transition successful, indicating the cyclic size.
+ *          < 0 indicates an errorcode.
+ */
+int32_t
+Mcb_MapBatch(Mcb_TInst* ptInst, Mcb_TMapEntry* ptRxTable, uint8_t u8RxNum,
+             Mcb_TMapEntry* ptTxTable, uint8_t u8TxNum);
+
 /**
  * Enables cyclic mode.
  *
  * @note Blocking function, while the config is written into driver.
+ * @note If the mapping is the same one enabled last time, the slave mapping
+ *       counters and entries are read back instead of written, and only the
+ *       entries which do not match are written again, followed by both
+ *       counters (i.e. the slave has been reset).
+ * @note The slave mapping is only checked here and in @ref Mcb_MapBatch. A
+ *       slave reset while in cyclic mode is not detected until cyclic mode
+ *       is enabled again.
  *
  * @param[in] ptInst
  *  Mcb instance
@@ -341,15 +778,73 @@ Mcb_SetCyclicMode(Mcb_TInst* ptInst, Mcb_ECyclicMode eNewCycMode);
 bool
 Mcb_CyclicProcessLatch(Mcb_TInst* ptInst, Mcb_EStatus* eCfgStat);
 
+/**
+ * Assemble the next cyclic frame in advance.
+ *
+ * @note It can be called while the previous cyclic transfer is on the wire,
+ *       so the frame (cyclic data and CRC) is ready when
+ *       Mcb_CyclicProcessLatch is called. The frame is only used if no config
+ *       data has to be sent on that cycle. Requires MCB_FRM_PAIRS > 1.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ *
+ * @retval true if the frame has been prepared
+ *         false otherwise
+ */
+bool
+Mcb_CyclicPrepare(Mcb_TInst* ptInst);
+
 /**
  * Process the received cyclic buffer.
  *
  * @param[in] ptInst
  *  Mcb instance
+ *
+ * @retval true if the received cyclic data is valid and has been updated
+ *         false otherwise
  */
-void
+bool
 Mcb_CyclicFrameProcess(Mcb_TInst* ptInst);
 
+#ifdef MCB_CYCLIC_TX_TRIPLE
+/**
+ * Publishes the setpoints written through the Mcb_RxMap pointers
+ *
+ * @note To be called from a single application thread once a complete set
+ *       of setpoints has been written. The next cyclic frame sends the
+ *       newest published set. Neither side waits for the other.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ */
+void
+Mcb_CyclicTxPublish(Mcb_TInst* ptInst);
+#endif
+
+/**
+ * Copies a consistent snapshot of the cyclic reception buffer
+ *
+ * @note Any number of threads can take snapshots while the cyclic functions
+ *       run on another one. The copy is retried if a frame is received
+ *       meanwhile, the cyclic functions never wait for readers.
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[out] pu16Buf
+ *  Snapshot, laid out as the buffer where Mcb_TxMap pointers point to
+ * @param[in] u16Sz
+ *  Words to be copied, up to the mapped Tx size
+ *
+ * @retval Version of the snapshot, it changes on every received frame
+ */
+uint32_t
+Mcb_CyclicRxSnapshot(const Mcb_TInst* ptInst, uint16_t* pu16Buf, uint16_t u16Sz);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
 
 /** @} */
@@ -34,6 +34,7 @@
 #ifndef DEF_LIBCRC_CHECKSUM_H
 #define DEF_LIBCRC_CHECKSUM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <strings.h>
 
@@ -72,6 +73,20 @@
 #define		CRC_START_64_ECMA	    0x0000000000000000ull
 #define		CRC_START_64_WE		    0xFFFFFFFFFFFFFFFFull
 
+/*
+ * #define CRC_CCITT_CLMUL
+ *
+ * Enables the carry-less multiplication version of the word oriented CRC-CCITT
+ * on little endian x86-64 and ARMv8 targets. It is selected at run time when
+ * the CPU supports it. Define CRC_CCITT_NO_CLMUL to disable it.
+ */
+
+#if !defined(CRC_CCITT_NO_CLMUL) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__aarch64__)) && \
+    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define		CRC_CCITT_CLMUL
+#endif
+
 /*
  * Prototype list of global functions
  */
@@ -89,6 +104,11 @@ uint16_t		    crc_kermit(         const unsigned char *input_str, size_t num_byt
 uint16_t		    crc_modbus(         const unsigned char *input_str, size_t num_bytes       );
 uint16_t		    crc_sick(           const unsigned char *input_str, size_t num_bytes       );
 uint16_t		    crc_xmodem(         const unsigned char *input_str, size_t num_bytes       );
+uint16_t		    crc_ccitt_words(    uint16_t crc, const uint16_t *input_words, size_t num_words );
+#ifdef CRC_CCITT_CLMUL
+uint16_t		    crc_ccitt_words_clmul( uint16_t crc, const uint16_t *input_words, size_t num_words );
+bool			    crc_ccitt_clmul_available( void                                        );
+#endif
 uint8_t			    update_crc_8(       uint8_t  crc, unsigned char c                          );
 uint16_t		    update_crc_16(      uint16_t crc, unsigned char c                          );
 uint32_t		    update_crc_32(      uint32_t crc, unsigned char c                          );
@@ -0,0 +1,275 @@
+/**
+ * @file mcb_coro.hpp
+ * @brief This file contains a C++20 coroutine API over the non-blocking
+ *        mode of the motion control bus (MCB)
+ *
+ * Config requests are awaited from coroutines instead of polling their
+ * state. Awaited requests are queued in an intrusive list, the request and
+ * its message live in the frame of the awaiting coroutine, so no memory is
+ * allocated per request. A single loop calling Bus::poll drives all of them.
+ *
+ * @code
+ * mcb::Task Homing(mcb::Bus& tBus)
+ * {
+ *     Mcb_TMsg tRpy = co_await tBus.read(0x011U);
+ *     ...
+ * }
+ *
+ * while (tBus.poll()) { wait for the IRQ event }
+ * @endcode
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+ /**
+ * \addtogroup CoroAPI Coroutine API
+ *
+ * @{
+ *
+ *  C++20 coroutine wrapper of the non-blocking mode
+ */
+
+#ifndef MCB_CORO_HPP
+#define MCB_CORO_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+
+#include "mcb.h"
+
+namespace mcb
+{
+
+/**
+ * Coroutine started eagerly and detached from its caller, its frame is
+ * released once it returns
+ */
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+class Bus;
+
+/** Config request awaited by a coroutine */
+class Op
+{
+public:
+    Op(const Op&) = delete;
+    Op& operator=(const Op&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> hCaller) noexcept;
+
+    /** Reply of the request, eStatus tells if it succeeded. Returned by
+     *  value, the awaited Op is a temporary gone by the end of the statement */
+    Mcb_TMsg await_resume() const noexcept { return tMsg; }
+
+private:
+    friend class Bus;
+
+    Op(Bus& tOwner, bool isWriteReq, uint16_t u16Node, uint16_t u16Addr,
+       const uint16_t* pu16Data = nullptr, uint16_t u16Size = (uint16_t)0U) noexcept
+        : tBus(tOwner), isWrite(isWriteReq)
+    {
+        tMsg.u16Node = u16Node;
+        tMsg.u16Addr = u16Addr;
+        tMsg.u16Size = (u16Size < MCB_MAX_DATA_SZ) ? u16Size : (uint16_t)MCB_MAX_DATA_SZ;
+        tMsg.eStatus = MCB_STANDBY;
+        if (pu16Data != nullptr)
+        {
+            std::memcpy(tMsg.u16Data, pu16Data, (tMsg.u16Size * sizeof(uint16_t)));
+        }
+    }
+
+    /** Request and reply */
+    Mcb_TMsg tMsg;
+    /** Bus driving the request */
+    Bus& tBus;
+    /** Write request if true, read request otherwise */
+    bool isWrite;
+    /** Indicates if the request is on the bus */
+    bool isStarted = false;
+    /** Time the request went on the bus */
+    uint32_t u32Millis = 0UL;
+    /** Coroutine resumed once the request finishes */
+    std::coroutine_handle<> hCaller;
+    /** Next queued request */
+    Op* ptNext = nullptr;
+};
+
+/**
+ * Non-blocking instance driven by coroutines
+ *
+ * @note The instance must be initialized in non-blocking mode and be out of
+ *       cyclic mode. Requests are served in order, one at a time.
+ */
+class Bus
+{
+public:
+    explicit Bus(Mcb_TInst& tMcb) noexcept : tInst(tMcb) {}
+
+    Bus(const Bus&) = delete;
+    Bus& operator=(const Bus&) = delete;
+
+    /**
+     * Reads a register of the instance node
+     *
+     * @param[in] u16Addr
+     *  Register address
+     */
+    Op read(uint16_t u16Addr) noexcept { return Op(*this, false, tInst.u16Node, u16Addr); }
+
+    /**
+     * Reads a register
+     *
+     * @param[in] u16Addr
+     *  Register address
+     * @param[in] u16Node
+     *  Target slave
+     */
+    Op read(uint16_t u16Addr, uint16_t u16Node) noexcept { return Op(*this, false, u16Node, u16Addr); }
+
+    /**
+     * Writes a register of the instance node
+     *
+     * @param[in] u16Addr
+     *  Register address
+     * @param[in] pu16Data
+     *  Data to be written, copied into the request
+     * @param[in] u16Size
+     *  Size to be written (words)
+     */
+    Op write(uint16_t u16Addr, const uint16_t* pu16Data, uint16_t u16Size) noexcept
+    {
+        return write(u16Addr, pu16Data, u16Size, tInst.u16Node);
+    }
+
+    /**
+     * Writes a register
+     *
+     * @param[in] u16Addr
+     *  Register address
+     * @param[in] pu16Data
+     *  Data to be written, copied into the request
+     * @param[in] u16Size
+     *  Size to be written (words), up to MCB_MAX_DATA_SZ
+     * @param[in] u16Node
+     *  Target slave
+     */
+    Op write(uint16_t u16Addr, const uint16_t* pu16Data, uint16_t u16Size, uint16_t u16Node) noexcept
+    {
+        return Op(*this, true, u16Node, u16Addr, pu16Data, u16Size);
+    }
+
+    /**
+     * Drives the request at the head of the queue, resuming its coroutine
+     * once it finishes
+     *
+     * @note To be called from the main loop, e.g. after every IRQ event.
+     *       A request not finished within the instance timeout fails.
+     *
+     * @retval true if there are requests pending, false otherwise
+     */
+    bool poll() noexcept
+    {
+        Op* ptOp = ptHead;
+
+        if (ptOp != nullptr)
+        {
+            if (ptOp->isStarted == false)
+            {
+                ptOp->isStarted = true;
+                ptOp->u32Millis = Mcb_GetMillis();
+            }
+
+            if (ptOp->isWrite != false)
+            {
+                tInst.Mcb_Write(&tInst, &ptOp->tMsg);
+            }
+            else
+            {
+                tInst.Mcb_Read(&tInst, &ptOp->tMsg);
+            }
+
+            if ((isFinished(ptOp->tMsg.eStatus) == false)
+                && ((Mcb_GetMillis() - ptOp->u32Millis) > tInst.u32Timeout))
+            {
+                Mcb_IntfReset(&tInst.tIntf);
+                ptOp->tMsg.eStatus = (ptOp->isWrite != false) ? MCB_WRITE_ERROR : MCB_READ_ERROR;
+            }
+
+            if (isFinished(ptOp->tMsg.eStatus) != false)
+            {
+                /** The request belongs to the coroutine frame, unlink it before resuming */
+                ptHead = ptOp->ptNext;
+                if (ptHead == nullptr)
+                {
+                    ptTail = nullptr;
+                }
+                szPending--;
+                ptOp->hCaller.resume();
+            }
+        }
+
+        return (ptHead != nullptr);
+    }
+
+    /** Number of requests awaited */
+    std::size_t pending() const noexcept { return szPending; }
+
+private:
+    friend class Op;
+
+    static bool isFinished(Mcb_EStatus eStatus) noexcept
+    {
+        return ((eStatus == MCB_WRITE_SUCCESS) || (eStatus == MCB_READ_SUCCESS)
+                || (eStatus == MCB_WRITE_ERROR) || (eStatus == MCB_READ_ERROR));
+    }
+
+    void enqueue(Op* ptOp) noexcept
+    {
+        if (ptTail != nullptr)
+        {
+            ptTail->ptNext = ptOp;
+        }
+        else
+        {
+            ptHead = ptOp;
+        }
+        ptTail = ptOp;
+        szPending++;
+    }
+
+    /** Wrapped instance */
+    Mcb_TInst& tInst;
+    /** Request on the bus */
+    Op* ptHead = nullptr;
+    /** Last queued request */
+    Op* ptTail = nullptr;
+    /** Number of queued requests */
+    std::size_t szPending = 0U;
+};
+
+inline void Op::await_suspend(std::coroutine_handle<> hCaller_) noexcept
+{
+    hCaller = hCaller_;
+    tBus.enqueue(this);
+}
+
+} /* namespace mcb */
+
+#endif /* MCB_CORO_HPP */
+
+/** @} */
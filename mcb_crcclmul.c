@@ -0,0 +1,167 @@
+/**
+ * @file mcb_crcclmul.c
+ * @brief This file contains a carry-less multiplication version of the
+ *        CRC-CCITT (XModem) for x86-64 (PCLMULQDQ) and ARMv8 (PMULL)
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "mcb_checksum.h"
+
+#ifdef CRC_CCITT_CLMUL
+
+#if defined(__x86_64__)
+#include <wmmintrin.h>
+#define CRC_CLMUL_TARGET    __attribute__((target("pclmul,sse2")))
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#define CRC_CLMUL_TARGET    __attribute__((target("+crypto")))
+#endif
+
+/*
+ * Folding constants, x^n mod CRC_POLY_CCITT, and the Barrett constant
+ * floor(x^80 / CRC_POLY_CCITT) without its x^64 term.
+ */
+
+#define CRC_CLMUL_K64       0xB861ull
+#define CRC_CLMUL_K96       0xD849ull
+#define CRC_CLMUL_K128      0xAEFCull
+#define CRC_CLMUL_K192      0x650Bull
+#define CRC_CLMUL_MU        0x11303471A041B343ull
+
+/** Words folded on every step, 128 bits */
+#define CRC_CLMUL_BLOCK     8
+
+/*
+ * static inline void clmul64( uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo );
+ *
+ * Carry-less multiplication of two 64 bit polynomials into a 128 bit result.
+ */
+
+CRC_CLMUL_TARGET static inline void clmul64( uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo ) {
+
+#if defined(__x86_64__)
+	__m128i r = _mm_clmulepi64_si128( _mm_cvtsi64_si128( (long long) a ), _mm_cvtsi64_si128( (long long) b ), 0x00 );
+
+	*lo = (uint64_t) _mm_cvtsi128_si64( r );
+	*hi = (uint64_t) _mm_cvtsi128_si64( _mm_unpackhi_epi64( r, r ) );
+#else
+	uint64x2_t r = vreinterpretq_u64_p128( vmull_p64( (poly64_t) a, (poly64_t) b ) );
+
+	*lo = vgetq_lane_u64( r, 0 );
+	*hi = vgetq_lane_u64( r, 1 );
+#endif
+
+}  /* clmul64 */
+
+/*
+ * static inline uint64_t load_words( const uint16_t *ptr );
+ *
+ * Returns four words as a 64 bit polynomial, the first word being the most
+ * significant one as it is the first one to be transmitted.
+ */
+
+static inline uint64_t load_words( const uint16_t *ptr ) {
+
+	return ( (uint64_t) ptr[0] << 48 ) | ( (uint64_t) ptr[1] << 32 ) | ( (uint64_t) ptr[2] << 16 ) | (uint64_t) ptr[3];
+
+}  /* load_words */
+
+/*
+ * uint16_t crc_ccitt_words_clmul( uint16_t crc, const uint16_t *input_words, size_t num_words );
+ *
+ * The function crc_ccitt_words_clmul() gives the same result as
+ * crc_ccitt_words() using carry-less multiplications. The leading words which
+ * do not fill a complete 128 bit block are processed with the lookup tables,
+ * then the remaining blocks are folded into a 128 bit remainder which is
+ * reduced to the 16 bit CRC with a Barrett reduction.
+ */
+
+CRC_CLMUL_TARGET uint16_t crc_ccitt_words_clmul( uint16_t crc, const uint16_t *input_words, size_t num_words ) {
+
+	const uint16_t *ptr;
+	size_t lead;
+	uint64_t hi;
+	uint64_t lo;
+	uint64_t h1;
+	uint64_t l1;
+	uint64_t h0;
+	uint64_t l0;
+
+	ptr = input_words;
+
+	if ( ptr == NULL ) return crc;
+
+	lead = num_words % CRC_CLMUL_BLOCK;
+	crc  = crc_ccitt_words( crc, ptr, lead );
+
+	ptr       += lead;
+	num_words -= lead;
+
+	if ( num_words == 0 ) return crc;
+
+	/* The current CRC is added to the first 16 bits of the message */
+
+	hi = load_words( &ptr[0] ) ^ ( (uint64_t) crc << 48 );
+	lo = load_words( &ptr[4] );
+
+	ptr       += CRC_CLMUL_BLOCK;
+	num_words -= CRC_CLMUL_BLOCK;
+
+	while ( num_words > 0 ) {
+
+		clmul64( hi, CRC_CLMUL_K192, &h1, &l1 );
+		clmul64( lo, CRC_CLMUL_K128, &h0, &l0 );
+
+		hi = h1 ^ h0 ^ load_words( &ptr[0] );
+		lo = l1 ^ l0 ^ load_words( &ptr[4] );
+
+		ptr       += CRC_CLMUL_BLOCK;
+		num_words -= CRC_CLMUL_BLOCK;
+	}
+
+	/* Fold the high half into a 64 bit remainder, products stay below 48 bits */
+
+	clmul64( hi >> 32,         CRC_CLMUL_K96, &h1, &l1 );
+	clmul64( hi & 0xFFFFFFFFu, CRC_CLMUL_K64, &h0, &l0 );
+	lo ^= l1 ^ l0;
+
+	/* Barrett reduction of lo * x^16 */
+
+	clmul64( lo, CRC_CLMUL_MU, &h1, &l1 );
+	h1 ^= lo;
+	clmul64( h1, CRC_POLY_CCITT, &h0, &l0 );
+
+	return (uint16_t) l0;
+
+}  /* crc_ccitt_words_clmul */
+
+/*
+ * bool crc_ccitt_clmul_available( void );
+ *
+ * The function crc_ccitt_clmul_available() returns true if the running CPU
+ * supports the carry-less multiplication used by crc_ccitt_words_clmul().
+ */
+
+bool crc_ccitt_clmul_available( void ) {
+
+#if defined(__x86_64__)
+	__builtin_cpu_init();
+
+	return ( __builtin_cpu_supports( "pclmul" ) != 0 );
+#elif defined(__linux__)
+	return ( ( getauxval( AT_HWCAP ) & HWCAP_PMULL ) != 0 );
+#else
+	return false;
+#endif
+
+}  /* crc_ccitt_clmul_available */
+
+#endif /* CRC_CCITT_CLMUL */
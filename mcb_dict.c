@@ -0,0 +1,360 @@
+/**
+ * @file mcb_dict.c
+ * @brief This file contains the persistent get info dictionary
+ *        of the motion control bus (MCB)
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_dict.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * Maps or reads a whole file into memory
+ *
+ * @param[in] szPath
+ *  File path
+ * @param[out] pszSz
+ *  File size
+ *
+ * @retval File contents, NULL on error
+ */
+static void*
+Mcb_DictMapFile(const char* szPath, size_t* pszSz);
+
+/**
+ * Releases a file returned by Mcb_DictMapFile
+ *
+ * @param[in] pMap
+ *  File contents
+ * @param[in] szSz
+ *  File size
+ */
+static void
+Mcb_DictUnmapFile(void* pMap, size_t szSz);
+
+int32_t Mcb_DictReadFwId(Mcb_TInst* ptInst, uint16_t u16Node, uint32_t* pu32FwId)
+{
+    int32_t i32Ret = MCB_DICT_OK;
+    Mcb_TMsg tMsg;
+
+    if ((ptInst->eMode != MCB_BLOCKING) || (ptInst->isCyclic != false))
+    {
+        i32Ret = MCB_DICT_ERR_STATE;
+    }
+    else
+    {
+        tMsg.u16Node = u16Node;
+        tMsg.u16Addr = MCB_DICT_ADDR_FW_VERSION;
+        ptInst->Mcb_Read(ptInst, &tMsg);
+
+        if ((tMsg.eStatus != MCB_READ_SUCCESS) || (tMsg.u16Size > MCB_MAX_DATA_SZ))
+        {
+            i32Ret = MCB_DICT_ERR_BUS;
+        }
+        else
+        {
+            *pu32FwId = ((uint32_t)tMsg.u16Size << 16U) | (uint32_t)Mcb_IntfComputeCrc(tMsg.u16Data, tMsg.u16Size);
+        }
+    }
+
+    return i32Ret;
+}
+
+int32_t Mcb_DictBuild(Mcb_TDict* ptDict, Mcb_TInst* ptInst, uint16_t u16Node, const uint16_t* pu16Addr,
+                      uint16_t u16Num, Mcb_TDictEntry* ptBuf)
+{
+    int32_t i32Ret;
+    Mcb_TInfoMsg tInfoMsg;
+    uint16_t u16Cnt = (uint16_t)0U;
+    uint16_t u16Pos;
+    uint32_t u32FwId = (uint32_t)0UL;
+
+    i32Ret = Mcb_DictReadFwId(ptInst, u16Node, &u32FwId);
+
+    for (uint16_t u16Idx = (uint16_t)0U; (i32Ret == MCB_DICT_OK) && (u16Idx < u16Num); u16Idx++)
+    {
+        /** Insertion point, keeping the entries sorted */
+        u16Pos = u16Cnt;
+        while ((u16Pos > (uint16_t)0U) && (ptBuf[u16Pos - 1U].u16Addr > pu16Addr[u16Idx]))
+        {
+            u16Pos--;
+        }
+
+        if ((u16Pos > (uint16_t)0U) && (ptBuf[u16Pos - 1U].u16Addr == pu16Addr[u16Idx]))
+        {
+            continue;
+        }
+
+        tInfoMsg.u16Node = u16Node;
+        tInfoMsg.u16Addr = pu16Addr[u16Idx];
+        ptInst->Mcb_GetInfo(ptInst, &tInfoMsg);
+
+        if (tInfoMsg.eStatus != MCB_GETINFO_SUCCESS)
+        {
+            i32Ret = MCB_DICT_ERR_BUS;
+            break;
+        }
+
+        memmove((void*)&ptBuf[u16Pos + 1U], (const void*)&ptBuf[u16Pos],
+                ((u16Cnt - u16Pos) * sizeof(Mcb_TDictEntry)));
+        ptBuf[u16Pos].u16Addr = pu16Addr[u16Idx];
+        ptBuf[u16Pos].u16Info[0] = tInfoMsg.tInfoMsgData.u16Data[0];
+        ptBuf[u16Pos].u16Info[1] = tInfoMsg.tInfoMsgData.u16Data[1];
+        u16Cnt++;
+    }
+
+    ptDict->ptEntry = ptBuf;
+    ptDict->u16Num = u16Cnt;
+    ptDict->u32FwId = u32FwId;
+    ptDict->pMap = NULL;
+    ptDict->szMap = (size_t)0U;
+
+    return i32Ret;
+}
+
+int32_t Mcb_DictSave(const Mcb_TDict* ptDict, const char* szPath)
+{
+    int32_t i32Ret = MCB_DICT_OK;
+    Mcb_TDictHeader tHeader;
+    FILE* ptFile;
+
+    tHeader.u32Magic = MCB_DICT_MAGIC;
+    tHeader.u16Version = MCB_DICT_VERSION;
+    tHeader.u16Num = ptDict->u16Num;
+    tHeader.u32FwId = ptDict->u32FwId;
+    tHeader.u16Crc = Mcb_IntfComputeCrc((const uint16_t*)ptDict->ptEntry,
+                                        (uint16_t)((ptDict->u16Num * sizeof(Mcb_TDictEntry)) / sizeof(uint16_t)));
+    tHeader.u16Reserved = (uint16_t)0U;
+
+    ptFile = fopen(szPath, "wb");
+    if (ptFile == NULL)
+    {
+        i32Ret = MCB_DICT_ERR_IO;
+    }
+    else
+    {
+        if ((fwrite(&tHeader, sizeof(tHeader), 1U, ptFile) != 1U)
+            || (fwrite(ptDict->ptEntry, sizeof(Mcb_TDictEntry), ptDict->u16Num, ptFile) != ptDict->u16Num))
+        {
+            i32Ret = MCB_DICT_ERR_IO;
+        }
+
+        if (fclose(ptFile) != 0)
+        {
+            i32Ret = MCB_DICT_ERR_IO;
+        }
+    }
+
+    return i32Ret;
+}
+
+int32_t Mcb_DictLoad(Mcb_TDict* ptDict, const char* szPath, Mcb_TInst* ptInst, uint16_t u16Node)
+{
+    int32_t i32Ret;
+    const Mcb_TDictHeader* ptHeader;
+    const Mcb_TDictEntry* ptEntry;
+    size_t szSz = (size_t)0U;
+    void* pMap = NULL;
+    uint32_t u32FwId = (uint32_t)0UL;
+
+    ptDict->ptEntry = NULL;
+    ptDict->u16Num = (uint16_t)0U;
+    ptDict->pMap = NULL;
+    ptDict->szMap = (size_t)0U;
+
+    i32Ret = Mcb_DictReadFwId(ptInst, u16Node, &u32FwId);
+    ptDict->u32FwId = u32FwId;
+
+    do
+    {
+        if (i32Ret != MCB_DICT_OK)
+        {
+            break;
+        }
+
+        pMap = Mcb_DictMapFile(szPath, &szSz);
+        if (pMap == NULL)
+        {
+            i32Ret = MCB_DICT_ERR_IO;
+            break;
+        }
+
+        ptHeader = (const Mcb_TDictHeader*)pMap;
+        ptEntry = (const Mcb_TDictEntry*)(const void*)(ptHeader + 1);
+
+        if ((szSz < sizeof(Mcb_TDictHeader)) || (ptHeader->u32Magic != MCB_DICT_MAGIC)
+            || (ptHeader->u16Version != MCB_DICT_VERSION)
+            || (szSz != (sizeof(Mcb_TDictHeader) + (ptHeader->u16Num * sizeof(Mcb_TDictEntry)))))
+        {
+            i32Ret = MCB_DICT_ERR_FORMAT;
+            break;
+        }
+
+        if (ptHeader->u32FwId != u32FwId)
+        {
+            i32Ret = MCB_DICT_ERR_FW;
+            break;
+        }
+
+        if (ptHeader->u16Crc != Mcb_IntfComputeCrc((const uint16_t*)(const void*)ptEntry,
+                (uint16_t)((ptHeader->u16Num * sizeof(Mcb_TDictEntry)) / sizeof(uint16_t))))
+        {
+            i32Ret = MCB_DICT_ERR_FORMAT;
+            break;
+        }
+
+        ptDict->ptEntry = ptEntry;
+        ptDict->u16Num = ptHeader->u16Num;
+        ptDict->pMap = pMap;
+        ptDict->szMap = szSz;
+    } while (false);
+
+    if ((i32Ret != MCB_DICT_OK) && (pMap != NULL))
+    {
+        Mcb_DictUnmapFile(pMap, szSz);
+    }
+
+    return i32Ret;
+}
+
+void Mcb_DictClose(Mcb_TDict* ptDict)
+{
+    if (ptDict->pMap != NULL)
+    {
+        Mcb_DictUnmapFile(ptDict->pMap, ptDict->szMap);
+    }
+
+    ptDict->ptEntry = NULL;
+    ptDict->u16Num = (uint16_t)0U;
+    ptDict->pMap = NULL;
+    ptDict->szMap = (size_t)0U;
+}
+
+bool Mcb_DictLookup(const Mcb_TDict* ptDict, uint16_t u16Addr, Mcb_TInfoData* ptInfo)
+{
+    bool isFound = false;
+    uint16_t u16Low = (uint16_t)0U;
+    uint16_t u16High = ptDict->u16Num;
+    uint16_t u16Mid;
+
+    while (u16Low < u16High)
+    {
+        u16Mid = (uint16_t)(u16Low + ((u16High - u16Low) >> 1U));
+
+        if (ptDict->ptEntry[u16Mid].u16Addr < u16Addr)
+        {
+            u16Low = (uint16_t)(u16Mid + 1U);
+        }
+        else if (ptDict->ptEntry[u16Mid].u16Addr > u16Addr)
+        {
+            u16High = u16Mid;
+        }
+        else
+        {
+            memcpy((void*)ptInfo, (const void*)ptDict->ptEntry[u16Mid].u16Info,
+                   sizeof(ptDict->ptEntry[u16Mid].u16Info));
+            isFound = true;
+            break;
+        }
+    }
+
+    return isFound;
+}
+
+void Mcb_DictGetInfo(const Mcb_TDict* ptDict, Mcb_TInst* ptInst, Mcb_TInfoMsg* pMcbInfoMsg)
+{
+    if (Mcb_DictLookup(ptDict, pMcbInfoMsg->u16Addr, &pMcbInfoMsg->tInfoMsgData.tInfoData) != false)
+    {
+        pMcbInfoMsg->u16Cmd = MCB_REP_ACK;
+        pMcbInfoMsg->u16Size = (uint16_t)2U;
+        pMcbInfoMsg->eStatus = MCB_GETINFO_SUCCESS;
+    }
+    else
+    {
+        ptInst->Mcb_GetInfo(ptInst, pMcbInfoMsg);
+    }
+}
+
+#ifdef __unix__
+
+static void* Mcb_DictMapFile(const char* szPath, size_t* pszSz)
+{
+    void* pMap = NULL;
+    struct stat tStat;
+    int iFd;
+
+    iFd = open(szPath, O_RDONLY);
+    if (iFd >= 0)
+    {
+        if ((fstat(iFd, &tStat) == 0) && (tStat.st_size > 0))
+        {
+            pMap = mmap(NULL, (size_t)tStat.st_size, PROT_READ, MAP_PRIVATE, iFd, 0);
+            if (pMap == MAP_FAILED)
+            {
+                pMap = NULL;
+            }
+            else
+            {
+                *pszSz = (size_t)tStat.st_size;
+            }
+        }
+
+        /** The mapping stays valid once the descriptor is closed */
+        (void)close(iFd);
+    }
+
+    return pMap;
+}
+
+static void Mcb_DictUnmapFile(void* pMap, size_t szSz)
+{
+    (void)munmap(pMap, szSz);
+}
+
+#else
+
+static void* Mcb_DictMapFile(const char* szPath, size_t* pszSz)
+{
+    void* pMap = NULL;
+    FILE* ptFile;
+    long lSz;
+
+    ptFile = fopen(szPath, "rb");
+    if (ptFile != NULL)
+    {
+        if ((fseek(ptFile, 0L, SEEK_END) == 0) && ((lSz = ftell(ptFile)) > 0L)
+            && (fseek(ptFile, 0L, SEEK_SET) == 0))
+        {
+            pMap = malloc((size_t)lSz);
+            if ((pMap != NULL) && (fread(pMap, 1U, (size_t)lSz, ptFile) != (size_t)lSz))
+            {
+                free(pMap);
+                pMap = NULL;
+            }
+            *pszSz = (size_t)lSz;
+        }
+
+        (void)fclose(ptFile);
+    }
+
+    return pMap;
+}
+
+static void Mcb_DictUnmapFile(void* pMap, size_t szSz)
+{
+    (void)szSz;
+    free(pMap);
+}
+
+#endif /* __unix__ */
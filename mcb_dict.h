@@ -0,0 +1,227 @@
+/**
+ * @file mcb_dict.h
+ * @brief This file contains API for the persistent get info dictionary
+ *        of the motion control bus (MCB)
+ *
+ * The dictionary is a sorted index of the get info replies of a drive,
+ * keyed by register address. It is saved to a binary file and memory
+ * mapped on the next start, so register info lookups do not use the bus
+ * while the firmware identity of the drive does not change.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+ /**
+ * \addtogroup DictAPI Dictionary API
+ *
+ * @{
+ *
+ *  Host side cache of the register info of a drive
+ */
+
+#ifndef MCB_DICT_H
+#define MCB_DICT_H
+
+#include "mcb.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Dictionary file magic, "MCBD" */
+#define MCB_DICT_MAGIC (uint32_t)0x4442434DUL
+
+/** Dictionary file format version */
+#define MCB_DICT_VERSION (uint16_t)1U
+
+/** Dictionary operation success */
+#define MCB_DICT_OK (int32_t)0L
+/** The file cannot be opened, read or written */
+#define MCB_DICT_ERR_IO (int32_t)-1L
+/** The file is not a dictionary, or its version or checksum do not match */
+#define MCB_DICT_ERR_FORMAT (int32_t)-2L
+/** The dictionary belongs to another firmware */
+#define MCB_DICT_ERR_FW (int32_t)-3L
+/** A get info request failed while building the dictionary */
+#define MCB_DICT_ERR_BUS (int32_t)-4L
+/** The instance is not in blocking mode or it is in cyclic mode */
+#define MCB_DICT_ERR_STATE (int32_t)-5L
+
+/** Firmware version register of the drive, its value identifies the firmware */
+#ifndef MCB_DICT_ADDR_FW_VERSION
+#define MCB_DICT_ADDR_FW_VERSION (uint16_t)0x6E4U
+#endif
+
+/** Dictionary file header */
+typedef struct
+{
+    /** File magic, MCB_DICT_MAGIC */
+    uint32_t u32Magic;
+    /** File format version, MCB_DICT_VERSION */
+    uint16_t u16Version;
+    /** Number of entries */
+    uint16_t u16Num;
+    /** Firmware identity of the drive */
+    uint32_t u32FwId;
+    /** CRC of the entries */
+    uint16_t u16Crc;
+    /** Reserved, must be 0 */
+    uint16_t u16Reserved;
+} Mcb_TDictHeader;
+
+/** Dictionary entry */
+typedef struct
+{
+    /** Register address */
+    uint16_t u16Addr;
+    /** Get info reply, as received from the drive */
+    uint16_t u16Info[2];
+} Mcb_TDictEntry;
+
+/** Dictionary instance */
+typedef struct
+{
+    /** Entries sorted by address */
+    const Mcb_TDictEntry* ptEntry;
+    /** Number of entries */
+    uint16_t u16Num;
+    /** Firmware identity of the drive */
+    uint32_t u32FwId;
+    /** Mapped file, NULL if the entries are owned by the user */
+    void* pMap;
+    /** Size of the mapped file */
+    size_t szMap;
+} Mcb_TDict;
+
+/**
+ * Reads the firmware identity of a drive
+ *
+ * @note The identity is the CRC of the firmware version register value,
+ *       MCB_DICT_ADDR_FW_VERSION, along with its size in the upper half.
+ *       The instance must be in blocking mode and out of cyclic mode.
+ *
+ * @param[in] ptInst
+ *  Instance used to read the firmware version
+ * @param[in] u16Node
+ *  Target slave
+ * @param[out] pu32FwId
+ *  Firmware identity of the drive
+ *
+ * @retval MCB_DICT_OK on success, MCB_DICT_ERR_STATE if the instance is not
+ *         in blocking mode or it is in cyclic mode, MCB_DICT_ERR_BUS if the
+ *         register cannot be read
+ */
+int32_t
+Mcb_DictReadFwId(Mcb_TInst* ptInst, uint16_t u16Node, uint32_t* pu32FwId);
+
+/**
+ * Builds a dictionary requesting the info of a list of registers
+ *
+ * @note The instance must be in blocking mode and out of cyclic mode.
+ *       Duplicated addresses are stored once. The firmware identity is
+ *       read from the drive, see @ref Mcb_DictReadFwId.
+ *
+ * @param[out] ptDict
+ *  Dictionary to be built
+ * @param[in] ptInst
+ *  Instance used to request the register info
+ * @param[in] u16Node
+ *  Target slave
+ * @param[in] pu16Addr
+ *  Register addresses
+ * @param[in] u16Num
+ *  Number of register addresses
+ * @param[out] ptBuf
+ *  Entries storage, at least u16Num entries. Owned by the user
+ *
+ * @retval MCB_DICT_OK if all the info has been received,
+ *         MCB_DICT_ERR_STATE if the instance is not in blocking mode or it
+ *         is in cyclic mode, MCB_DICT_ERR_BUS otherwise
+ */
+int32_t
+Mcb_DictBuild(Mcb_TDict* ptDict, Mcb_TInst* ptInst, uint16_t u16Node, const uint16_t* pu16Addr,
+              uint16_t u16Num, Mcb_TDictEntry* ptBuf);
+
+/**
+ * Saves a dictionary into a binary file
+ *
+ * @note The file is stored in host byte order.
+ *
+ * @param[in] ptDict
+ *  Dictionary to be saved
+ * @param[in] szPath
+ *  File path
+ *
+ * @retval MCB_DICT_OK on success, MCB_DICT_ERR_IO otherwise
+ */
+int32_t
+Mcb_DictSave(const Mcb_TDict* ptDict, const char* szPath);
+
+/**
+ * Loads a dictionary, memory mapping its binary file
+ *
+ * @note The firmware identity of the drive is read through the instance,
+ *       which must be in blocking mode and out of cyclic mode.
+ *
+ * @param[out] ptDict
+ *  Loaded dictionary
+ * @param[in] szPath
+ *  File path
+ * @param[in] ptInst
+ *  Instance used to read the firmware identity
+ * @param[in] u16Node
+ *  Target slave
+ *
+ * @retval MCB_DICT_OK on success, MCB_DICT_ERR_FW if the file belongs
+ *         to another firmware, other error codes otherwise
+ */
+int32_t
+Mcb_DictLoad(Mcb_TDict* ptDict, const char* szPath, Mcb_TInst* ptInst, uint16_t u16Node);
+
+/**
+ * Releases a dictionary
+ *
+ * @param[in] ptDict
+ *  Dictionary to be released
+ */
+void
+Mcb_DictClose(Mcb_TDict* ptDict);
+
+/**
+ * Looks up the info of a register
+ *
+ * @param[in] ptDict
+ *  Target dictionary
+ * @param[in] u16Addr
+ *  Register address
+ * @param[out] ptInfo
+ *  Register info
+ *
+ * @retval true if the register is in the dictionary, false otherwise
+ */
+bool
+Mcb_DictLookup(const Mcb_TDict* ptDict, uint16_t u16Addr, Mcb_TInfoData* ptInfo);
+
+/**
+ * Gets the info of a register, from the dictionary if possible or from the
+ * drive otherwise
+ *
+ * @param[in] ptDict
+ *  Target dictionary
+ * @param[in] ptInst
+ *  Instance used if the register is not in the dictionary
+ * @param[in, out] pMcbInfoMsg
+ *  Request to be filled with the register info
+ */
+void
+Mcb_DictGetInfo(const Mcb_TDict* ptDict, Mcb_TInst* ptInst, Mcb_TInfoMsg* pMcbInfoMsg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCB_DICT_H */
+
+/** @} */
@@ -12,8 +12,8 @@
 
 /** Frame description
  * Word 0       - Header
- * Word 1..4    - Config data
- * Word 5..N-1  - Cyclic  data (optional)
+ * Word 1..C    - Config data, C is the config size (4 words by default)
+ * Word C+1..N-1 - Cyclic  data (optional)
  * Word N       - CRC
  */
 
@@ -55,14 +55,14 @@ int32_t Mcb_FrameCreateConfig(Mcb_TFrame* tFrame, uint16_t u16Addr, uint8_t u8Cm
         /* Copy config & cyclic buffer (if any) */
         if (pCfgBuf != NULL)
         {
-            memcpy(&tFrame->u16Buf[MCB_FRM_CONFIG_IDX], pCfgBuf, (sizeof(tFrame->u16Buf[0]) * MCB_FRM_CONFIG_SZ));
+            memcpy(&tFrame->u16Buf[MCB_FRM_CONFIG_IDX], pCfgBuf, (sizeof(tFrame->u16Buf[0]) * tFrame->u16CfgSz));
         }
         else
         {
-            memset(&tFrame->u16Buf[MCB_FRM_CONFIG_IDX], 0, (sizeof(tFrame->u16Buf[0]) * MCB_FRM_CONFIG_SZ));
+            memset(&tFrame->u16Buf[MCB_FRM_CONFIG_IDX], 0, (sizeof(tFrame->u16Buf[0]) * tFrame->u16CfgSz));
         }
 
-        tFrame->u16Sz = MCB_FRM_HEAD_SZ + MCB_FRM_CONFIG_SZ;
+        tFrame->u16Sz = MCB_FRM_HEAD_SZ + tFrame->u16CfgSz;
 
         if (bCalcCrc != false)
         {
@@ -95,14 +95,18 @@ int32_t Mcb_FrameAppendCyclic(Mcb_TFrame* tFrame, const void* pCyclicBuf, uint16
             break;
         }
 
-        /* Copy config & cyclic buffer (if any) */
-        if (pCyclicBuf != NULL)
+        /* Copy config & cyclic buffer (if any), zero-copy buffers are already in place */
+        if (pCyclicBuf == (const void*)&tFrame->u16Buf[MCB_FRM_CYCLIC_POS(tFrame->u16CfgSz)])
+        {
+            /* Nothing */
+        }
+        else if (pCyclicBuf != NULL)
         {
-            memcpy(&tFrame->u16Buf[MCB_FRM_CYCLIC_IDX], pCyclicBuf, (sizeof(tFrame->u16Buf[0]) * u16SzCyclic));
+            memcpy(&tFrame->u16Buf[MCB_FRM_CYCLIC_POS(tFrame->u16CfgSz)], pCyclicBuf, (sizeof(tFrame->u16Buf[0]) * u16SzCyclic));
         }
         else
         {
-            memset(&tFrame->u16Buf[MCB_FRM_CYCLIC_IDX], 0, (sizeof(tFrame->u16Buf[0]) * u16SzCyclic));
+            memset(&tFrame->u16Buf[MCB_FRM_CYCLIC_POS(tFrame->u16CfgSz)], 0, (sizeof(tFrame->u16Buf[0]) * u16SzCyclic));
         }
 
         tFrame->u16Sz += u16SzCyclic;
@@ -119,6 +123,22 @@ int32_t Mcb_FrameAppendCyclic(Mcb_TFrame* tFrame, const void* pCyclicBuf, uint16
     return i32Err;
 }
 
+int32_t Mcb_FrameAppendCyclicCrc(Mcb_TFrame* tFrame, const void* pCyclicBuf, uint16_t u16SzCyclic,
+        uint16_t u16CrcState)
+{
+    int32_t i32Err = Mcb_FrameAppendCyclic(tFrame, pCyclicBuf, u16SzCyclic, false);
+
+    if (i32Err == 0)
+    {
+        /* Only the cyclic words are added to the cached CRC state */
+        u16CrcState = Mcb_IntfCrcUpdate(u16CrcState, &tFrame->u16Buf[MCB_FRM_CYCLIC_POS(tFrame->u16CfgSz)], u16SzCyclic);
+        tFrame->u16Buf[tFrame->u16Sz] = Mcb_IntfCrcFinal(u16CrcState);
+        tFrame->u16Sz += MCB_FRM_CRC_SZ;
+    }
+
+    return i32Err;
+}
+
 bool Mcb_FrameGetSegmented(const Mcb_TFrame* tFrame)
 {
     THeader tHeader;
@@ -148,14 +168,18 @@ uint8_t Mcb_FrameGetCmd(const Mcb_TFrame* tFrame)
 
 uint16_t Mcb_FrameGetConfigData(const Mcb_TFrame* tFrame, uint16_t* pu16Buf)
 {
-    memcpy(pu16Buf, &tFrame->u16Buf[MCB_FRM_CONFIG_IDX], (sizeof(tFrame->u16Buf[0]) * MCB_FRM_CONFIG_SZ));
+    memcpy(pu16Buf, &tFrame->u16Buf[MCB_FRM_CONFIG_IDX], (sizeof(tFrame->u16Buf[0]) * tFrame->u16CfgSz));
 
-    return MCB_FRM_CONFIG_SZ;
+    return tFrame->u16CfgSz;
 }
 
 uint16_t Mcb_FrameGetCyclicData(const Mcb_TFrame* tFrame, uint16_t* pu16Buf, uint16_t u16Size)
 {
-    memcpy(pu16Buf, &tFrame->u16Buf[MCB_FRM_CYCLIC_IDX], (sizeof(tFrame->u16Buf[0]) * u16Size));
+    /* Zero-copy buffers are already in place */
+    if (pu16Buf != &tFrame->u16Buf[MCB_FRM_CYCLIC_POS(tFrame->u16CfgSz)])
+    {
+        memcpy(pu16Buf, &tFrame->u16Buf[MCB_FRM_CYCLIC_POS(tFrame->u16CfgSz)], (sizeof(tFrame->u16Buf[0]) * u16Size));
+    }
 
-    return MCB_FRM_CONFIG_SZ;
+    return tFrame->u16CfgSz;
 }
@@ -19,13 +19,25 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** Maximum data size of the buffers */
 #define MCB_MAX_DATA_SZ 128
 
 /** Motion control frame config buffer header size (words) */
 #define MCB_FRM_HEAD_SZ         1U
-/** Motion control frame config buffer size (words)*/
+/** Motion control frame default config buffer size (words)*/
 #define MCB_FRM_CONFIG_SZ       4U
+/**
+ * Motion control frame maximum config buffer size (words), it must be a power
+ * of two. Applications using wider config sizes through Mcb_SetConfigSize
+ * define it, i.e. as 32, at the cost of larger frame buffers.
+ */
+#ifndef MCB_FRM_MAX_CONFIG_SZ
+#define MCB_FRM_MAX_CONFIG_SZ   MCB_FRM_CONFIG_SZ
+#endif
 /** Motion control frame CRC size (words)*/
 #define MCB_FRM_CRC_SZ          1U
 /** Motion control frame MAX cyclic size (words)*/
@@ -35,8 +47,21 @@
 #define MCB_FRM_HEAD_IDX        0U
 /** Configuration position on raw buffer */
 #define MCB_FRM_CONFIG_IDX      1U
-/** Cyclic position on raw buffer */
+/** Cyclic position on raw buffer with the default config size */
 #define MCB_FRM_CYCLIC_IDX      5U
+/** Cyclic position on raw buffer for a given config size */
+#define MCB_FRM_CYCLIC_POS(u16CfgSz) (MCB_FRM_CONFIG_IDX + (u16CfgSz))
+
+/** Motion control frame MAX size (words), frame buffers are sized to it */
+#define MCB_FRM_MAX_SZ          (MCB_FRM_HEAD_SZ + MCB_FRM_MAX_CONFIG_SZ + MCB_FRM_MAX_CYCLIC_SZ + MCB_FRM_CRC_SZ)
+
+#if (MCB_FRM_MAX_CONFIG_SZ < MCB_FRM_CONFIG_SZ)
+#error "MCB_FRM_MAX_CONFIG_SZ is smaller than the default config size"
+#endif
+
+#if (MCB_FRM_MAX_CONFIG_SZ > MCB_MAX_DATA_SZ)
+#error "MCB_FRM_MAX_CONFIG_SZ does not fit in the message buffers"
+#endif
 
 /** Ingenia protocol config function requests/replies */
 /** Read request */
@@ -83,6 +108,13 @@
 /** Get info int16 type */
 #define STRING_TYPE         (uint16_t)5U
 
+/** Get info read / write access */
+#define RW_ACCESS           (uint8_t)0U
+/** Get info read only access */
+#define RO_ACCESS           (uint8_t)1U
+/** Get info write only access */
+#define WO_ACCESS           (uint8_t)2U
+
 /** Get info struct */
 typedef struct Mcb_TInfoData
 {
@@ -107,15 +139,20 @@ typedef union Mcb_TInfoMsgData
 
 /** High speed Ingenia protocol frame */
 typedef struct {
-	/** Data buffer */
-	uint16_t u16Buf[MCB_MAX_DATA_SZ];
+	/** Data buffer, header + config + cyclic + CRC */
+	uint16_t u16Buf[MCB_FRM_MAX_SZ];
     /** Frame size */
 	uint16_t u16Sz;
+    /** Config data size (words) */
+    uint16_t u16CfgSz;
 } Mcb_TFrame;
 
 /**
  * Creates a configuration MCB frame.
  *
+ * @note The config data size is taken from the frame, u16CfgSz words are
+ *       copied from pCfgBuf.
+ *
  * @param [out] tFrame
  *      Destination frame
  * @param [in] u16Addr
@@ -146,7 +183,8 @@ Mcb_FrameCreateConfig(Mcb_TFrame* tFrame, uint16_t u16Addr, uint8_t u8Cmd,
  * @param [out] tFrame
  *      Destination frame
  * @param [in] pCyclicBuf
- *      Buffer with cyclic data.
+ *      Buffer with cyclic data. If it points to the cyclic area of the
+ *      frame itself, no copy is done.
  * @param [in] u16SzCyclic
  *      Size of the cyclic data.
  * @param [in] bCalcCrc
@@ -161,6 +199,28 @@ int32_t
 Mcb_FrameAppendCyclic(Mcb_TFrame* tFrame, const void* pCyclicBuf,
                       uint16_t u16SzCyclic, bool bCalcCrc);
 
+/**
+ * Add cyclic data into a pre-created config frame, resuming the CRC
+ * from the state of the words already present in the frame
+ *
+ * @note Mcb_FrameCreateConfig has to be used before this function
+ *       without computing the CRC
+ *
+ * @param [out] tFrame
+ *      Destination frame
+ * @param [in] pCyclicBuf
+ *      Buffer with cyclic data.
+ * @param [in] u16SzCyclic
+ *      Size of the cyclic data.
+ * @param [in] u16CrcState
+ *      CRC state (see @ref Mcb_IntfCrcUpdate) of the header and config words
+ *
+ * @retval 0 success, error code otherwise
+ */
+int32_t
+Mcb_FrameAppendCyclicCrc(Mcb_TFrame* tFrame, const void* pCyclicBuf,
+                         uint16_t u16SzCyclic, uint16_t u16CrcState);
+
 /**
  * Returns the address of the header.
  *
@@ -230,6 +290,10 @@ Mcb_FrameGetCyclicData(const Mcb_TFrame* tFrame, uint16_t* pu16Buf, uint16_t u16
 bool
 Mcb_FrameCheckCRC(const Mcb_TFrame* tFrame);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* MCB_FRAME_H */
 
 /** @} */
@@ -9,22 +9,83 @@
 
 #include "mcb_intf.h"
 #include <stddef.h>
+#include <string.h>
 
 #define DFLT_TIMEOUT  100
 #define SIZE_WORDS    2
 
+/** Pipelined transaction slot holding no request */
+#define MCB_PIPE_NONE (uint16_t)0xFFFFU
+
+/**
+ * Execute a Spi transfer of the assembled frame pair
+ *
+ * @note The pair is owned by the transfer until the next IRQ event, the
+ *       following frame is assembled on the other pair meanwhile.
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] u16Node
+ *  Target node
+ */
+static void
+Mcb_IntfTransfer(Mcb_TIntf* ptInst, uint16_t u16Node);
+
+/**
+ * Hands over the reception frame of the last transfer to the protocol
+ *
+ * @param[in] ptInst
+ *  Target instance
+ */
+static void
+Mcb_IntfRxHandOver(Mcb_TIntf* ptInst);
+
+/**
+ * Takes the bus resource for a node, parking the transaction state of the
+ * active node and restoring the one of the requested node
+ *
+ * @note Nodes out of MCB_NUMBER_NODES share the state of the active node
+ * @note The reply received by a node that is still waiting for it is parked,
+ *       so it is not lost when another node is addressed meanwhile. A single
+ *       reply is parked at a time, while it is held the resource is not taken
+ *       for a third node until the active node has consumed its reply.
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] u16Node
+ *  Target node
+ *
+ * @retval true if the resource is taken for the node, false otherwise
+ */
+static bool
+Mcb_IntfTakeNode(Mcb_TIntf* ptInst, uint16_t u16Node);
+
+/**
+ * Gets the transaction state of a node
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] u16Node
+ *  Target node
+ * @param[in] eRangeError
+ *  State returned if the node is out of range
+ *
+ * @retval Transaction state of the node
+ */
+static Mcb_EStatus
+Mcb_IntfNodeState(const Mcb_TIntf* ptInst, uint16_t u16Node, Mcb_EStatus eRangeError);
+
 /**
- * Execute a Spi transfer
+ * Handles a lost or unexpected reply of a pipelined write
  *
  * @param[in] ptInst
  *  Target instance
- * @param[in] tInFrame
- *  Input frame
- * @param[out] tOutFrame
- *  Output frame
+ * @param[in] isReplay
+ *  If true, the sequence is replayed from the last acknowledged request,
+ *  otherwise it stops with MCB_WRITE_ERROR
  */
 static void
-Mcb_IntfTransfer(const Mcb_TIntf* ptInst, Mcb_TFrame* tInFrame, Mcb_TFrame* tOutFrame);
+Mcb_IntfPipeLost(Mcb_TIntf* ptInst, bool isReplay);
 
 /**
  * Process a write command
@@ -145,6 +206,58 @@ void Mcb_IntfInit(Mcb_TIntf* ptInst)
     ptInst->eState = MCB_STANDBY;
     Mcb_IntfInitResource(ptInst->u16Id);
     ptInst->isCfgOverCyclic = false;
+    ptInst->u16CfgOverCyclicCmd = MCB_REQ_IDLE;
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < MCB_NUMBER_NODES; u16Idx++)
+    {
+        ptInst->tNode[u16Idx].eState = MCB_STANDBY;
+        ptInst->tNode[u16Idx].u16Sz = (uint16_t)0U;
+        ptInst->tNode[u16Idx].isPending = false;
+    }
+    ptInst->u16ParkNode = MCB_NUMBER_NODES;
+    ptInst->u16ParkSz = (uint16_t)0U;
+    ptInst->u16Node = (uint16_t)0U;
+    ptInst->u16WireNode = (uint16_t)0U;
+    ptInst->u16RxNode = (uint16_t)0U;
+    ptInst->u16CyclicNode = (uint16_t)0U;
+
+    /** No transfer is on the wire, the next frame is assembled on the following pair */
+    ptInst->u8WireIdx = (uint8_t)0U;
+    ptInst->ptTxfrm = &(ptInst->tTxfrm[(uint8_t)1U % MCB_FRM_PAIRS]);
+    ptInst->ptRxfrm = &(ptInst->tRxfrm[(uint8_t)0U]);
+    ptInst->ptRxfrm->u16Sz = (uint16_t)0U;
+    ptInst->isPrepared = false;
+    Mcb_IntfSetCyclic(ptInst, false);
+
+    (void)Mcb_IntfSetConfigSize(ptInst, MCB_FRM_CONFIG_SZ);
+}
+
+bool Mcb_IntfSetConfigSize(Mcb_TIntf* ptInst, uint16_t u16CfgSz)
+{
+    bool isSet = false;
+
+    /** Power of two, so segments always tile the data buffers */
+    if ((u16CfgSz >= MCB_FRM_CONFIG_SZ) && (u16CfgSz <= MCB_FRM_MAX_CONFIG_SZ)
+        && ((u16CfgSz & (u16CfgSz - 1U)) == (uint16_t)0U))
+    {
+        ptInst->u16CfgSz = u16CfgSz;
+        for (uint8_t u8Idx = (uint8_t)0U; u8Idx < MCB_FRM_TX_NUM; u8Idx++)
+        {
+            ptInst->tTxfrm[u8Idx].u16CfgSz = u16CfgSz;
+        }
+        for (uint8_t u8Idx = (uint8_t)0U; u8Idx < MCB_FRM_PAIRS; u8Idx++)
+        {
+            ptInst->tRxfrm[u8Idx].u16CfgSz = u16CfgSz;
+        }
+        ptInst->isPrepared = false;
+
+        /** Header and config words of idle cyclic frames never change, cache their CRC */
+        Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, false);
+        ptInst->u16IdleCrc = Mcb_IntfCrcUpdate(Mcb_IntfCrcInit(), ptInst->ptTxfrm->u16Buf, ptInst->ptTxfrm->u16Sz);
+        isSet = true;
+    }
+
+    return isSet;
 }
 
 void Mcb_IntfDeinit(Mcb_TIntf* ptInst)
@@ -152,6 +265,7 @@ void Mcb_IntfDeinit(Mcb_TIntf* ptInst)
     ptInst->eState = MCB_STANDBY;
     Mcb_IntfDeinitResource(ptInst->u16Id);
     ptInst->isCfgOverCyclic = false;
+    ptInst->u16CfgOverCyclicCmd = MCB_REQ_IDLE;
 }
 
 void Mcb_IntfReset(Mcb_TIntf* ptInst)
@@ -167,9 +281,16 @@ Mcb_EStatus Mcb_IntfWrite(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr,
     bool isNewData = false;
 
     /** Check if data is already available (IRQ) & SPI is ready for transmission */
-    if ((Mcb_IntfIsReady(ptInst->u16Id) != false) && (Mcb_IntfTryTakeResource(ptInst->u16Id) != false))
+    if ((u16Node < MCB_NUMBER_NODES) && (Mcb_IntfIsReady(ptInst->u16Id) != false)
+        && (Mcb_IntfTakeNode(ptInst, u16Node) != false))
     {
-        if ((ptInst->eState == MCB_WRITE_ANSWER) && (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->tRxfrm.u16Buf, ptInst->tTxfrm.u16Sz) == false))
+        if ((ptInst->eState == MCB_WRITE_ANSWER) && (ptInst->u16RxNode != u16Node))
+        {
+            /** Last reply belongs to another node, clock out the one of this node */
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            isNewData = true;
+        }
+        else if ((ptInst->eState == MCB_WRITE_ANSWER) && (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->ptRxfrm->u16Buf, ptInst->ptRxfrm->u16Sz) == false))
         {
             ptInst->eState = MCB_WRITE_ERROR;
         }
@@ -181,14 +302,14 @@ Mcb_EStatus Mcb_IntfWrite(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr,
         /** Set up a new frame if an error is detected */
         if (ptInst->eState == MCB_WRITE_ERROR)
         {
-            Mcb_FrameCreateConfig(&(ptInst->tTxfrm), 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
             isNewData = true;
         }
 
         /** Use node to choose the chip select */
         if (isNewData != false)
         {
-            Mcb_IntfTransfer(ptInst, &(ptInst->tTxfrm), &(ptInst->tRxfrm));
+            Mcb_IntfTransfer(ptInst, u16Node);
         }
         else
         {
@@ -196,7 +317,7 @@ Mcb_EStatus Mcb_IntfWrite(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr,
         }
     }
 
-    return ptInst->eState;
+    return Mcb_IntfNodeState(ptInst, u16Node, MCB_WRITE_ERROR);
 }
 
 Mcb_EStatus Mcb_IntfRead(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu16Data, uint16_t* pu16Sz)
@@ -204,9 +325,16 @@ Mcb_EStatus Mcb_IntfRead(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr,
     bool isNewData = false;
 
     /** Check if data is already available (IRQ) & SPI is ready for transmission */
-    if ((Mcb_IntfIsReady(ptInst->u16Id) != false) && (Mcb_IntfTryTakeResource(ptInst->u16Id) != false))
+    if ((u16Node < MCB_NUMBER_NODES) && (Mcb_IntfIsReady(ptInst->u16Id) != false)
+        && (Mcb_IntfTakeNode(ptInst, u16Node) != false))
     {
-        if ((ptInst->eState == MCB_READ_ANSWER) && (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->tRxfrm.u16Buf, ptInst->tTxfrm.u16Sz) == false))
+        if ((ptInst->eState == MCB_READ_ANSWER) && (ptInst->u16RxNode != u16Node))
+        {
+            /** Last reply belongs to another node, clock out the one of this node */
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            isNewData = true;
+        }
+        else if ((ptInst->eState == MCB_READ_ANSWER) && (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->ptRxfrm->u16Buf, ptInst->ptRxfrm->u16Sz) == false))
         {
             ptInst->eState = MCB_READ_ERROR;
         }
@@ -218,14 +346,14 @@ Mcb_EStatus Mcb_IntfRead(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr,
         /** Set up a new frame if an error is detected */
         if (ptInst->eState == MCB_READ_ERROR)
         {
-            Mcb_FrameCreateConfig(&(ptInst->tTxfrm), 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
             isNewData = true;
         }
 
         /** Use node to choose the chip select */
         if (isNewData != false)
         {
-            Mcb_IntfTransfer(ptInst, &(ptInst->tTxfrm), &(ptInst->tRxfrm));
+            Mcb_IntfTransfer(ptInst, u16Node);
         }
         else
         {
@@ -233,7 +361,7 @@ Mcb_EStatus Mcb_IntfRead(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr,
         }
     }
 
-    return ptInst->eState;
+    return Mcb_IntfNodeState(ptInst, u16Node, MCB_READ_ERROR);
 }
 
 Mcb_EStatus Mcb_IntfGetInfo(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu16Data, uint16_t* pu16Sz)
@@ -241,9 +369,16 @@ Mcb_EStatus Mcb_IntfGetInfo(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Add
     bool isNewData = false;
 
     /** Check if data is already available (IRQ) & SPI is ready for transmission */
-    if ((Mcb_IntfIsReady(ptInst->u16Id) != false) && (Mcb_IntfTryTakeResource(ptInst->u16Id) != false))
+    if ((u16Node < MCB_NUMBER_NODES) && (Mcb_IntfIsReady(ptInst->u16Id) != false)
+        && (Mcb_IntfTakeNode(ptInst, u16Node) != false))
     {
-        if ((ptInst->eState == MCB_GETINFO_ANSWER) && (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->tRxfrm.u16Buf, ptInst->tTxfrm.u16Sz) == false))
+        if ((ptInst->eState == MCB_GETINFO_ANSWER) && (ptInst->u16RxNode != u16Node))
+        {
+            /** Last reply belongs to another node, clock out the one of this node */
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            isNewData = true;
+        }
+        else if ((ptInst->eState == MCB_GETINFO_ANSWER) && (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->ptRxfrm->u16Buf, ptInst->ptRxfrm->u16Sz) == false))
         {
             ptInst->eState = MCB_GETINFO_ERROR;
         }
@@ -255,14 +390,14 @@ Mcb_EStatus Mcb_IntfGetInfo(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Add
         /** Set up a new frame if an error is detected */
         if (ptInst->eState == MCB_GETINFO_ERROR)
         {
-            Mcb_FrameCreateConfig(&(ptInst->tTxfrm), 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
             isNewData = true;
         }
 
         /** Use node to choose the chip select */
         if (isNewData != false)
         {
-            Mcb_IntfTransfer(ptInst, &(ptInst->tTxfrm), &(ptInst->tRxfrm));
+            Mcb_IntfTransfer(ptInst, u16Node);
         }
         else
         {
@@ -270,34 +405,414 @@ Mcb_EStatus Mcb_IntfGetInfo(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Add
         }
     }
 
-    return ptInst->eState;
+    return Mcb_IntfNodeState(ptInst, u16Node, MCB_GETINFO_ERROR);
+}
+
+Mcb_EStatus Mcb_IntfWritePipe(Mcb_TIntf* ptInst, uint16_t u16Node, const Mcb_TIntfPipeReq* ptReq, uint16_t u16Num,
+                              bool isReplay, uint16_t* pu16Done)
+{
+    uint16_t u16CfgBuf[MCB_FRM_MAX_CONFIG_SZ] = {0U};
+    uint16_t u16Idx;
+
+    /** Check if data is already available (IRQ) & SPI is ready for transmission */
+    if ((u16Node < MCB_NUMBER_NODES) && (Mcb_IntfIsReady(ptInst->u16Id) != false)
+        && (Mcb_IntfTakeNode(ptInst, u16Node) != false))
+    {
+        if (ptInst->eState != MCB_WRITE_ANSWER)
+        {
+            ptInst->u16PipeTx = (uint16_t)0U;
+            ptInst->u16PipeAck = (uint16_t)0U;
+            ptInst->u16PipeWire[0] = MCB_PIPE_NONE;
+            ptInst->u16PipeWire[1] = MCB_PIPE_NONE;
+            ptInst->eState = MCB_WRITE_ANSWER;
+        }
+        else
+        {
+            /** The last reply answers the request sent one transfer before */
+            u16Idx = ptInst->u16PipeWire[1];
+
+            if (u16Idx == MCB_PIPE_NONE)
+            {
+                /** Nothing to check */
+            }
+            else if ((ptInst->u16RxNode != u16Node) ||
+                     (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->ptRxfrm->u16Buf, ptInst->ptRxfrm->u16Sz) == false) ||
+                     (Mcb_FrameGetAddr(ptInst->ptRxfrm) != ptReq[u16Idx].u16Addr))
+            {
+                /** Reply lost, replay from the last acknowledged request if allowed */
+                Mcb_IntfPipeLost(ptInst, isReplay);
+            }
+            else
+            {
+                switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
+                {
+                    case MCB_REP_ACK:
+                        /** Replies of replayed requests are acknowledged once */
+                        if (u16Idx == ptInst->u16PipeAck)
+                        {
+                            ptInst->u16PipeAck++;
+                        }
+                        break;
+                    case MCB_REP_WRITE_ERROR:
+                        /** Only the first request not acknowledged fails, later ones are replayed */
+                        if (u16Idx == ptInst->u16PipeAck)
+                        {
+                            ptInst->eState = MCB_WRITE_ERROR;
+                        }
+                        else
+                        {
+                            Mcb_IntfPipeLost(ptInst, isReplay);
+                        }
+                        break;
+                    default:
+                        Mcb_IntfPipeLost(ptInst, isReplay);
+                        break;
+                }
+            }
+        }
+
+        *pu16Done = ptInst->u16PipeAck;
+
+        if (ptInst->eState == MCB_WRITE_ERROR)
+        {
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            u16Idx = MCB_PIPE_NONE;
+        }
+        else if (ptInst->u16PipeAck >= u16Num)
+        {
+            ptInst->eState = MCB_WRITE_SUCCESS;
+        }
+        else if (ptInst->u16PipeTx < u16Num)
+        {
+            u16Idx = ptInst->u16PipeTx;
+            /** Requests hold the default config size, pad them up to the frame one */
+            memcpy((void*)u16CfgBuf, (const void*)ptReq[u16Idx].u16Data, sizeof(ptReq[u16Idx].u16Data));
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, ptReq[u16Idx].u16Addr, MCB_REQ_WRITE, MCB_FRM_NOTSEG,
+                                  u16CfgBuf, ptInst->bCalcCrc);
+            ptInst->u16PipeTx++;
+        }
+        else
+        {
+            /** Every request is on its way, clock out the pending replies */
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            u16Idx = MCB_PIPE_NONE;
+        }
+
+        if (ptInst->eState != MCB_WRITE_SUCCESS)
+        {
+            ptInst->u16PipeWire[1] = ptInst->u16PipeWire[0];
+            ptInst->u16PipeWire[0] = u16Idx;
+            Mcb_IntfTransfer(ptInst, u16Node);
+        }
+        else
+        {
+            Mcb_IntfReleaseResource(ptInst->u16Id);
+        }
+    }
+
+    return Mcb_IntfNodeState(ptInst, u16Node, MCB_WRITE_ERROR);
+}
+
+Mcb_EStatus Mcb_IntfReadPipe(Mcb_TIntf* ptInst, uint16_t u16Node, const uint16_t* pu16Addr, uint16_t* pu16Data,
+                             uint16_t u16Num, uint16_t* pu16Done)
+{
+    uint16_t u16Idx;
+
+    /** Check if data is already available (IRQ) & SPI is ready for transmission */
+    if ((u16Node < MCB_NUMBER_NODES) && (Mcb_IntfIsReady(ptInst->u16Id) != false)
+        && (Mcb_IntfTakeNode(ptInst, u16Node) != false))
+    {
+        if (ptInst->eState != MCB_READ_ANSWER)
+        {
+            ptInst->u16PipeTx = (uint16_t)0U;
+            ptInst->u16PipeAck = (uint16_t)0U;
+            ptInst->u16PipeWire[0] = MCB_PIPE_NONE;
+            ptInst->u16PipeWire[1] = MCB_PIPE_NONE;
+            ptInst->u16PipeDrain = MCB_PIPE_NONE;
+            ptInst->eState = MCB_READ_ANSWER;
+        }
+        else if (ptInst->u16PipeDrain != MCB_PIPE_NONE)
+        {
+            /** Requests sent meanwhile are dropped, idle frames are sent until the slave is done replying */
+            if ((ptInst->u16RxNode == u16Node) &&
+                (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->ptRxfrm->u16Buf, ptInst->ptRxfrm->u16Sz) != false) &&
+                (Mcb_FrameGetSegmented(ptInst->ptRxfrm) == false))
+            {
+                if (ptInst->u16PipeDrain == ptInst->u16PipeAck)
+                {
+                    ptInst->eState = MCB_READ_ERROR;
+                }
+                else
+                {
+                    ptInst->u16PipeTx = ptInst->u16PipeAck;
+                }
+                ptInst->u16PipeDrain = MCB_PIPE_NONE;
+            }
+        }
+        else
+        {
+            /** The last reply answers the request sent one transfer before */
+            u16Idx = ptInst->u16PipeWire[1];
+
+            if (u16Idx == MCB_PIPE_NONE)
+            {
+                /** Nothing to check */
+            }
+            else if ((ptInst->u16RxNode != u16Node) ||
+                     (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->ptRxfrm->u16Buf, ptInst->ptRxfrm->u16Sz) == false) ||
+                     (Mcb_FrameGetAddr(ptInst->ptRxfrm) != pu16Addr[u16Idx]))
+            {
+                /** Reply lost, replay from the last received register */
+                ptInst->u16PipeTx = ptInst->u16PipeAck;
+            }
+            else
+            {
+                switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
+                {
+                    case MCB_REP_ACK:
+                        if (Mcb_FrameGetSegmented(ptInst->ptRxfrm) != false)
+                        {
+                            /** Registers larger than a frame can not be pipelined, fail or replay once drained */
+                            ptInst->u16PipeDrain = u16Idx;
+                        }
+                        else if (u16Idx == ptInst->u16PipeAck)
+                        {
+                            /** Replies of replayed requests are stored once */
+                            (void)Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[u16Idx * ptInst->u16CfgSz]);
+                            ptInst->u16PipeAck++;
+                        }
+                        else
+                        {
+                            /** Nothing */
+                        }
+                        break;
+                    case MCB_REP_READ_ERROR:
+                        /** Only the first register not received fails, once the reply on the wire is drained */
+                        if (u16Idx == ptInst->u16PipeAck)
+                        {
+                            ptInst->u16PipeDrain = u16Idx;
+                        }
+                        else
+                        {
+                            ptInst->u16PipeTx = ptInst->u16PipeAck;
+                        }
+                        break;
+                    default:
+                        ptInst->u16PipeTx = ptInst->u16PipeAck;
+                        break;
+                }
+            }
+        }
+
+        *pu16Done = ptInst->u16PipeAck;
+
+        if (ptInst->u16PipeDrain != MCB_PIPE_NONE)
+        {
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            u16Idx = MCB_PIPE_NONE;
+        }
+        else if (ptInst->eState == MCB_READ_ERROR)
+        {
+            /** Nothing left on the wire */
+        }
+        else if (ptInst->u16PipeAck >= u16Num)
+        {
+            ptInst->eState = MCB_READ_SUCCESS;
+        }
+        else if (ptInst->u16PipeTx < u16Num)
+        {
+            /** The request of the next register collects the reply of the previous one */
+            u16Idx = ptInst->u16PipeTx;
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, pu16Addr[u16Idx], MCB_REQ_READ, MCB_FRM_NOTSEG,
+                                  NULL, ptInst->bCalcCrc);
+            ptInst->u16PipeTx++;
+        }
+        else
+        {
+            /** Every request is on its way, clock out the pending replies */
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+            u16Idx = MCB_PIPE_NONE;
+        }
+
+        if ((ptInst->eState != MCB_READ_SUCCESS) && (ptInst->eState != MCB_READ_ERROR))
+        {
+            ptInst->u16PipeWire[1] = ptInst->u16PipeWire[0];
+            ptInst->u16PipeWire[0] = u16Idx;
+            Mcb_IntfTransfer(ptInst, u16Node);
+        }
+        else
+        {
+            Mcb_IntfReleaseResource(ptInst->u16Id);
+        }
+    }
+
+    return Mcb_IntfNodeState(ptInst, u16Node, MCB_READ_ERROR);
 }
 
 void Mcb_IntfIRQEvent(Mcb_TIntf* ptInst)
 {
+    Mcb_IntfRxHandOver(ptInst);
     Mcb_IntfReleaseResource(ptInst->u16Id);
+    Mcb_IntfNotifyEvent(ptInst->u16Id);
 }
 
-void Mcb_IntfTransfer(const Mcb_TIntf* ptInst, Mcb_TFrame* ptInFrame, Mcb_TFrame* ptOutFrame)
+static void Mcb_IntfTransfer(Mcb_TIntf* ptInst, uint16_t u16Node)
 {
+    uint8_t u8Idx = (uint8_t)((ptInst->ptTxfrm - ptInst->tTxfrm) % MCB_FRM_PAIRS);
+    Mcb_TFrame* ptInFrame = ptInst->ptTxfrm;
+    Mcb_TFrame* ptOutFrame = &(ptInst->tRxfrm[u8Idx]);
+
+    /** The received frame has the same size than the transmitted one */
+    ptOutFrame->u16Sz = ptInFrame->u16Sz;
+    ptInst->u8WireIdx = u8Idx;
+    /** Any frame prepared in advance is either sent now or overwritten by this one */
+    ptInst->isPrepared = false;
+#ifndef MCB_CYCLIC_ZERO_COPY
+    ptInst->ptTxfrm = &(ptInst->tTxfrm[(u8Idx + (uint8_t)1U) % MCB_FRM_PAIRS]);
+#endif
+
+    ptInst->u16WireNode = u16Node;
+    Mcb_IntfSelectNode(ptInst->u16Id, u16Node);
     Mcb_IntfSPITransfer(ptInst->u16Id, ptInFrame->u16Buf, ptOutFrame->u16Buf, ptInFrame->u16Sz);
 }
 
+static void Mcb_IntfRxHandOver(Mcb_TIntf* ptInst)
+{
+    ptInst->ptRxfrm = &(ptInst->tRxfrm[ptInst->u8WireIdx]);
+    ptInst->u16RxNode = ptInst->u16WireNode;
+}
+
+static bool Mcb_IntfTakeNode(Mcb_TIntf* ptInst, uint16_t u16Node)
+{
+    bool isTaken = Mcb_IntfTryTakeResource(ptInst->u16Id);
+    Mcb_TIntfNode* ptPark;
+    Mcb_TIntfNode* ptRestore;
+    bool isParkRx;
+    bool isRestoreRx;
+    uint16_t u16Word;
+
+    if ((isTaken != false) && (u16Node != ptInst->u16Node) && (u16Node < MCB_NUMBER_NODES)
+        && (ptInst->u16Node < MCB_NUMBER_NODES))
+    {
+        ptPark = &(ptInst->tNode[ptInst->u16Node]);
+        ptRestore = &(ptInst->tNode[u16Node]);
+
+        /** Idle replies are not parked, the node is polled again for its reply */
+        isParkRx = (((ptInst->eState == MCB_WRITE_ANSWER) || (ptInst->eState == MCB_READ_ANSWER)
+                     || (ptInst->eState == MCB_GETINFO_ANSWER))
+                    && (ptInst->u16RxNode == ptInst->u16Node)
+                    && (Mcb_FrameGetCmd(ptInst->ptRxfrm) != MCB_REQ_IDLE)
+                    && (ptInst->ptRxfrm->u16Sz <= MCB_INTF_PARK_SZ));
+        isRestoreRx = (ptInst->u16ParkNode == u16Node);
+
+        if ((isParkRx != false) && (isRestoreRx == false) && (ptInst->u16ParkNode != MCB_NUMBER_NODES))
+        {
+            /** The parking holds the reply of another node, wait until the active node is done */
+            Mcb_IntfReleaseResource(ptInst->u16Id);
+            isTaken = false;
+        }
+        else
+        {
+            ptPark->eState = ptInst->eState;
+            ptPark->u16Sz = ptInst->u16Sz;
+            ptPark->isPending = ptInst->isPending;
+            ptInst->eState = ptRestore->eState;
+            ptInst->u16Sz = ptRestore->u16Sz;
+            ptInst->isPending = ptRestore->isPending;
+
+            if ((isParkRx != false) || (isRestoreRx != false))
+            {
+                /** Swap the reception frame and the parked reply */
+                for (uint16_t u16Idx = (uint16_t)0U; u16Idx < MCB_INTF_PARK_SZ; u16Idx++)
+                {
+                    u16Word = ptInst->u16ParkBuf[u16Idx];
+                    ptInst->u16ParkBuf[u16Idx] = ptInst->ptRxfrm->u16Buf[u16Idx];
+                    ptInst->ptRxfrm->u16Buf[u16Idx] = u16Word;
+                }
+                u16Word = ptInst->u16ParkSz;
+                ptInst->u16ParkSz = ptInst->ptRxfrm->u16Sz;
+                ptInst->ptRxfrm->u16Sz = u16Word;
+                ptInst->u16ParkNode = (isParkRx != false) ? ptInst->u16Node : MCB_NUMBER_NODES;
+                ptInst->u16RxNode = (isRestoreRx != false) ? u16Node : MCB_NUMBER_NODES;
+            }
+            ptInst->u16Node = u16Node;
+        }
+    }
+
+    return isTaken;
+}
+
+static Mcb_EStatus Mcb_IntfNodeState(const Mcb_TIntf* ptInst, uint16_t u16Node, Mcb_EStatus eRangeError)
+{
+    Mcb_EStatus eState = ptInst->eState;
+
+    if (u16Node >= MCB_NUMBER_NODES)
+    {
+        /** The node has no transaction state of its own, it is never addressed */
+        eState = eRangeError;
+    }
+    else if (u16Node != ptInst->u16Node)
+    {
+        eState = ptInst->tNode[u16Node].eState;
+    }
+    else
+    {
+        /** Nothing */
+    }
+
+    return eState;
+}
+
+static void Mcb_IntfPipeLost(Mcb_TIntf* ptInst, bool isReplay)
+{
+    if (isReplay != false)
+    {
+        ptInst->u16PipeTx = ptInst->u16PipeAck;
+    }
+    else
+    {
+        /** The request may have been applied, it cannot be sent again */
+        ptInst->eState = MCB_WRITE_ERROR;
+    }
+}
+
 Mcb_EStatus Mcb_IntfCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu16Cmd,
                                   uint16_t* pu16Data, uint16_t* pu16CfgSz, bool* pisNewData)
 {
     Mcb_EStatus eCyclicState = MCB_STANDBY;
-    static uint16_t u16CurrentCmd = MCB_REQ_IDLE;
 
     *pisNewData = false;
 
     if (ptInst->isCfgOverCyclic == false)
     {
-        if (ptInst->isNewCfgOverCyclic != false)
+        if ((ptInst->isNewCfgOverCyclic != false) && (u16Node != ptInst->u16CyclicNode))
+        {
+            /** Cyclic frames only reach the cyclic node, the request is rejected */
+            switch (*pu16Cmd)
+            {
+                case MCB_REQ_GETINFO:
+                    *pu16Cmd = MCB_REP_GETINFO_ERROR;
+                    eCyclicState = MCB_GETINFO_ERROR;
+                    break;
+                case MCB_REQ_READ:
+                    *pu16Cmd = MCB_REP_READ_ERROR;
+                    eCyclicState = MCB_READ_ERROR;
+                    break;
+                case MCB_REQ_WRITE:
+                    *pu16Cmd = MCB_REP_WRITE_ERROR;
+                    eCyclicState = MCB_WRITE_ERROR;
+                    break;
+                default:
+                    /** Nothing */
+                    break;
+            }
+            ptInst->isNewCfgOverCyclic = false;
+        }
+        else if (ptInst->isNewCfgOverCyclic != false)
         {
             /** If a config command is requested, add it into cyclic frame */
-            u16CurrentCmd = *pu16Cmd;
-            switch (u16CurrentCmd)
+            ptInst->u16CfgOverCyclicCmd = *pu16Cmd;
+            switch (ptInst->u16CfgOverCyclicCmd)
             {
                 case MCB_REQ_GETINFO:
                     /** Generate initial frame */
@@ -324,7 +839,7 @@ Mcb_EStatus Mcb_IntfCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t
     else
     {
         /** Keep on processing the config request */
-        switch (u16CurrentCmd)
+        switch (ptInst->u16CfgOverCyclicCmd)
         {
             case MCB_REQ_GETINFO:
                 *pisNewData = Mcb_IntfGetInfoCfgOverCyclic(ptInst, u16Addr, pu16Data, pu16CfgSz);
@@ -384,29 +899,90 @@ Mcb_EStatus Mcb_IntfCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t
     return eCyclicState;
 }
 
+void Mcb_IntfSetCyclic(Mcb_TIntf* ptInst, bool isCyclic)
+{
+    /** A frame prepared before the last stop is never sent */
+    ptInst->isPrepared = false;
+
+#ifdef MCB_CYCLIC_ZERO_COPY
+    /** The CRC of config frames must not overwrite the application setpoints */
+    ptInst->ptTxfrm = &(ptInst->tTxfrm[(isCyclic != false) ? (uint8_t)0U : (uint8_t)MCB_FRM_PAIRS]);
+#else
+    (void)isCyclic;
+#endif
+}
+
+bool Mcb_IntfCyclicPrepare(Mcb_TIntf* ptInst, uint16_t *ptInBuf, uint16_t u16CyclicSz)
+{
+    bool isPrepared = false;
+
+    /** A single pair is always owned by the transfer */
+    if (MCB_FRM_PAIRS > (uint8_t)1U)
+    {
+        Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, false);
+
+        if (ptInst->bCalcCrc != false)
+        {
+            Mcb_FrameAppendCyclicCrc(ptInst->ptTxfrm, ptInBuf, u16CyclicSz, ptInst->u16IdleCrc);
+        }
+        else
+        {
+            Mcb_FrameAppendCyclic(ptInst->ptTxfrm, ptInBuf, u16CyclicSz, false);
+        }
+
+        isPrepared = true;
+    }
+
+    ptInst->isPrepared = isPrepared;
+
+    return isPrepared;
+}
+
 void Mcb_IntfCyclicLatch(Mcb_TIntf* ptInst, uint16_t *ptInBuf, uint16_t u16CyclicSz, bool isNewCfgData)
 {
-    if (isNewCfgData == false)
+    if ((isNewCfgData == false) && (ptInst->isPrepared != false))
+    {
+        /** Idle frame already assembled while the previous one was on the wire */
+    }
+    else if (isNewCfgData == false)
     {
         /** The CRC can only be appended by the AppendCyclic() */
-        Mcb_FrameCreateConfig(&(ptInst->tTxfrm), 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, false);
-        Mcb_FrameAppendCyclic(&(ptInst->tTxfrm), ptInBuf, u16CyclicSz, ptInst->bCalcCrc);
+        Mcb_FrameCreateConfig(ptInst->ptTxfrm, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, false);
+
+        if (ptInst->bCalcCrc != false)
+        {
+            /** Resume the cached idle CRC, only cyclic words are computed */
+            Mcb_FrameAppendCyclicCrc(ptInst->ptTxfrm, ptInBuf, u16CyclicSz, ptInst->u16IdleCrc);
+        }
+        else
+        {
+            Mcb_FrameAppendCyclic(ptInst->ptTxfrm, ptInBuf, u16CyclicSz, false);
+        }
     }
     else
     {
-        Mcb_FrameAppendCyclic(&(ptInst->tTxfrm), ptInBuf, u16CyclicSz, ptInst->bCalcCrc);
+        Mcb_FrameAppendCyclic(ptInst->ptTxfrm, ptInBuf, u16CyclicSz, ptInst->bCalcCrc);
     }
 
-    Mcb_IntfTransfer(ptInst, &(ptInst->tTxfrm), &(ptInst->tRxfrm));
+    Mcb_IntfTransfer(ptInst, ptInst->u16CyclicNode);
 }
 
-void Mcb_IntfProcessCyclic(Mcb_TIntf* ptInst, uint16_t *ptOutBuf,  uint16_t u16CyclicSz)
+bool Mcb_IntfProcessCyclic(Mcb_TIntf* ptInst, uint16_t *ptOutBuf,  uint16_t u16CyclicSz)
 {
+    bool isCrcOk;
+
+    /** The frame is processed once received, even if the IRQ is still pending */
+    Mcb_IntfRxHandOver(ptInst);
+
+    isCrcOk = Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->ptRxfrm->u16Buf, ptInst->ptRxfrm->u16Sz);
+
     /** Get cyclic data from last transmission */
-    if (Mcb_IntfCheckCrc(ptInst->u16Id, ptInst->tRxfrm.u16Buf, ptInst->tTxfrm.u16Sz) != false)
+    if (isCrcOk != false)
     {
-        Mcb_FrameGetCyclicData(&ptInst->tRxfrm, ptOutBuf, u16CyclicSz);
+        Mcb_FrameGetCyclicData(ptInst->ptRxfrm, ptOutBuf, u16CyclicSz);
     }
+
+    return isCrcOk;
 }
 
 static bool Mcb_IntfWriteCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu16Data, uint16_t* pu16Sz)
@@ -425,20 +1001,20 @@ static bool Mcb_IntfWriteCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu16
     switch (ptInst->eState)
     {
         case MCB_WRITE_REQUEST:
-            if (ptInst->u16Sz > MCB_FRM_CONFIG_SZ)
+            if (ptInst->u16Sz > ptInst->u16CfgSz)
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_WRITE, MCB_FRM_SEG,
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_WRITE, MCB_FRM_SEG,
                         &pu16Data[*pu16Sz - ptInst->u16Sz], ptInst->bCalcCrc);
-                ptInst->u16Sz -= MCB_FRM_CONFIG_SZ;
+                ptInst->u16Sz -= ptInst->u16CfgSz;
             }
             else if (ptInst->u16Sz == 0)
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
                 ptInst->isPending = false;
             }
             else
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_WRITE, MCB_FRM_NOTSEG,
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_WRITE, MCB_FRM_NOTSEG,
                         &pu16Data[*pu16Sz - ptInst->u16Sz], ptInst->bCalcCrc);
                 ptInst->u16Sz = 0;
             }
@@ -448,13 +1024,13 @@ static bool Mcb_IntfWriteCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu16
             break;
         case MCB_WRITE_ANSWER:
             /** Check reception */
-            switch (Mcb_FrameGetCmd(&(ptInst->tRxfrm)))
+            switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
             {
                 case MCB_REP_ACK:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[(uint16_t)0U]);
+                    Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[(uint16_t)0U]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
                         if (ptInst->isPending != false)
                         {
@@ -472,9 +1048,9 @@ static bool Mcb_IntfWriteCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu16
                     break;
                 case MCB_REP_WRITE_ERROR:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[(uint16_t)0U]);
+                    Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[(uint16_t)0U]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
                         ptInst->eState = MCB_WRITE_ERROR;
                     }
@@ -518,13 +1094,13 @@ static bool Mcb_IntfReadCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu16D
             /* Send read request */
             if (ptInst->isPending != false)
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_READ, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_READ, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
                 /** Read is requested once, then IDLE are sent until the complete read is reached */
                 ptInst->isPending = false;
             }
             else
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
             }
 
             isNewData = true;
@@ -532,15 +1108,15 @@ static bool Mcb_IntfReadCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu16D
             break;
         case MCB_READ_ANSWER:
             /** Check reception */
-            switch (Mcb_FrameGetCmd(&(ptInst->tRxfrm)))
+            switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
             {
                 case MCB_REP_ACK:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        if (Mcb_FrameGetSegmented(&(ptInst->tRxfrm)) != false)
+                        if (Mcb_FrameGetSegmented(ptInst->ptRxfrm) != false)
                         {
                             ptInst->eState = MCB_READ_REQUEST;
                         }
@@ -557,11 +1133,11 @@ static bool Mcb_IntfReadCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu16D
                     break;
                 case MCB_REP_READ_ERROR:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        ptInst->u16Sz = MCB_FRM_CONFIG_SZ;
+                        ptInst->u16Sz = ptInst->u16CfgSz;
                         ptInst->eState = MCB_READ_ERROR;
                     }
                     else
@@ -604,13 +1180,13 @@ static bool Mcb_IntfGetInfoCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu
             /* Send getinfo request */
             if (ptInst->isPending != false)
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_GETINFO, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_GETINFO, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
                 /** Read is requested once, then IDLE are sent until the complete read is reached */
                 ptInst->isPending = false;
             }
             else
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, ptInst->bCalcCrc);
             }
 
             isNewData = true;
@@ -618,15 +1194,15 @@ static bool Mcb_IntfGetInfoCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu
             break;
         case MCB_GETINFO_ANSWER:
             /** Check reception */
-            switch (Mcb_FrameGetCmd(&(ptInst->tRxfrm)))
+            switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
             {
                 case MCB_REP_ACK:
                     /* Copy getinfo data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        if (Mcb_FrameGetSegmented(&(ptInst->tRxfrm)) != false)
+                        if (Mcb_FrameGetSegmented(ptInst->ptRxfrm) != false)
                         {
                             ptInst->eState = MCB_GETINFO_REQUEST;
                         }
@@ -643,11 +1219,11 @@ static bool Mcb_IntfGetInfoCfg(Mcb_TIntf* ptInst, uint16_t u16Addr, uint16_t* pu
                     break;
                 case MCB_REP_GETINFO_ERROR:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        ptInst->u16Sz = MCB_FRM_CONFIG_SZ;
+                        ptInst->u16Sz = ptInst->u16CfgSz;
                         ptInst->eState = MCB_GETINFO_ERROR;
                     }
                     else
@@ -686,15 +1262,15 @@ static bool Mcb_IntfWriteCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Addr, uint
     switch (ptInst->eState)
     {
         case MCB_WRITE_REQUEST:
-            if (ptInst->u16Sz > MCB_FRM_CONFIG_SZ)
+            if (ptInst->u16Sz > ptInst->u16CfgSz)
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_WRITE, MCB_FRM_SEG,
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_WRITE, MCB_FRM_SEG,
                         &pu16Data[*pu16Sz - ptInst->u16Sz], false);
-                ptInst->u16Sz -= MCB_FRM_CONFIG_SZ;
+                ptInst->u16Sz -= ptInst->u16CfgSz;
             }
             else
             {
-                Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_WRITE, MCB_FRM_NOTSEG,
+                Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_WRITE, MCB_FRM_NOTSEG,
                         &pu16Data[*pu16Sz - ptInst->u16Sz], false);
                 ptInst->u16Sz = 0;
             }
@@ -704,20 +1280,21 @@ static bool Mcb_IntfWriteCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Addr, uint
             break;
         case MCB_WRITE_ANSWER:
             /** Check reception */
-            switch (Mcb_FrameGetCmd(&(ptInst->tRxfrm)))
+            switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
             {
                 case MCB_REP_ACK:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[(uint16_t)0U]);
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[(uint16_t)0U]);
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        if (ptInst->isPending != false)
+                        /** Segments left to be sent */
+                        if (ptInst->u16Sz != (uint16_t)0U)
                         {
                             ptInst->eState = MCB_WRITE_REQUEST;
                         }
                         else
                         {
-                            ptInst->u16Sz = MCB_FRM_CONFIG_SZ;
+                            ptInst->u16Sz = ptInst->u16CfgSz;
                             ptInst->eState = MCB_WRITE_SUCCESS;
                         }
                     }
@@ -728,11 +1305,11 @@ static bool Mcb_IntfWriteCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Addr, uint
                     break;
                 case MCB_REP_WRITE_ERROR:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[(uint16_t)0U]);
+                    Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[(uint16_t)0U]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        ptInst->u16Sz = MCB_FRM_CONFIG_SZ;
+                        ptInst->u16Sz = ptInst->u16CfgSz;
                         ptInst->eState = MCB_WRITE_ERROR;
                     }
                     else
@@ -772,21 +1349,21 @@ static bool Mcb_IntfReadCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Addr, uint1
     {
         case MCB_READ_REQUEST:
             /* Send read request */
-            Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_READ, MCB_FRM_NOTSEG, NULL, false);
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_READ, MCB_FRM_NOTSEG, NULL, false);
             isNewData = true;
             ptInst->eState = MCB_READ_ANSWER;
             break;
         case MCB_READ_ANSWER:
             /** Check reception */
-            switch (Mcb_FrameGetCmd(&(ptInst->tRxfrm)))
+            switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
             {
                 case MCB_REP_ACK:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        if (Mcb_FrameGetSegmented(&(ptInst->tRxfrm)) != false)
+                        if (Mcb_FrameGetSegmented(ptInst->ptRxfrm) != false)
                         {
                             ptInst->eState = MCB_READ_ANSWER;
                         }
@@ -803,11 +1380,11 @@ static bool Mcb_IntfReadCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Addr, uint1
                     break;
                 case MCB_REP_READ_ERROR:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        ptInst->u16Sz = MCB_FRM_CONFIG_SZ;
+                        ptInst->u16Sz = ptInst->u16CfgSz;
                         ptInst->eState = MCB_READ_ERROR;
                     }
                     else
@@ -847,21 +1424,21 @@ static bool Mcb_IntfGetInfoCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Addr, ui
     {
         case MCB_GETINFO_REQUEST:
             /* Send read request */
-            Mcb_FrameCreateConfig(&(ptInst->tTxfrm), u16Addr, MCB_REQ_GETINFO, MCB_FRM_NOTSEG, NULL, false);
+            Mcb_FrameCreateConfig(ptInst->ptTxfrm, u16Addr, MCB_REQ_GETINFO, MCB_FRM_NOTSEG, NULL, false);
             isNewData = true;
             ptInst->eState = MCB_GETINFO_ANSWER;
             break;
         case MCB_GETINFO_ANSWER:
             /** Check reception */
-            switch (Mcb_FrameGetCmd(&(ptInst->tRxfrm)))
+            switch (Mcb_FrameGetCmd(ptInst->ptRxfrm))
             {
                 case MCB_REP_ACK:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        if (Mcb_FrameGetSegmented(&(ptInst->tRxfrm)) != false)
+                        if (Mcb_FrameGetSegmented(ptInst->ptRxfrm) != false)
                         {
                             ptInst->eState = MCB_GETINFO_ANSWER;
                         }
@@ -878,11 +1455,11 @@ static bool Mcb_IntfGetInfoCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Addr, ui
                     break;
                 case MCB_REP_GETINFO_ERROR:
                     /* Copy read data to buffer - Also copy it in case of error msg */
-                    ptInst->u16Sz += Mcb_FrameGetConfigData(&(ptInst->tRxfrm), &pu16Data[ptInst->u16Sz]);
+                    ptInst->u16Sz += Mcb_FrameGetConfigData(ptInst->ptRxfrm, &pu16Data[ptInst->u16Sz]);
 
-                    if (Mcb_FrameGetAddr(&(ptInst->tRxfrm)) == u16Addr)
+                    if (Mcb_FrameGetAddr(ptInst->ptRxfrm) == u16Addr)
                     {
-                        ptInst->u16Sz = MCB_FRM_CONFIG_SZ;
+                        ptInst->u16Sz = ptInst->u16CfgSz;
                         ptInst->eState = MCB_GETINFO_ERROR;
                     }
                     else
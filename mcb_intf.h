@@ -19,6 +19,19 @@
 
 #include "mcb_usr.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Write request of a pipelined transaction */
+typedef struct
+{
+    /** Target register address */
+    uint16_t u16Addr;
+    /** Data to be written, a request always fits in a single config frame */
+    uint16_t u16Data[MCB_FRM_CONFIG_SZ];
+} Mcb_TIntfPipeReq;
+
 /**
  * Initialize a Motion Control Bus interface
  *
@@ -46,13 +59,30 @@ Mcb_IntfDeinit(Mcb_TIntf* ptInst);
 void
 Mcb_IntfReset(Mcb_TIntf* ptInst);
 
+/**
+ * Sets the config data size of the frames
+ *
+ * @note The slave must use the same size. It can only be changed while no
+ *       transaction is in progress.
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] u16CfgSz
+ *  Config data size (words), a power of two from MCB_FRM_CONFIG_SZ
+ *  to MCB_FRM_MAX_CONFIG_SZ
+ *
+ * @retval true if the size has been changed, false otherwise
+ */
+bool
+Mcb_IntfSetConfigSize(Mcb_TIntf* ptInst, uint16_t u16CfgSz);
+
 /**
  * Execute a complete config write sequence through MCB
  *
  * @param[in] ptInst
  *  Target instance
  * @param[in] u16Node
- *  Target slave
+ *  Target slave, nodes from MCB_NUMBER_NODES on fail
  * @param[in] u16Addr
  *  Register address to be written
  * @param[in] pu16Data
@@ -71,7 +101,7 @@ Mcb_IntfWrite(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* p
  * @param[in] ptInst
  *  Target instance
  * @param[in] u16Node
- *  Target slave
+ *  Target slave, nodes from MCB_NUMBER_NODES on fail
  * @param[in] u16Addr
  *  Register address to be read
  * @param[out] pu16Data
@@ -90,7 +120,7 @@ Mcb_IntfRead(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu
  * @param[in] ptInst
  *  Target instance
  * @param[in] u16Node
- *  Target slave
+ *  Target slave, nodes from MCB_NUMBER_NODES on fail
  * @param[in] u16Addr
  *  Register address to be read
  * @param[out] pu16Data
@@ -103,13 +133,76 @@ Mcb_IntfRead(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu
 Mcb_EStatus
 Mcb_IntfGetInfo(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu16Data, uint16_t* pu16Sz);
 
+/**
+ * Execute a sequence of config writes through MCB, pipelined
+ *
+ * @note A new request is sent on every frame while the reply of the previous
+ *       one is clocked in, so N writes take N + 1 frames instead of 2 * N.
+ *       If a reply is lost or does not match and isReplay is true, the
+ *       sequence is replayed from the last acknowledged request, so requests
+ *       must be idempotent and target different addresses. Otherwise the
+ *       sequence stops with MCB_WRITE_ERROR, the requests from pu16Done on
+ *       may or may not have been applied. An error reply of the first
+ *       request not acknowledged yet always stops the sequence.
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] u16Node
+ *  Target slave, nodes from MCB_NUMBER_NODES on fail
+ * @param[in] ptReq
+ *  Write requests
+ * @param[in] u16Num
+ *  Number of write requests
+ * @param[in] isReplay
+ *  Replay the requests whose reply has been lost
+ * @param[out] pu16Done
+ *  Number of acknowledged requests
+ *
+ * @retval Mcb_EStatus
+ */
+Mcb_EStatus
+Mcb_IntfWritePipe(Mcb_TIntf* ptInst, uint16_t u16Node, const Mcb_TIntfPipeReq* ptReq, uint16_t u16Num,
+                  bool isReplay, uint16_t* pu16Done);
+
+/**
+ * Execute a sequence of config reads through MCB, pipelined
+ *
+ * @note The request of every register is sent on the frame which clocks in
+ *       the reply of the previous one, so N reads take N + 1 frames. If a
+ *       reply is lost or does not match, the sequence is replayed from the
+ *       first register not received yet.
+ * @note Only registers fitting in a single frame can be read. A segmented
+ *       reply or an error reply of the first register not received yet
+ *       stops the sequence with MCB_READ_ERROR, once every pending reply has
+ *       been clocked out. Replies of later registers are replayed instead.
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] u16Node
+ *  Target slave, nodes from MCB_NUMBER_NODES on fail
+ * @param[in] pu16Addr
+ *  Register addresses
+ * @param[out] pu16Data
+ *  Read data, the config data of register i is stored at i * u16CfgSz.
+ *  It must hold u16Num * u16CfgSz words
+ * @param[in] u16Num
+ *  Number of registers
+ * @param[out] pu16Done
+ *  Number of registers read
+ *
+ * @retval Mcb_EStatus
+ */
+Mcb_EStatus
+Mcb_IntfReadPipe(Mcb_TIntf* ptInst, uint16_t u16Node, const uint16_t* pu16Addr, uint16_t* pu16Data,
+                 uint16_t u16Num, uint16_t* pu16Done);
+
 /**
  * Process config data inside cyclic frames
  *
  * @param[in] ptInst
  *  Target instance
  * @param[in] u16Node
- *  Target slave
+ *  Target slave, requests to any other node than the cyclic one fail
  * @param[in] u16Addr
  *  Register address to be read / write through config
  * @param[in, out] pu16Cmd
@@ -127,6 +220,41 @@ Mcb_EStatus
 Mcb_IntfCfgOverCyclic(Mcb_TIntf* ptInst, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu16Cmd, uint16_t* pu16Data,
                       uint16_t* pu16CfgSz, bool* pisNewData);
 
+/**
+ * Switches the interface in or out of cyclic mode
+ *
+ * @note To be called while no transfer is on the wire. With
+ *       MCB_CYCLIC_ZERO_COPY, cyclic frames are assembled around the
+ *       application buffer and the rest on a frame of their own.
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] isCyclic
+ *  true once cyclic mode is entered, false once it is left
+ */
+void
+Mcb_IntfSetCyclic(Mcb_TIntf* ptInst, bool isCyclic);
+
+/**
+ * Assemble the next idle cyclic frame in advance
+ *
+ * @note The frame is assembled on the pair which is not on the wire, so
+ *       it can be called while the previous transfer is ongoing. It is
+ *       only effective with more than one frame pair.
+ *
+ * @param[in] ptInst
+ *  Target instance
+ * @param[in] ptInBuf
+ *  Cyclic data to be sent
+ * @param[in] u16CyclicSz
+ *  Cyclic transmission size
+ *
+ * @retval true if the frame has been prepared
+ *         false otherwise
+ */
+bool
+Mcb_IntfCyclicPrepare(Mcb_TIntf* ptInst, uint16_t *ptInBuf, uint16_t u16CyclicSz);
+
 /**
  * Latch a cyclic transfer through MCB
  *
@@ -151,10 +279,17 @@ Mcb_IntfCyclicLatch(Mcb_TIntf* ptInst, uint16_t *ptInBuf, uint16_t u16CyclicSz,
  *  Received Cyclic data
  * @param[in] u16CyclicSz
  *  Cyclic transmission size
+ *
+ * @retval true if the crc of the received frame is correct
+ *         false otherwise
  */
-void
+bool
 Mcb_IntfProcessCyclic(Mcb_TIntf* ptInst, uint16_t *ptOutBuf, uint16_t u16CyclicSz);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* MCB_INTF_H */
 
 /** @} */
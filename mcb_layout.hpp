@@ -0,0 +1,299 @@
+/**
+ * @file mcb_layout.hpp
+ * @brief This file contains a C++17 typed description of the cyclic
+ *        layout of the motion control bus (MCB)
+ *
+ * The registers exchanged on every cycle are declared as a list of
+ * (address, data type) descriptors. Their offsets and the cyclic size are
+ * computed at compile time, and a layout that does not fit the cyclic area
+ * fails the build. Mapped registers are accessed by address, through
+ * references of the register type.
+ *
+ * @code
+ * using TRxLayout = mcb::Layout<mcb::Reg<0x020U, INT32_TYPE>, mcb::Reg<0x021U, FLOAT_TYPE>>;
+ * using TTxLayout = mcb::Layout<mcb::Reg<0x030U, INT32_TYPE>, mcb::Reg<0x031U, UINT16_TYPE>>;
+ *
+ * mcb::Cyclic<TRxLayout, TTxLayout> tCyclic(tMcb);
+ * tCyclic.enable();
+ * tCyclic.rx<0x021U>() = 1.5F;
+ * int32_t i32Pos = tCyclic.tx<0x030U>();
+ * @endcode
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+ /**
+ * \addtogroup LayoutAPI Cyclic layout API
+ *
+ * @{
+ *
+ *  Compile time cyclic layout for C++ applications
+ */
+
+#ifndef MCB_LAYOUT_HPP
+#define MCB_LAYOUT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+
+#include "mcb.h"
+
+namespace mcb
+{
+
+/** C++ type of a register data type, string registers cannot be mapped */
+template <uint16_t u16Type>
+struct DataType
+{
+    static_assert(u16Type != u16Type, "Register data type can not be mapped");
+};
+
+template <>
+struct DataType<INT16_TYPE> { using type = int16_t; };
+
+template <>
+struct DataType<UINT16_TYPE> { using type = uint16_t; };
+
+template <>
+struct DataType<INT32_TYPE> { using type = int32_t; };
+
+template <>
+struct DataType<UINT32_TYPE> { using type = uint32_t; };
+
+template <>
+struct DataType<FLOAT_TYPE> { using type = float; };
+
+/**
+ * Mapped register descriptor
+ *
+ * @tparam u16RegAddr
+ *  Register address
+ * @tparam u16RegType
+ *  Register data type, INT16_TYPE to FLOAT_TYPE
+ */
+template <uint16_t u16RegAddr, uint16_t u16RegType>
+struct Reg
+{
+    using type = typename DataType<u16RegType>::type;
+
+    /** Register address */
+    static constexpr uint16_t u16Addr = u16RegAddr;
+    /** Register size (bytes) */
+    static constexpr uint16_t u16Sz = static_cast<uint16_t>(sizeof(type));
+    /** Register size in the cyclic buffers (words), registers are word aligned */
+    static constexpr uint16_t u16Words = static_cast<uint16_t>((sizeof(type) + 1U) >> 1U);
+};
+
+/**
+ * Reference to a mapped register
+ *
+ * @note Cyclic buffers are only word aligned, so the value is copied in and
+ *       out instead of being accessed through a T pointer.
+ */
+template <typename T>
+class RegRef
+{
+public:
+    explicit RegRef(uint16_t* pu16Reg) noexcept : pu16Data(pu16Reg) {}
+
+    operator T() const noexcept
+    {
+        T tVal;
+        std::memcpy(&tVal, pu16Data, sizeof(T));
+        return tVal;
+    }
+
+    RegRef& operator=(T tVal) noexcept
+    {
+        std::memcpy(pu16Data, &tVal, sizeof(T));
+        return *this;
+    }
+
+    RegRef& operator=(const RegRef& tOther) noexcept
+    {
+        return (*this = static_cast<T>(tOther));
+    }
+
+private:
+    /** Register location in the cyclic buffer */
+    uint16_t* pu16Data;
+};
+
+/**
+ * Cyclic layout of one direction, registers are placed in the given order
+ *
+ * @tparam TRegs
+ *  Register descriptors, see Reg
+ */
+template <typename... TRegs>
+class Layout
+{
+public:
+    /** Number of mapped registers */
+    static constexpr uint8_t u8Num = static_cast<uint8_t>(sizeof...(TRegs));
+    /** Cyclic size (words) */
+    static constexpr uint16_t u16Words = static_cast<uint16_t>((TRegs::u16Words + ... + 0U));
+
+    static_assert(sizeof...(TRegs) <= MAX_MAPPED_REG, "Cyclic layout exceeds MAX_MAPPED_REG registers");
+    static_assert(u16Words <= MCB_FRM_MAX_CYCLIC_SZ, "Cyclic layout exceeds MCB_FRM_MAX_CYCLIC_SZ");
+
+    /**
+     * Position of a register in the layout
+     *
+     * @tparam u16Addr
+     *  Register address
+     */
+    template <uint16_t u16Addr>
+    static constexpr std::size_t index() noexcept
+    {
+        std::size_t szIdx = sizeof...(TRegs);
+
+        for (std::size_t szPos = 0U; szPos < sizeof...(TRegs); szPos++)
+        {
+            if (tAddr[szPos] == u16Addr)
+            {
+                szIdx = szPos;
+                break;
+            }
+        }
+
+        return szIdx;
+    }
+
+    /** Descriptor of a register, the first one if it is not in the layout */
+    template <uint16_t u16Addr>
+    struct Find
+    {
+        static_assert(index<u16Addr>() < sizeof...(TRegs), "Register is not in the cyclic layout");
+
+        using type = typename std::tuple_element_t<
+            ((index<u16Addr>() < sizeof...(TRegs)) ? index<u16Addr>() : 0U), std::tuple<TRegs...>>::type;
+    };
+
+    /** C++ type of a register */
+    template <uint16_t u16Addr>
+    using type = typename Find<u16Addr>::type;
+
+    /**
+     * Offset of a register in the cyclic buffer (words)
+     *
+     * @tparam u16Addr
+     *  Register address
+     */
+    template <uint16_t u16Addr>
+    static constexpr uint16_t offset() noexcept
+    {
+        static_assert(index<u16Addr>() < sizeof...(TRegs), "Register is not in the cyclic layout");
+
+        uint16_t u16Offset = 0U;
+
+        for (std::size_t szPos = 0U; szPos < index<u16Addr>(); szPos++)
+        {
+            u16Offset = static_cast<uint16_t>(u16Offset + tWords[szPos]);
+        }
+
+        return u16Offset;
+    }
+
+    /** Mapping table of the layout, as taken by Mcb_MapBatch */
+    static std::array<Mcb_TMapEntry, sizeof...(TRegs)> table() noexcept
+    {
+        return {{ {TRegs::u16Addr, TRegs::u16Sz, nullptr}... }};
+    }
+
+private:
+    /** Register addresses */
+    static constexpr std::array<uint16_t, sizeof...(TRegs)> tAddr = {{ TRegs::u16Addr... }};
+    /** Register sizes (words) */
+    static constexpr std::array<uint16_t, sizeof...(TRegs)> tWords = {{ TRegs::u16Words... }};
+
+    static constexpr bool isUnique() noexcept
+    {
+        bool isUniq = true;
+
+        for (std::size_t szPos = 0U; szPos < sizeof...(TRegs); szPos++)
+        {
+            for (std::size_t szNext = szPos + 1U; szNext < sizeof...(TRegs); szNext++)
+            {
+                if (tAddr[szPos] == tAddr[szNext])
+                {
+                    isUniq = false;
+                }
+            }
+        }
+
+        return isUniq;
+    }
+
+    static_assert(isUnique(), "Register mapped twice in the cyclic layout");
+};
+
+/**
+ * Cyclic mapping of an instance
+ *
+ * @tparam TRxLayout
+ *  Rx (from MCB slave point of view) layout, setpoints sent to the slave
+ * @tparam TTxLayout
+ *  Tx (from MCB slave point of view) layout, values received from the slave
+ */
+template <typename TRxLayout, typename TTxLayout>
+class Cyclic
+{
+public:
+    explicit Cyclic(Mcb_TInst& tMcb) noexcept : tInst(tMcb) {}
+
+    /**
+     * Replaces the whole mapping with both layouts and enables cyclic mode
+     *
+     * @note Blocking function, see Mcb_MapBatch
+     *
+     * @retval > 0 if transition successful, indicating the cyclic size.
+     *         < 0 indicates an errorcode.
+     */
+    int32_t enable() noexcept
+    {
+        auto tRxTable = TRxLayout::table();
+        auto tTxTable = TTxLayout::table();
+
+        return Mcb_MapBatch(&tInst, tRxTable.data(), TRxLayout::u8Num, tTxTable.data(), TTxLayout::u8Num);
+    }
+
+    /**
+     * Setpoint sent to the slave
+     *
+     * @tparam u16Addr
+     *  Register address, from the Rx layout
+     */
+    template <uint16_t u16Addr>
+    RegRef<typename TRxLayout::template type<u16Addr>> rx() noexcept
+    {
+        return RegRef<typename TRxLayout::template type<u16Addr>>(
+            &MCB_CYCLIC_TX_BUF(&tInst)[TRxLayout::template offset<u16Addr>()]);
+    }
+
+    /**
+     * Value received from the slave
+     *
+     * @tparam u16Addr
+     *  Register address, from the Tx layout
+     */
+    template <uint16_t u16Addr>
+    RegRef<typename TTxLayout::template type<u16Addr>> tx() noexcept
+    {
+        return RegRef<typename TTxLayout::template type<u16Addr>>(
+            &MCB_CYCLIC_RX_BUF(&tInst)[TTxLayout::template offset<u16Addr>()]);
+    }
+
+private:
+    /** Mapped instance */
+    Mcb_TInst& tInst;
+};
+
+} /* namespace mcb */
+
+#endif /* MCB_LAYOUT_HPP */
+
+/** @} */
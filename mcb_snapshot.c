@@ -0,0 +1,334 @@
+/**
+ * @file mcb_snapshot.c
+ * @brief This file contains the parameter snapshot engine
+ *        of the motion control bus (MCB)
+ *
+ * File layout: a Mcb_TSnapHeader, then one record per register made of its
+ * address, its size in words and its data, and finally the CRC of all the
+ * records. Everything is stored in host byte order.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_snapshot.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Reads the next record of a snapshot file
+ *
+ * @param[in] ptFile
+ *  Snapshot file
+ * @param[in, out] pu16Crc
+ *  Incremental CRC of the records
+ * @param[out] pMcbMsg
+ *  Address, size and data of the register
+ *
+ * @retval true if a valid record has been read, false otherwise
+ */
+static bool
+Mcb_SnapReadRecord(FILE* ptFile, uint16_t* pu16Crc, Mcb_TMsg* pMcbMsg);
+
+/**
+ * Fills the time related statistics of an operation
+ *
+ * @param[out] ptStats
+ *  Operation statistics
+ * @param[in] u32Millis
+ *  Start time of the operation
+ */
+static void
+Mcb_SnapStatsEnd(Mcb_TSnapStats* ptStats, uint32_t u32Millis);
+
+int32_t Mcb_SnapshotSave(Mcb_TInst* ptInst, uint16_t u16Node, const Mcb_TDict* ptDict, const char* szPath,
+                         Mcb_TSnapStats* ptStats)
+{
+    int32_t i32Ret = MCB_SNAP_OK;
+    uint32_t u32Millis = Mcb_GetMillis();
+    uint16_t u16Crc = Mcb_IntfCrcInit();
+    Mcb_TSnapHeader tHeader;
+    Mcb_TInfoData tInfo;
+    Mcb_TMsg tMsg;
+    uint16_t u16Sz;
+    FILE* ptFile = NULL;
+
+    memset((void*)ptStats, 0, sizeof(Mcb_TSnapStats));
+
+    do
+    {
+        if ((ptInst->eMode != MCB_BLOCKING) || (ptInst->isCyclic != false))
+        {
+            i32Ret = MCB_SNAP_ERR_STATE;
+            break;
+        }
+
+        ptFile = fopen(szPath, "wb");
+        if (ptFile == NULL)
+        {
+            i32Ret = MCB_SNAP_ERR_IO;
+            break;
+        }
+
+        /** Number of registers is patched once they are known */
+        tHeader.u32Magic = MCB_SNAP_MAGIC;
+        tHeader.u16Version = MCB_SNAP_VERSION;
+        tHeader.u16Num = (uint16_t)0U;
+        tHeader.u32FwId = ptDict->u32FwId;
+
+        if (fwrite(&tHeader, sizeof(tHeader), 1U, ptFile) != 1U)
+        {
+            i32Ret = MCB_SNAP_ERR_IO;
+            break;
+        }
+
+        for (uint16_t u16Idx = (uint16_t)0U; u16Idx < ptDict->u16Num; u16Idx++)
+        {
+            memcpy((void*)&tInfo, (const void*)ptDict->ptEntry[u16Idx].u16Info, sizeof(ptDict->ptEntry[u16Idx].u16Info));
+            u16Sz = (uint16_t)((tInfo.u8Size + 1U) >> 1U);
+
+            if ((tInfo.u8AccessType != RW_ACCESS) || (tInfo.u8CyclicType != 0U)
+                || (u16Sz == (uint16_t)0U) || (u16Sz > MCB_MAX_DATA_SZ))
+            {
+                continue;
+            }
+
+            tMsg.u16Node = u16Node;
+            tMsg.u16Addr = ptDict->ptEntry[u16Idx].u16Addr;
+            tMsg.u16Size = u16Sz;
+            ptInst->Mcb_Read(ptInst, &tMsg);
+
+            if (tMsg.eStatus != MCB_READ_SUCCESS)
+            {
+                ptStats->u16Failed++;
+                i32Ret = MCB_SNAP_ERR_BUS;
+                break;
+            }
+
+            tMsg.u16Size = u16Sz;
+            u16Crc = Mcb_IntfCrcUpdate(u16Crc, &tMsg.u16Addr, (uint16_t)1U);
+            u16Crc = Mcb_IntfCrcUpdate(u16Crc, &tMsg.u16Size, (uint16_t)1U);
+            u16Crc = Mcb_IntfCrcUpdate(u16Crc, tMsg.u16Data, tMsg.u16Size);
+
+            if ((fwrite(&tMsg.u16Addr, sizeof(uint16_t), 1U, ptFile) != 1U)
+                || (fwrite(&tMsg.u16Size, sizeof(uint16_t), 1U, ptFile) != 1U)
+                || (fwrite(tMsg.u16Data, sizeof(uint16_t), tMsg.u16Size, ptFile) != tMsg.u16Size))
+            {
+                i32Ret = MCB_SNAP_ERR_IO;
+                break;
+            }
+
+            ptStats->u16Regs++;
+        }
+
+        if (i32Ret != MCB_SNAP_OK)
+        {
+            break;
+        }
+
+        u16Crc = Mcb_IntfCrcFinal(u16Crc);
+        tHeader.u16Num = ptStats->u16Regs;
+
+        if ((fwrite(&u16Crc, sizeof(u16Crc), 1U, ptFile) != 1U)
+            || (fseek(ptFile, 0L, SEEK_SET) != 0)
+            || (fwrite(&tHeader, sizeof(tHeader), 1U, ptFile) != 1U))
+        {
+            i32Ret = MCB_SNAP_ERR_IO;
+        }
+    } while (false);
+
+    if ((ptFile != NULL) && (fclose(ptFile) != 0))
+    {
+        i32Ret = MCB_SNAP_ERR_IO;
+    }
+
+    Mcb_SnapStatsEnd(ptStats, u32Millis);
+
+    return i32Ret;
+}
+
+int32_t Mcb_SnapshotRestore(Mcb_TInst* ptInst, uint16_t u16Node, const char* szPath, Mcb_TSnapStats* ptStats)
+{
+    int32_t i32Ret = MCB_SNAP_OK;
+    uint32_t u32Millis = Mcb_GetMillis();
+    Mcb_TIntfPipeReq tReq[MCB_SNAP_PIPE_SZ];
+    uint16_t u16ReqNum = (uint16_t)0U;
+    Mcb_TSnapHeader tHeader;
+    long lRecords = 0L;
+    uint32_t u32FwId;
+    uint16_t u16Crc;
+    uint16_t u16FileCrc;
+    uint16_t u16Idx;
+    Mcb_TMsg tMsg;
+    Mcb_TMsg tReadMsg;
+    FILE* ptFile = NULL;
+
+    memset((void*)ptStats, 0, sizeof(Mcb_TSnapStats));
+
+    do
+    {
+        if ((ptInst->eMode != MCB_BLOCKING) || (ptInst->isCyclic != false))
+        {
+            i32Ret = MCB_SNAP_ERR_STATE;
+            break;
+        }
+
+        ptFile = fopen(szPath, "rb");
+        if (ptFile == NULL)
+        {
+            i32Ret = MCB_SNAP_ERR_IO;
+            break;
+        }
+
+        if ((fread(&tHeader, sizeof(tHeader), 1U, ptFile) != 1U)
+            || (tHeader.u32Magic != MCB_SNAP_MAGIC) || (tHeader.u16Version != MCB_SNAP_VERSION))
+        {
+            i32Ret = MCB_SNAP_ERR_FORMAT;
+            break;
+        }
+
+        if (Mcb_DictReadFwId(ptInst, u16Node, &u32FwId) != MCB_DICT_OK)
+        {
+            i32Ret = MCB_SNAP_ERR_BUS;
+            break;
+        }
+
+        if (tHeader.u32FwId != u32FwId)
+        {
+            i32Ret = MCB_SNAP_ERR_FW;
+            break;
+        }
+
+        lRecords = ftell(ptFile);
+
+        /** Check the whole file before writing anything */
+        u16Crc = Mcb_IntfCrcInit();
+        for (u16Idx = (uint16_t)0U; u16Idx < tHeader.u16Num; u16Idx++)
+        {
+            if (Mcb_SnapReadRecord(ptFile, &u16Crc, &tMsg) == false)
+            {
+                break;
+            }
+        }
+
+        if ((u16Idx != tHeader.u16Num) || (fread(&u16FileCrc, sizeof(u16FileCrc), 1U, ptFile) != 1U)
+            || (u16FileCrc != Mcb_IntfCrcFinal(u16Crc)))
+        {
+            i32Ret = MCB_SNAP_ERR_FORMAT;
+            break;
+        }
+
+        /** Write pass */
+        (void)fseek(ptFile, lRecords, SEEK_SET);
+        for (u16Idx = (uint16_t)0U; u16Idx < tHeader.u16Num; u16Idx++)
+        {
+            (void)Mcb_SnapReadRecord(ptFile, &u16Crc, &tMsg);
+
+            if (tMsg.u16Size <= MCB_FRM_CONFIG_SZ)
+            {
+                tReq[u16ReqNum].u16Addr = tMsg.u16Addr;
+                memset((void*)tReq[u16ReqNum].u16Data, 0, sizeof(tReq[u16ReqNum].u16Data));
+                memcpy((void*)tReq[u16ReqNum].u16Data, (const void*)tMsg.u16Data, (tMsg.u16Size * sizeof(uint16_t)));
+                u16ReqNum++;
+            }
+            else
+            {
+                /** Keep the file order, then larger registers go through the segmented write */
+                if (Mcb_WriteBatch(ptInst, u16Node, tReq, u16ReqNum, false) != u16ReqNum)
+                {
+                    i32Ret = MCB_SNAP_ERR_BUS;
+                    break;
+                }
+                u16ReqNum = (uint16_t)0U;
+
+                tMsg.u16Node = u16Node;
+                ptInst->Mcb_Write(ptInst, &tMsg);
+                if (tMsg.eStatus != MCB_WRITE_SUCCESS)
+                {
+                    i32Ret = MCB_SNAP_ERR_BUS;
+                    break;
+                }
+            }
+
+            if ((u16ReqNum == MCB_SNAP_PIPE_SZ)
+                || ((u16ReqNum != (uint16_t)0U) && (u16Idx == (uint16_t)(tHeader.u16Num - 1U))))
+            {
+                /** Writes may not be idempotent, a lost reply is not replayed */
+                if (Mcb_WriteBatch(ptInst, u16Node, tReq, u16ReqNum, false) != u16ReqNum)
+                {
+                    i32Ret = MCB_SNAP_ERR_BUS;
+                    break;
+                }
+                u16ReqNum = (uint16_t)0U;
+            }
+        }
+
+        if (i32Ret != MCB_SNAP_OK)
+        {
+            break;
+        }
+
+        /** Read back pass */
+        (void)fseek(ptFile, lRecords, SEEK_SET);
+        for (u16Idx = (uint16_t)0U; u16Idx < tHeader.u16Num; u16Idx++)
+        {
+            (void)Mcb_SnapReadRecord(ptFile, &u16Crc, &tMsg);
+
+            tReadMsg.u16Node = u16Node;
+            tReadMsg.u16Addr = tMsg.u16Addr;
+            tReadMsg.u16Size = tMsg.u16Size;
+            ptInst->Mcb_Read(ptInst, &tReadMsg);
+
+            if ((tReadMsg.eStatus != MCB_READ_SUCCESS)
+                || (memcmp((const void*)tReadMsg.u16Data, (const void*)tMsg.u16Data,
+                           (tMsg.u16Size * sizeof(uint16_t))) != 0))
+            {
+                ptStats->u16Failed++;
+                i32Ret = MCB_SNAP_ERR_VERIFY;
+            }
+
+            ptStats->u16Regs++;
+        }
+    } while (false);
+
+    if (ptFile != NULL)
+    {
+        (void)fclose(ptFile);
+    }
+
+    Mcb_SnapStatsEnd(ptStats, u32Millis);
+
+    return i32Ret;
+}
+
+static bool Mcb_SnapReadRecord(FILE* ptFile, uint16_t* pu16Crc, Mcb_TMsg* pMcbMsg)
+{
+    bool isValid = false;
+
+    if ((fread(&pMcbMsg->u16Addr, sizeof(uint16_t), 1U, ptFile) == 1U)
+        && (fread(&pMcbMsg->u16Size, sizeof(uint16_t), 1U, ptFile) == 1U)
+        && (pMcbMsg->u16Size != (uint16_t)0U) && (pMcbMsg->u16Size <= MCB_MAX_DATA_SZ)
+        && (fread(pMcbMsg->u16Data, sizeof(uint16_t), pMcbMsg->u16Size, ptFile) == pMcbMsg->u16Size))
+    {
+        *pu16Crc = Mcb_IntfCrcUpdate(*pu16Crc, &pMcbMsg->u16Addr, (uint16_t)1U);
+        *pu16Crc = Mcb_IntfCrcUpdate(*pu16Crc, &pMcbMsg->u16Size, (uint16_t)1U);
+        *pu16Crc = Mcb_IntfCrcUpdate(*pu16Crc, pMcbMsg->u16Data, pMcbMsg->u16Size);
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+static void Mcb_SnapStatsEnd(Mcb_TSnapStats* ptStats, uint32_t u32Millis)
+{
+    ptStats->u32Millis = Mcb_GetMillis() - u32Millis;
+
+    if (ptStats->u32Millis != 0UL)
+    {
+        ptStats->u32RegsPerSec = (uint32_t)((ptStats->u16Regs * 1000UL) / ptStats->u32Millis);
+    }
+    else
+    {
+        ptStats->u32RegsPerSec = (uint32_t)(ptStats->u16Regs * 1000UL);
+    }
+}
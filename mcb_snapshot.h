@@ -0,0 +1,137 @@
+/**
+ * @file mcb_snapshot.h
+ * @brief This file contains API for the parameter snapshot engine
+ *        of the motion control bus (MCB)
+ *
+ * A snapshot is the value of every RW parameter of a drive, streamed to a
+ * binary file. It is restored with pipelined writes and checked reading
+ * every register back.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+ /**
+ * \addtogroup SnapshotAPI Snapshot API
+ *
+ * @{
+ *
+ *  Host side backup and restore of drive parameters
+ */
+
+#ifndef MCB_SNAPSHOT_H
+#define MCB_SNAPSHOT_H
+
+#include "mcb_dict.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Snapshot file magic, "MCBS" */
+#define MCB_SNAP_MAGIC (uint32_t)0x5342434DUL
+
+/** Snapshot file format version */
+#define MCB_SNAP_VERSION (uint16_t)1U
+
+/** Number of writes sent on a single pipelined sequence */
+#ifndef MCB_SNAP_PIPE_SZ
+#define MCB_SNAP_PIPE_SZ (uint16_t)32U
+#endif
+
+/** Snapshot operation success */
+#define MCB_SNAP_OK (int32_t)0L
+/** The file cannot be opened, read or written */
+#define MCB_SNAP_ERR_IO (int32_t)-1L
+/** The file is not a snapshot, or its version or checksum do not match */
+#define MCB_SNAP_ERR_FORMAT (int32_t)-2L
+/** The snapshot belongs to another firmware */
+#define MCB_SNAP_ERR_FW (int32_t)-3L
+/** A register request failed */
+#define MCB_SNAP_ERR_BUS (int32_t)-4L
+/** A restored register does not read back the snapshot value */
+#define MCB_SNAP_ERR_VERIFY (int32_t)-5L
+/** The instance is not in blocking mode or is in cyclic mode */
+#define MCB_SNAP_ERR_STATE (int32_t)-6L
+
+/** Snapshot file header */
+typedef struct
+{
+    /** File magic, MCB_SNAP_MAGIC */
+    uint32_t u32Magic;
+    /** File format version, MCB_SNAP_VERSION */
+    uint16_t u16Version;
+    /** Number of registers */
+    uint16_t u16Num;
+    /** Firmware identity of the drive */
+    uint32_t u32FwId;
+} Mcb_TSnapHeader;
+
+/** Snapshot operation statistics */
+typedef struct
+{
+    /** Number of processed registers */
+    uint16_t u16Regs;
+    /** Number of registers which failed */
+    uint16_t u16Failed;
+    /** Wall time of the operation (ms) */
+    uint32_t u32Millis;
+    /** Processed registers per second */
+    uint32_t u32RegsPerSec;
+} Mcb_TSnapStats;
+
+/**
+ * Saves the RW parameters of a drive into a snapshot file
+ *
+ * @note Registers are taken from the dictionary of the drive. Read only,
+ *       write only and cyclic capable registers are skipped. Every register
+ *       is written to the file as soon as it is read.
+ *
+ * @param[in] ptInst
+ *  Instance used to read the registers, in blocking mode
+ * @param[in] u16Node
+ *  Target slave
+ * @param[in] ptDict
+ *  Dictionary of the drive
+ * @param[in] szPath
+ *  File path
+ * @param[out] ptStats
+ *  Operation statistics
+ *
+ * @retval MCB_SNAP_OK on success, error code otherwise
+ */
+int32_t
+Mcb_SnapshotSave(Mcb_TInst* ptInst, uint16_t u16Node, const Mcb_TDict* ptDict, const char* szPath,
+                 Mcb_TSnapStats* ptStats);
+
+/**
+ * Restores a snapshot file into a drive
+ *
+ * @note The file checksum and the firmware identity read from the drive,
+ *       see @ref Mcb_DictReadFwId, are verified before writing anything.
+ *       Registers fitting in a config frame are written pipelined, larger
+ *       ones through the segmented write. A lost reply stops the restore
+ *       with MCB_SNAP_ERR_BUS, writes are never sent twice. Then every
+ *       register is read back and compared.
+ *
+ * @param[in] ptInst
+ *  Instance used to write the registers, in blocking mode
+ * @param[in] u16Node
+ *  Target slave
+ * @param[in] szPath
+ *  File path
+ * @param[out] ptStats
+ *  Operation statistics, u16Failed counts the registers not matching
+ *
+ * @retval MCB_SNAP_OK on success, error code otherwise
+ */
+int32_t
+Mcb_SnapshotRestore(Mcb_TInst* ptInst, uint16_t u16Node, const char* szPath, Mcb_TSnapStats* ptStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCB_SNAPSHOT_H */
+
+/** @} */
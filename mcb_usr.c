@@ -13,6 +13,23 @@
 /** Struct used when no resource instance defined by user */
 volatile bool ptFlag[MCB_NUMBER_RESOURCES];
 
+#ifdef CRC_CCITT_CLMUL
+/** Word oriented CRC routine, selected at start-up depending on the CPU features */
+static uint16_t (*pfCrcWords)(uint16_t u16Crc, const uint16_t* pu16Buf, size_t szWords) = crc_ccitt_words;
+
+/**
+ * Selects the carry-less multiplication CRC if the CPU supports it,
+ * the table version is kept otherwise
+ */
+__attribute__((constructor)) static void Mcb_IntfCrcSelect(void)
+{
+    if (crc_ccitt_clmul_available() != false)
+    {
+        pfCrcWords = crc_ccitt_words_clmul;
+    }
+}
+#endif
+
 __attribute__((weak))uint8_t Mcb_IntfReadIRQ(uint16_t u16Id)
 {
     /*
@@ -36,13 +53,27 @@ __attribute__((weak))bool Mcb_IntfIsReady(uint16_t u16Id)
 
 __attribute__((weak))uint16_t Mcb_IntfComputeCrc(const uint16_t* pu16Buf, uint16_t u16Sz)
 {
-    uint16_t u16Crc = CRC_START_XMODEM;
+    return Mcb_IntfCrcFinal(Mcb_IntfCrcUpdate(Mcb_IntfCrcInit(), pu16Buf, u16Sz));
+}
 
-    for (uint16_t u16Idx = 0; u16Idx < u16Sz; u16Idx++)
-    {
-        u16Crc = update_crc_ccitt(u16Crc, (pu16Buf[u16Idx] >> 8) & 0xFF);
-        u16Crc = update_crc_ccitt(u16Crc, (pu16Buf[u16Idx] & 0xFF));
-    }
+__attribute__((weak))uint16_t Mcb_IntfCrcInit(void)
+{
+    return (uint16_t)CRC_START_XMODEM;
+}
+
+__attribute__((weak))uint16_t Mcb_IntfCrcUpdate(uint16_t u16Crc, const uint16_t* pu16Buf, uint16_t u16Sz)
+{
+    /** Words are consumed directly, most significant byte first */
+#ifdef CRC_CCITT_CLMUL
+    return pfCrcWords(u16Crc, pu16Buf, u16Sz);
+#else
+    return crc_ccitt_words(u16Crc, pu16Buf, u16Sz);
+#endif
+}
+
+__attribute__((weak))uint16_t Mcb_IntfCrcFinal(uint16_t u16Crc)
+{
+    /** XModem does not apply a final XOR */
     return u16Crc;
 }
 
@@ -69,11 +100,29 @@ __attribute__((weak))void Mcb_IntfSPITransfer(uint16_t u16Id, uint16_t* pu16In,
     /** Set to high chip select pint */
 }
 
+__attribute__((weak))void Mcb_IntfSelectNode(uint16_t u16Id, uint16_t u16Node)
+{
+    /** Single chip select, nothing to be done */
+}
+
 __attribute__((weak))void Mcb_IntfSyncSignal(uint16_t u16Id)
 {
 
 }
 
+#ifndef MCB_USR_LINUX
+/** Left out along with mcb_usr_linux.c, a static library would link these ones instead */
+__attribute__((weak))void Mcb_IntfWaitEvent(uint16_t u16Id, uint32_t u32Timeout)
+{
+    /** No event support, blocking requests keep on polling */
+}
+
+__attribute__((weak))void Mcb_IntfNotifyEvent(uint16_t u16Id)
+{
+
+}
+#endif
+
 __attribute__((weak))void Mcb_IntfInitResource(uint16_t u16Id)
 {
     /** Init the resource instance, release state */
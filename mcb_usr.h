@@ -22,8 +22,68 @@
 #include <stdbool.h>
 #include "mcb_frame.h"
 
-/** Number of resources instances */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of resources instances, one per interface id */
+#ifndef MCB_NUMBER_RESOURCES
 #define MCB_NUMBER_RESOURCES (uint16_t)1U
+#endif
+
+/** Number of nodes with their own transaction state on a single bus */
+#ifndef MCB_NUMBER_NODES
+#ifdef MCB_COMPACT
+#define MCB_NUMBER_NODES (uint16_t)4U
+#else
+#define MCB_NUMBER_NODES (uint16_t)16U
+#endif
+#endif
+
+/** Number of tx/rx frame pairs per interface, two allow ping-pong transfers */
+#ifndef MCB_FRM_PAIRS
+#ifdef MCB_CYCLIC_ZERO_COPY
+#define MCB_FRM_PAIRS 1U
+#else
+#define MCB_FRM_PAIRS 2U
+#endif
+#endif
+
+#if defined(MCB_CYCLIC_ZERO_COPY) && (MCB_FRM_PAIRS != 1U)
+#error "Zero-copy cyclic buffers require a single frame pair"
+#endif
+
+/** Number of tx frames, zero-copy keeps the config frames out of the cyclic buffer */
+#ifdef MCB_CYCLIC_ZERO_COPY
+#define MCB_FRM_TX_NUM (MCB_FRM_PAIRS + 1U)
+#else
+#define MCB_FRM_TX_NUM MCB_FRM_PAIRS
+#endif
+
+/**
+ * Acquire load, release store and fences of the data shared between the
+ * application threads and the one calling the cyclic functions.
+ * Define them for compilers without the GCC atomic builtins, plain volatile
+ * accesses are only safe on single core targets.
+ */
+#ifndef MCB_LOAD_ACQUIRE
+#if defined(__GNUC__)
+#define MCB_LOAD_ACQUIRE(x)         __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define MCB_STORE_RELEASE(x, val)   __atomic_store_n(&(x), (val), __ATOMIC_RELEASE)
+#define MCB_FENCE_ACQUIRE()         __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define MCB_FENCE_RELEASE()         __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+#define MCB_LOAD_ACQUIRE(x)         (x)
+#define MCB_STORE_RELEASE(x, val)   ((x) = (val))
+#define MCB_FENCE_ACQUIRE()
+#define MCB_FENCE_RELEASE()
+#endif
+#endif
+
+/** Atomic exchange with acquire / release ordering, no fallback is provided */
+#if !defined(MCB_EXCHANGE) && defined(__GNUC__)
+#define MCB_EXCHANGE(x, val)        __atomic_exchange_n(&(x), (val), __ATOMIC_ACQ_REL)
+#endif
 
 
 /** McbIntf Pin status */
@@ -66,6 +126,20 @@ typedef enum
     MCB_GETINFO_ERROR,
 } Mcb_EStatus;
 
+/** Size of the reply parked on node switches (words), a config frame */
+#define MCB_INTF_PARK_SZ (MCB_FRM_HEAD_SZ + MCB_FRM_MAX_CONFIG_SZ + MCB_FRM_CRC_SZ)
+
+/** Transaction state kept for each node of the bus */
+typedef struct
+{
+    /** Indicates the state of the node transaction */
+    Mcb_EStatus eState;
+    /** Pending data size to be transmitted/received */
+    uint16_t u16Sz;
+    /** Pending bits flag */
+    bool isPending;
+} Mcb_TIntfNode;
+
 /** Motion control communication interface instance */
 typedef struct
 {
@@ -83,14 +157,52 @@ typedef struct
     volatile bool isNewCfgOverCyclic;
     /** Indicates if a config request has been requested over cyclic state */
     volatile bool isCfgOverCyclic;
-    /** Frame pool for holding tx data */
-    Mcb_TFrame tTxfrm;
+    /** Command of the config request in progress over cyclic state */
+    uint16_t u16CfgOverCyclicCmd;
+    /** Config data size of the frames (words) */
+    uint16_t u16CfgSz;
+    /** Frame pool for holding tx data, the last one only holds config frames with zero-copy */
+    Mcb_TFrame tTxfrm[MCB_FRM_TX_NUM];
     /** Frame pool for holding rx data */
-    Mcb_TFrame tRxfrm;
+    Mcb_TFrame tRxfrm[MCB_FRM_PAIRS];
+    /** Tx frame to be assembled, it is never the one on the wire */
+    Mcb_TFrame* ptTxfrm;
+    /** Rx frame of the last completed transfer */
+    Mcb_TFrame* ptRxfrm;
+    /** Frame pair owned by the ongoing transfer */
+    volatile uint8_t u8WireIdx;
+    /** Indicates if the next idle cyclic frame is already assembled, cleared by every transfer */
+    bool isPrepared;
+    /** CRC state after the header and config words of an idle frame */
+    uint16_t u16IdleCrc;
     /** Pending data size to be transmitted/received */
     uint16_t u16Sz;
     /** Pending bits flag */
     bool isPending;
+    /** Node owning the active transaction state (eState, u16Sz & isPending) */
+    uint16_t u16Node;
+    /** Node addressed by the ongoing transfer */
+    volatile uint16_t u16WireNode;
+    /** Node that sent the frame held by ptRxfrm */
+    uint16_t u16RxNode;
+    /** Node addressed by cyclic transfers */
+    uint16_t u16CyclicNode;
+    /** Next request of the pipelined transaction to be sent */
+    uint16_t u16PipeTx;
+    /** Number of acknowledged requests of the pipelined transaction */
+    uint16_t u16PipeAck;
+    /** Requests sent on the last two transfers, the oldest one is answered by the last reply */
+    uint16_t u16PipeWire[2];
+    /** Request whose reply stops the pipelined transaction, clocked out before it ends */
+    uint16_t u16PipeDrain;
+    /** Parked transaction state of each node, only used on node switches */
+    Mcb_TIntfNode tNode[MCB_NUMBER_NODES];
+    /** Node whose reply is parked, MCB_NUMBER_NODES if there is none */
+    uint16_t u16ParkNode;
+    /** Size of the parked reply */
+    uint16_t u16ParkSz;
+    /** Reply received from a node while another node was addressed */
+    uint16_t u16ParkBuf[MCB_INTF_PARK_SZ];
 } Mcb_TIntf;
 
 /**
@@ -146,6 +258,42 @@ Mcb_IntfIsReady(uint16_t u16Id);
 uint16_t
 Mcb_IntfComputeCrc(const uint16_t* pu16Buf, uint16_t u16Sz);
 
+/**
+ * Returns the initial state of an incremental CRC computation.
+ *
+ * @note The incremental functions are used to resume the CRC of frames
+ *       which share a constant beginning. If @ref Mcb_IntfComputeCrc is
+ *       overriden, these functions must be overriden accordingly.
+ *
+ * @retval Initial CRC state
+ */
+uint16_t
+Mcb_IntfCrcInit(void);
+
+/**
+ * Updates an incremental CRC computation with new data.
+ *
+ * @param[in] u16Crc
+ *  Current CRC state
+ * @param[in] pu16Buf
+ *  Pointer to target buffer to compute CRC
+ * @param[in] u16Sz
+ *  Size of the buffer in words
+ * @retval Updated CRC state
+ */
+uint16_t
+Mcb_IntfCrcUpdate(uint16_t u16Crc, const uint16_t* pu16Buf, uint16_t u16Sz);
+
+/**
+ * Finishes an incremental CRC computation.
+ *
+ * @param[in] u16Crc
+ *  Current CRC state
+ * @retval Result of the CRC
+ */
+uint16_t
+Mcb_IntfCrcFinal(uint16_t u16Crc);
+
 /**
  * Checks the CRC of the incoming data.
  * This protocol uses CRC-CCITT (XModem).
@@ -172,7 +320,8 @@ Mcb_GetMillis(void);
 /**
  * Executes a SPI transfer
  *
- * @note Chip select must be managed on this function
+ * @note Chip select must be managed on this function, asserting the one of
+ *       the node selected through @ref Mcb_IntfSelectNode
  *
  * @note Blocking and non-blocking modes are supported
  *
@@ -188,6 +337,20 @@ Mcb_GetMillis(void);
 void
 Mcb_IntfSPITransfer(uint16_t u16Id, uint16_t* pu16In, uint16_t* pu16Out, uint16_t u16Sz);
 
+/**
+ * Selects the node addressed by the next SPI transfer
+ *
+ * @note Called right before @ref Mcb_IntfSPITransfer. The default
+ *       implementation does nothing, so a single chip select is used.
+ *
+ * @param[in] u16Id
+ *  Id of the McbIntf used to identify multiple instances
+ * @param[in] u16Node
+ *  Target node
+ */
+void
+Mcb_IntfSelectNode(uint16_t u16Id, uint16_t u16Node);
+
 /**
  * Generate a pulse on the Sync0 signal for synchronization purpose
  *
@@ -201,6 +364,35 @@ Mcb_IntfSPITransfer(uint16_t u16Id, uint16_t* pu16In, uint16_t* pu16Out, uint16_
 void
 Mcb_IntfSyncSignal(uint16_t u16Id);
 
+/**
+ * Waits for the next IRQ event of an instance
+ *
+ * @note Called by blocking requests while a reply is pending. It behaves as
+ *       a binary semaphore, so it returns immediately if an event has been
+ *       notified since the previous wait. Spurious returns are allowed.
+ *
+ * @note The default implementation returns immediately, so blocking requests
+ *       keep on polling.
+ *
+ * @param[in] u16Id
+ *  Id of the McbIntf used to identify multiple instances
+ * @param[in] u32Timeout
+ *  Maximum time to wait in milliseconds
+ */
+void
+Mcb_IntfWaitEvent(uint16_t u16Id, uint32_t u32Timeout);
+
+/**
+ * Wakes up a caller waiting on @ref Mcb_IntfWaitEvent
+ *
+ * @note Called from @ref Mcb_IntfIRQEvent, so it must be interrupt safe
+ *
+ * @param[in] u16Id
+ *  Id of the McbIntf used to identify multiple instances
+ */
+void
+Mcb_IntfNotifyEvent(uint16_t u16Id);
+
 /**
  * Initialize resource instance
  *
@@ -256,6 +448,10 @@ Mcb_IntfTakeResource(uint16_t u16Id);
 void
 Mcb_IntfReleaseResource(uint16_t u16Id);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* MCB_USR_H */
 
 /** @} */
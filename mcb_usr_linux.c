@@ -0,0 +1,84 @@
+/**
+ * @file mcb_usr_linux.c
+ * @brief Linux reference implementation of the event hooks used by the
+ *        blocking mode
+ *
+ * Blocking requests sleep on a futex until the IRQ event of the instance is
+ * notified, instead of polling. The notification is a plain atomic store
+ * plus a futex wake, so it can be called from a signal handler or from the
+ * thread serving the IRQ line.
+ *
+ * The library sources must be built with MCB_USR_LINUX defined, so the
+ * default hooks of mcb_usr.c do not take precedence in static libraries.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#ifdef __linux__
+
+/** timespec, clock_gettime and syscall are not part of strict C99 */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "mcb_usr.h"
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/** Event flags, one per resource instance. 1 if an event is pending */
+static int i32Event[MCB_NUMBER_RESOURCES];
+
+void Mcb_IntfWaitEvent(uint16_t u16Id, uint32_t u32Timeout)
+{
+    struct timespec tNow;
+    struct timespec tDeadline;
+    struct timespec tLeft;
+
+    if (u16Id < MCB_NUMBER_RESOURCES)
+    {
+        (void)clock_gettime(CLOCK_MONOTONIC, &tDeadline);
+        tDeadline.tv_sec += (time_t)(u32Timeout / 1000UL);
+        tDeadline.tv_nsec += (long)((u32Timeout % 1000UL) * 1000000UL);
+        if (tDeadline.tv_nsec >= 1000000000L)
+        {
+            tDeadline.tv_sec++;
+            tDeadline.tv_nsec -= 1000000000L;
+        }
+
+        /** Consume a pending event or sleep until it is notified */
+        while (__atomic_exchange_n(&i32Event[u16Id], 0, __ATOMIC_ACQUIRE) == 0)
+        {
+            /** Interrupted and spurious wakeups only wait for the time left */
+            (void)clock_gettime(CLOCK_MONOTONIC, &tNow);
+            tLeft.tv_sec = tDeadline.tv_sec - tNow.tv_sec;
+            tLeft.tv_nsec = tDeadline.tv_nsec - tNow.tv_nsec;
+            if (tLeft.tv_nsec < 0L)
+            {
+                tLeft.tv_sec--;
+                tLeft.tv_nsec += 1000000000L;
+            }
+
+            if ((tLeft.tv_sec < (time_t)0)
+                || ((syscall(SYS_futex, &i32Event[u16Id], FUTEX_WAIT_PRIVATE, 0, &tLeft, NULL, 0) != 0)
+                    && (errno == ETIMEDOUT)))
+            {
+                break;
+            }
+        }
+    }
+}
+
+void Mcb_IntfNotifyEvent(uint16_t u16Id)
+{
+    if (u16Id < MCB_NUMBER_RESOURCES)
+    {
+        __atomic_store_n(&i32Event[u16Id], 1, __ATOMIC_RELEASE);
+        (void)syscall(SYS_futex, &i32Event[u16Id], FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,119 @@
+/**
+ * @file mcb_bench_crc.c
+ * @brief Benchmark of the word oriented slicing-by-8 CRC-CCITT routine
+ *
+ * Frames from 5 words (header, config and CRC) up to 38 words (header, config,
+ * full cyclic area and CRC) are checked against the bit by bit reference, and
+ * then timed with the byte oriented table routine and crc_ccitt_words.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test.h"
+#include "mcb_checksum.h"
+
+/** Frames of each size, so the timing does not depend on a single pattern */
+#define BENCH_FRAMES        (uint16_t)64U
+/** Passes over the frames of a size */
+#define BENCH_PASSES        (uint32_t)1000UL
+/** Smallest and largest frame (words) */
+#define BENCH_MIN_WORDS     (uint16_t)5U
+#define BENCH_MAX_WORDS     (uint16_t)38U
+
+static uint16_t u16Frame[BENCH_FRAMES][BENCH_MAX_WORDS];
+
+/** Sink of the computed CRCs, so the loops are not optimized out */
+static volatile uint16_t u16Sink;
+
+/**
+ * Byte oriented CRC of a word buffer, as computed before the word routine
+ *
+ * @param[in] u16Crc
+ *  CRC state to be updated
+ * @param[in] pu16Buf
+ *  Words, most significant byte first
+ * @param[in] szWords
+ *  Number of words
+ *
+ * @retval Updated CRC state
+ */
+static uint16_t
+Mcb_BenchCrcBytes(uint16_t u16Crc, const uint16_t* pu16Buf, size_t szWords);
+
+/**
+ * Times a CRC routine over the frames of a size
+ *
+ * @param[in] pfCrc
+ *  CRC routine
+ * @param[in] u16Words
+ *  Frame size (words)
+ *
+ * @retval nanoseconds per word
+ */
+static double
+Mcb_BenchRun(uint16_t (*pfCrc)(uint16_t u16Crc, const uint16_t* pu16Buf, size_t szWords), uint16_t u16Words);
+
+int main(void)
+{
+    uint32_t u32Seed = (uint32_t)0x1D0FUL;
+    uint16_t u16Ref;
+
+    for (uint16_t u16Frm = (uint16_t)0U; u16Frm < BENCH_FRAMES; u16Frm++)
+    {
+        for (uint16_t u16Idx = (uint16_t)0U; u16Idx < BENCH_MAX_WORDS; u16Idx++)
+        {
+            u16Frame[u16Frm][u16Idx] = (uint16_t)Mcb_TestRand(&u32Seed);
+        }
+    }
+
+    printf("%6s %12s %12s %8s\n", "words", "bytewise", "slicing-8", "speedup");
+
+    for (uint16_t u16Words = BENCH_MIN_WORDS; u16Words <= BENCH_MAX_WORDS; u16Words++)
+    {
+        /** Results must be bit identical before timing anything */
+        for (uint16_t u16Frm = (uint16_t)0U; u16Frm < BENCH_FRAMES; u16Frm++)
+        {
+            u16Ref = Mcb_TestCrcRef(CRC_START_XMODEM, u16Frame[u16Frm], u16Words);
+            MCB_TEST_CHECK(Mcb_BenchCrcBytes(CRC_START_XMODEM, u16Frame[u16Frm], u16Words) == u16Ref);
+            MCB_TEST_CHECK(crc_ccitt_words(CRC_START_XMODEM, u16Frame[u16Frm], u16Words) == u16Ref);
+        }
+
+        double dByte = Mcb_BenchRun(Mcb_BenchCrcBytes, u16Words);
+        double dSlice = Mcb_BenchRun(crc_ccitt_words, u16Words);
+
+        printf("%6u %9.2f ns %9.2f ns %7.2fx\n", (unsigned)u16Words, dByte, dSlice,
+               (dSlice > 0.0) ? (dByte / dSlice) : 0.0);
+    }
+
+    return Mcb_TestResult();
+}
+
+static uint16_t Mcb_BenchCrcBytes(uint16_t u16Crc, const uint16_t* pu16Buf, size_t szWords)
+{
+    for (size_t szIdx = 0U; szIdx < szWords; szIdx++)
+    {
+        u16Crc = update_crc_ccitt(u16Crc, (unsigned char)(pu16Buf[szIdx] >> 8U));
+        u16Crc = update_crc_ccitt(u16Crc, (unsigned char)(pu16Buf[szIdx] & 0xFFU));
+    }
+
+    return u16Crc;
+}
+
+static double Mcb_BenchRun(uint16_t (*pfCrc)(uint16_t u16Crc, const uint16_t* pu16Buf, size_t szWords), uint16_t u16Words)
+{
+    uint16_t u16Crc = (uint16_t)0U;
+    uint64_t u64Start = Mcb_TestNanos();
+
+    for (uint32_t u32Pass = (uint32_t)0UL; u32Pass < BENCH_PASSES; u32Pass++)
+    {
+        for (uint16_t u16Frm = (uint16_t)0U; u16Frm < BENCH_FRAMES; u16Frm++)
+        {
+            u16Crc ^= pfCrc(CRC_START_XMODEM, u16Frame[u16Frm], u16Words);
+        }
+    }
+
+    u16Sink = u16Crc;
+
+    return (double)(Mcb_TestNanos() - u64Start) / ((double)BENCH_PASSES * BENCH_FRAMES * u16Words);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file mcb_bench_crc_cyclic.c
+ * @brief Benchmark of the incremental CRC of idle cyclic frames
+ *
+ * Idle cyclic frames are assembled as on every cycle, computing the CRC of
+ * the whole frame and resuming it from the cached state of the header and
+ * config words. Both frames must be bit identical, the time saved per cycle
+ * is reported for every config size with the full cyclic area.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test.h"
+#include "mcb_frame.h"
+#include "mcb_usr.h"
+#include <string.h>
+
+/** Assembled cycles of each measure */
+#define BENCH_CYCLES        (uint32_t)200000UL
+
+/** Sink of the assembled frames, so the loops are not optimized out */
+static volatile uint16_t u16Sink;
+
+/**
+ * Assembles an idle cyclic frame
+ *
+ * @param[out] ptFrame
+ *  Destination frame
+ * @param[in] pu16Cyclic
+ *  Cyclic words
+ * @param[in] u16CyclicSz
+ *  Cyclic size (words)
+ * @param[in] isResume
+ *  true to resume the CRC from u16IdleCrc, false to compute it from scratch
+ * @param[in] u16IdleCrc
+ *  CRC state of the header and config words
+ */
+static void
+Mcb_BenchFrame(Mcb_TFrame* ptFrame, const uint16_t* pu16Cyclic, uint16_t u16CyclicSz, bool isResume,
+               uint16_t u16IdleCrc);
+
+/**
+ * Times the assembly of idle cyclic frames
+ *
+ * @param[in] u16CfgSz
+ *  Config size (words)
+ * @param[in] isResume
+ *  true to resume the CRC, false to compute it from scratch
+ *
+ * @retval nanoseconds per cycle
+ */
+static double
+Mcb_BenchRun(uint16_t u16CfgSz, bool isResume);
+
+int main(void)
+{
+    Mcb_TFrame tFull;
+    Mcb_TFrame tResumed;
+    uint16_t u16Cyclic[MCB_FRM_MAX_CYCLIC_SZ];
+    uint32_t u32Seed = (uint32_t)0xC0FFEEUL;
+
+    for (uint16_t u16CfgSz = MCB_FRM_CONFIG_SZ; u16CfgSz <= MCB_FRM_MAX_CONFIG_SZ; u16CfgSz <<= 1U)
+    {
+        tFull.u16CfgSz = u16CfgSz;
+        tResumed.u16CfgSz = u16CfgSz;
+
+        Mcb_FrameCreateConfig(&tResumed, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, false);
+        uint16_t u16IdleCrc = Mcb_IntfCrcUpdate(Mcb_IntfCrcInit(), tResumed.u16Buf, tResumed.u16Sz);
+
+        /** Every cyclic size gives the very same frame */
+        for (uint16_t u16CyclicSz = (uint16_t)1U; u16CyclicSz <= MCB_FRM_MAX_CYCLIC_SZ; u16CyclicSz++)
+        {
+            for (uint16_t u16Idx = (uint16_t)0U; u16Idx < u16CyclicSz; u16Idx++)
+            {
+                u16Cyclic[u16Idx] = (uint16_t)Mcb_TestRand(&u32Seed);
+            }
+
+            Mcb_BenchFrame(&tFull, u16Cyclic, u16CyclicSz, false, u16IdleCrc);
+            Mcb_BenchFrame(&tResumed, u16Cyclic, u16CyclicSz, true, u16IdleCrc);
+
+            MCB_TEST_CHECK(tFull.u16Sz == tResumed.u16Sz);
+            MCB_TEST_CHECK(memcmp(tFull.u16Buf, tResumed.u16Buf, (tFull.u16Sz * sizeof(uint16_t))) == 0);
+            MCB_TEST_CHECK(tResumed.u16Buf[tResumed.u16Sz - 1U]
+                           == Mcb_TestCrcRef(Mcb_IntfCrcInit(), tResumed.u16Buf, (tResumed.u16Sz - 1U)));
+        }
+    }
+
+    printf("cyclic %u words\n", (unsigned)MCB_FRM_MAX_CYCLIC_SZ);
+    printf("%8s %12s %12s %12s\n", "config", "full", "resumed", "saved");
+
+    for (uint16_t u16CfgSz = MCB_FRM_CONFIG_SZ; u16CfgSz <= MCB_FRM_MAX_CONFIG_SZ; u16CfgSz <<= 1U)
+    {
+        double dFull = Mcb_BenchRun(u16CfgSz, false);
+        double dResumed = Mcb_BenchRun(u16CfgSz, true);
+
+        printf("%8u %9.1f ns %9.1f ns %9.1f ns\n", (unsigned)u16CfgSz, dFull, dResumed, (dFull - dResumed));
+    }
+
+    return Mcb_TestResult();
+}
+
+static void Mcb_BenchFrame(Mcb_TFrame* ptFrame, const uint16_t* pu16Cyclic, uint16_t u16CyclicSz, bool isResume,
+                           uint16_t u16IdleCrc)
+{
+    Mcb_FrameCreateConfig(ptFrame, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, false);
+
+    if (isResume != false)
+    {
+        Mcb_FrameAppendCyclicCrc(ptFrame, pu16Cyclic, u16CyclicSz, u16IdleCrc);
+    }
+    else
+    {
+        Mcb_FrameAppendCyclic(ptFrame, pu16Cyclic, u16CyclicSz, true);
+    }
+}
+
+static double Mcb_BenchRun(uint16_t u16CfgSz, bool isResume)
+{
+    Mcb_TFrame tFrame;
+    uint16_t u16Cyclic[MCB_FRM_MAX_CYCLIC_SZ];
+    uint16_t u16Crc = (uint16_t)0U;
+
+    memset((void*)u16Cyclic, 0x5A, sizeof(u16Cyclic));
+    tFrame.u16CfgSz = u16CfgSz;
+    Mcb_FrameCreateConfig(&tFrame, 0, MCB_REQ_IDLE, MCB_FRM_NOTSEG, NULL, false);
+    uint16_t u16IdleCrc = Mcb_IntfCrcUpdate(Mcb_IntfCrcInit(), tFrame.u16Buf, tFrame.u16Sz);
+
+    uint64_t u64Start = Mcb_TestNanos();
+
+    for (uint32_t u32Cycle = (uint32_t)0UL; u32Cycle < BENCH_CYCLES; u32Cycle++)
+    {
+        /** Setpoints change on every cycle */
+        u16Cyclic[0] = (uint16_t)u32Cycle;
+        Mcb_BenchFrame(&tFrame, u16Cyclic, MCB_FRM_MAX_CYCLIC_SZ, isResume, u16IdleCrc);
+        u16Crc ^= tFrame.u16Buf[tFrame.u16Sz - 1U];
+    }
+
+    u16Sink = u16Crc;
+
+    return (double)(Mcb_TestNanos() - u64Start) / (double)BENCH_CYCLES;
+}
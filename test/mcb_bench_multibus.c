@@ -0,0 +1,237 @@
+/**
+ * @file mcb_bench_multibus.c
+ * @brief Benchmark of independent buses driven from their own threads
+ *
+ * From 1 to MCB_NUMBER_RESOURCES buses, each one with its instance, its
+ * simulated slave and its thread, run config reads and then cyclic frames
+ * with config over cyclic reads. Every slave holds values tagged with its
+ * bus id, so state shared between the instances shows up as wrong values.
+ * Both phases start at once on every bus and are timed until the slowest
+ * bus is done. The aggregated throughput is reported against the one of a
+ * single bus, the ideal scaling being the number of buses while there are
+ * enough cpus.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include <pthread.h>
+#include <unistd.h>
+
+#define BENCH_NODE          (uint16_t)1U
+#define BENCH_ADDR_SETPOINT (uint16_t)0x100U
+#define BENCH_ADDR_ACTUAL   (uint16_t)0x200U
+#define BENCH_ADDR_TAG      (uint16_t)0x300U
+/** Config reads and cyclic frames of each bus */
+#define BENCH_READS         (uint32_t)100000UL
+#define BENCH_CYCLES        (uint32_t)100000UL
+
+/** Bus driven by a thread */
+typedef struct
+{
+    /** Instance, first member so completion callbacks get back to the bus */
+    Mcb_TInst tInst;
+    /** Bus id */
+    uint16_t u16Id;
+    /** Config over cyclic read in progress */
+    volatile bool isCfgBusy;
+    /** Completed config over cyclic reads */
+    uint32_t u32CfgDone;
+    /** Values not matching the bus tag */
+    uint32_t u32Errors;
+} Mcb_TBenchBus;
+
+static Mcb_TBenchBus tBus[MCB_NUMBER_RESOURCES];
+
+/** Start and end of each phase, shared by the bus threads and the main one */
+static pthread_barrier_t tBarrier;
+
+/**
+ * Gets the tag of a bus
+ *
+ * @param[in] u16Id
+ *  Bus id
+ *
+ * @retval Tag held by the registers of the bus slave
+ */
+static uint16_t
+Mcb_BenchTag(uint16_t u16Id);
+
+/**
+ * Runs the config reads and the cyclic frames of a bus
+ *
+ * @param[in] pArg
+ *  Bus
+ *
+ * @retval NULL
+ */
+static void*
+Mcb_BenchThread(void* pArg);
+
+/**
+ * Checks the reply of a config over cyclic read
+ *
+ * @param[in] ptInst
+ *  Instance of the bus
+ * @param[in] pMcbMsg
+ *  Reply
+ */
+static void
+Mcb_BenchCfgEvnt(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+
+int main(void)
+{
+    pthread_t tThread[MCB_NUMBER_RESOURCES];
+    double dReadBase = 0.0;
+    double dCyclicBase = 0.0;
+
+    printf("%u buses, %ld cpus online\n", (unsigned)MCB_NUMBER_RESOURCES, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%6s %14s %8s %14s %8s\n", "buses", "reads/s", "scaling", "cycles/s", "scaling");
+
+    for (uint16_t u16Buses = (uint16_t)1U; u16Buses <= MCB_NUMBER_RESOURCES; u16Buses++)
+    {
+        uint64_t u64Read;
+        uint64_t u64Cyclic;
+
+        Mcb_SimInit();
+        for (uint16_t u16Id = (uint16_t)0U; u16Id < u16Buses; u16Id++)
+        {
+            uint16_t u16Tag = Mcb_BenchTag(u16Id);
+
+            tBus[u16Id].u16Id = u16Id;
+            tBus[u16Id].isCfgBusy = false;
+            tBus[u16Id].u32CfgDone = (uint32_t)0UL;
+            tBus[u16Id].u32Errors = (uint32_t)0UL;
+            Mcb_SimAttach(u16Id, &tBus[u16Id].tInst.tIntf);
+            Mcb_SimSetReg(u16Id, BENCH_NODE, BENCH_ADDR_TAG, &u16Tag, (uint16_t)1U);
+            Mcb_SimSetReg(u16Id, BENCH_NODE, BENCH_ADDR_ACTUAL, &u16Tag, (uint16_t)1U);
+        }
+
+        (void)pthread_barrier_init(&tBarrier, NULL, (unsigned)(u16Buses + 1U));
+        for (uint16_t u16Id = (uint16_t)0U; u16Id < u16Buses; u16Id++)
+        {
+            MCB_TEST_CHECK(pthread_create(&tThread[u16Id], NULL, Mcb_BenchThread, &tBus[u16Id]) == 0);
+        }
+
+        /** Config reads */
+        (void)pthread_barrier_wait(&tBarrier);
+        u64Read = Mcb_TestNanos();
+        (void)pthread_barrier_wait(&tBarrier);
+        u64Read = Mcb_TestNanos() - u64Read;
+
+        /** Mapping and cyclic start, not timed, then cyclic frames */
+        (void)pthread_barrier_wait(&tBarrier);
+        u64Cyclic = Mcb_TestNanos();
+        (void)pthread_barrier_wait(&tBarrier);
+        u64Cyclic = Mcb_TestNanos() - u64Cyclic;
+
+        for (uint16_t u16Id = (uint16_t)0U; u16Id < u16Buses; u16Id++)
+        {
+            (void)pthread_join(tThread[u16Id], NULL);
+            MCB_TEST_CHECK(tBus[u16Id].u32Errors == (uint32_t)0UL);
+            MCB_TEST_CHECK(tBus[u16Id].u32CfgDone > (uint32_t)0UL);
+        }
+        (void)pthread_barrier_destroy(&tBarrier);
+
+        double dReads = ((double)BENCH_READS * u16Buses) / ((double)u64Read / 1e9);
+        double dCycles = ((double)BENCH_CYCLES * u16Buses) / ((double)u64Cyclic / 1e9);
+        if (u16Buses == (uint16_t)1U)
+        {
+            dReadBase = dReads;
+            dCyclicBase = dCycles;
+        }
+
+        printf("%6u %14.0f %7.2fx %14.0f %7.2fx\n", (unsigned)u16Buses, dReads, (dReads / dReadBase),
+               dCycles, (dCycles / dCyclicBase));
+    }
+
+    return Mcb_TestResult();
+}
+
+static uint16_t Mcb_BenchTag(uint16_t u16Id)
+{
+    return (uint16_t)(0xB000U | u16Id);
+}
+
+static void* Mcb_BenchThread(void* pArg)
+{
+    Mcb_TBenchBus* ptBus = (Mcb_TBenchBus*)pArg;
+    Mcb_TInst* ptInst = &ptBus->tInst;
+    uint16_t u16Tag = Mcb_BenchTag(ptBus->u16Id);
+    uint16_t* pu16Setpoint = NULL;
+    uint16_t* pu16Actual = NULL;
+    bool isReady;
+    Mcb_EStatus eCfgStat;
+    Mcb_TMsg tMsg;
+
+    isReady = (Mcb_Init(ptInst, MCB_NON_BLOCKING, ptBus->u16Id, true, (uint32_t)1000UL) == MCB_INIT_OK);
+    Mcb_SetNode(ptInst, BENCH_NODE);
+    Mcb_AttachCfgOverCyclicCB(ptInst, Mcb_BenchCfgEvnt);
+
+    /** Config reads */
+    (void)pthread_barrier_wait(&tBarrier);
+    for (uint32_t u32Read = (uint32_t)0UL; (isReady != false) && (u32Read < BENCH_READS); u32Read++)
+    {
+        tMsg.u16Node = BENCH_NODE;
+        tMsg.u16Addr = BENCH_ADDR_TAG;
+        do
+        {
+            ptInst->Mcb_Read(ptInst, &tMsg);
+        } while ((tMsg.eStatus != MCB_READ_SUCCESS) && (tMsg.eStatus != MCB_READ_ERROR));
+
+        if ((tMsg.eStatus != MCB_READ_SUCCESS) || (tMsg.u16Data[0] != u16Tag))
+        {
+            ptBus->u32Errors++;
+        }
+    }
+    (void)pthread_barrier_wait(&tBarrier);
+
+    if (isReady != false)
+    {
+        pu16Setpoint = (uint16_t*)Mcb_RxMap(ptInst, BENCH_ADDR_SETPOINT, (uint16_t)2U);
+        pu16Actual = (uint16_t*)Mcb_TxMap(ptInst, BENCH_ADDR_ACTUAL, (uint16_t)2U);
+        isReady = ((pu16Setpoint != NULL) && (pu16Actual != NULL) && (Mcb_EnableCyclic(ptInst) > 0));
+    }
+    if (isReady == false)
+    {
+        ptBus->u32Errors++;
+    }
+
+    /** Cyclic frames, with a config over cyclic read whenever the last one is done */
+    (void)pthread_barrier_wait(&tBarrier);
+    for (uint32_t u32Cycle = (uint32_t)0UL; (isReady != false) && (u32Cycle < BENCH_CYCLES); u32Cycle++)
+    {
+        if (ptBus->isCfgBusy == false)
+        {
+            tMsg.u16Node = BENCH_NODE;
+            tMsg.u16Addr = BENCH_ADDR_TAG;
+            tMsg.u16Size = (uint16_t)1U;
+            ptBus->isCfgBusy = true;
+            ptInst->Mcb_Read(ptInst, &tMsg);
+        }
+
+        *pu16Setpoint = (uint16_t)u32Cycle;
+        if ((Mcb_CyclicProcessLatch(ptInst, &eCfgStat) == false) || (Mcb_CyclicFrameProcess(ptInst) == false)
+            || (*pu16Actual != u16Tag))
+        {
+            ptBus->u32Errors++;
+        }
+    }
+    (void)pthread_barrier_wait(&tBarrier);
+
+    return NULL;
+}
+
+static void Mcb_BenchCfgEvnt(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
+{
+    Mcb_TBenchBus* ptBus = (Mcb_TBenchBus*)ptInst;
+
+    if ((pMcbMsg->eStatus != MCB_READ_SUCCESS) || (pMcbMsg->u16Data[0] != Mcb_BenchTag(ptBus->u16Id)))
+    {
+        ptBus->u32Errors++;
+    }
+
+    ptBus->u32CfgDone++;
+    ptBus->isCfgBusy = false;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file mcb_bench_wait.c
+ * @brief Benchmark of the CPU time spent by blocking requests waiting for
+ *        the slave
+ *
+ * The simulated slave raises the IRQ event of every transfer from another
+ * thread, after a fixed reply latency. Blocking reads are timed on the wall
+ * clock and on the CPU clock of the calling thread. Built with the Linux
+ * event hooks, the caller sleeps on a futex until the IRQ event. Built with
+ * MCB_BENCH_POLL, the hooks are the default ones and the caller keeps on
+ * polling, so it is busy for the whole latency.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include <pthread.h>
+#include <time.h>
+
+#define BENCH_NODE          (uint16_t)1U
+#define BENCH_ADDR_TAG      (uint16_t)0x300U
+#define BENCH_TAG           (uint16_t)0xC0DEU
+/** Blocking reads timed, two transfers each */
+#define BENCH_READS         (uint32_t)2000UL
+/** Time between the end of a transfer and its IRQ event (ns) */
+#define BENCH_LATENCY_NS    100000L
+/** Period of the IRQ thread checks while there is no transfer (ns) */
+#define BENCH_IDLE_NS       10000L
+
+static Mcb_TInst tInst;
+
+/** Set once the reads are done, the IRQ thread stops */
+static volatile bool isBenchDone;
+
+/**
+ * Raises the IRQ event of every transfer after the reply latency
+ *
+ * @param[in] pArg
+ *  Not used
+ *
+ * @retval NULL
+ */
+static void*
+Mcb_BenchIrq(void* pArg);
+
+/**
+ * Sleeps the calling thread
+ *
+ * @param[in] i32Nanos
+ *  Time to sleep (ns), below one second
+ */
+static void
+Mcb_BenchSleep(int32_t i32Nanos);
+
+/**
+ * Gets the CPU time consumed by the calling thread
+ *
+ * @retval nanoseconds
+ */
+static uint64_t
+Mcb_BenchCpuNanos(void);
+
+#ifdef MCB_BENCH_POLL
+/** Same behaviour as the default hooks, they replace the Linux ones */
+void Mcb_IntfWaitEvent(uint16_t u16Id, uint32_t u32Timeout)
+{
+    (void)u16Id;
+    (void)u32Timeout;
+}
+
+void Mcb_IntfNotifyEvent(uint16_t u16Id)
+{
+    (void)u16Id;
+}
+#endif
+
+int main(void)
+{
+    pthread_t tIrq;
+    Mcb_TMsg tMsg;
+    uint32_t u32Errors = (uint32_t)0UL;
+    uint64_t u64Wall;
+    uint64_t u64Cpu;
+    uint16_t u16Tag = BENCH_TAG;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    Mcb_SimDeferIrq(0, true);
+    Mcb_SimSetReg(0, BENCH_NODE, BENCH_ADDR_TAG, &u16Tag, (uint16_t)1U);
+
+    isBenchDone = false;
+    MCB_TEST_CHECK(pthread_create(&tIrq, NULL, Mcb_BenchIrq, NULL) == 0);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)1000UL) == MCB_INIT_OK);
+
+    u64Wall = Mcb_TestNanos();
+    u64Cpu = Mcb_BenchCpuNanos();
+    for (uint32_t u32Read = (uint32_t)0UL; u32Read < BENCH_READS; u32Read++)
+    {
+        tMsg.u16Node = BENCH_NODE;
+        tMsg.u16Addr = BENCH_ADDR_TAG;
+        tInst.Mcb_Read(&tInst, &tMsg);
+
+        if ((tMsg.eStatus != MCB_READ_SUCCESS) || (tMsg.u16Data[0] != BENCH_TAG))
+        {
+            u32Errors++;
+        }
+    }
+    u64Cpu = Mcb_BenchCpuNanos() - u64Cpu;
+    u64Wall = Mcb_TestNanos() - u64Wall;
+
+    isBenchDone = true;
+    (void)pthread_join(tIrq, NULL);
+    Mcb_Deinit(&tInst);
+    MCB_TEST_CHECK(u32Errors == (uint32_t)0UL);
+
+#ifdef MCB_BENCH_POLL
+    printf("wait mode           polling\n");
+#else
+    printf("wait mode           event hooks\n");
+#endif
+    printf("reply latency     %8.1f us\n", ((double)BENCH_LATENCY_NS / 1e3));
+    printf("wall time / read  %8.1f us\n", (((double)u64Wall / 1e3) / (double)BENCH_READS));
+    printf("cpu time / read   %8.1f us\n", (((double)u64Cpu / 1e3) / (double)BENCH_READS));
+    printf("caller busy       %8.1f %%\n", ((100.0 * (double)u64Cpu) / (double)u64Wall));
+
+    return Mcb_TestResult();
+}
+
+static void* Mcb_BenchIrq(void* pArg)
+{
+    (void)pArg;
+
+    while (isBenchDone == false)
+    {
+        if (Mcb_SimTakeIrq(0) != false)
+        {
+            Mcb_BenchSleep(BENCH_LATENCY_NS);
+            Mcb_IntfIRQEvent(&tInst.tIntf);
+        }
+        else
+        {
+            Mcb_BenchSleep(BENCH_IDLE_NS);
+        }
+    }
+
+    return NULL;
+}
+
+static void Mcb_BenchSleep(int32_t i32Nanos)
+{
+    struct timespec tSleep;
+
+    tSleep.tv_sec = (time_t)0;
+    tSleep.tv_nsec = (long)i32Nanos;
+    (void)nanosleep(&tSleep, NULL);
+}
+
+static uint64_t Mcb_BenchCpuNanos(void)
+{
+    struct timespec tNow;
+
+    (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tNow);
+
+    return ((uint64_t)tNow.tv_sec * 1000000000ULL) + (uint64_t)tNow.tv_nsec;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file mcb_footprint.c
+ * @brief Memory footprint report of a library configuration
+ *
+ * Prints the size of the instance, interface and frame structures, and the
+ * stack high-water mark of a simulated session: config reads and writes on
+ * two nodes, a batch mapping, cyclic frames with config over cyclic traffic
+ * and a batch read. The session runs on a thread whose stack is painted
+ * beforehand, the mark is the deepest byte overwritten, less the one of a
+ * thread doing nothing.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include "mcb_intf.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FOOT_NODE           (uint16_t)1U
+#define FOOT_ADDR_SETPOINT  (uint16_t)0x100U
+#define FOOT_ADDR_ACTUAL    (uint16_t)0x200U
+#define FOOT_ADDR_CONFIG    (uint16_t)0x300U
+/** Value of the registers written and read */
+#define FOOT_VALUE          (uint16_t)0x1234U
+/** Registers read in a batch */
+#define FOOT_BATCH          (uint16_t)8U
+/** Cyclic frames of the session */
+#define FOOT_CYCLES         (uint16_t)64U
+/** Painted stack of the session thread */
+#define FOOT_STACK_SZ       (size_t)(256U * 1024U)
+#define FOOT_PAINT          (uint8_t)0xA5U
+
+static Mcb_TInst tInst;
+
+/** Set once the config over cyclic request is completed */
+static bool isCfgDone;
+
+/**
+ * Runs a session on a thread with a painted stack
+ *
+ * @param[in] Session
+ *  Thread body
+ *
+ * @retval Bytes of stack used
+ */
+static size_t
+Mcb_FootStack(void* (*Session)(void* pArg));
+
+/**
+ * Does nothing, stack used by the thread itself
+ *
+ * @param[in] pArg
+ *  Not used
+ *
+ * @retval NULL
+ */
+static void*
+Mcb_FootIdle(void* pArg);
+
+/**
+ * Runs the simulated session
+ *
+ * @param[in] pArg
+ *  Not used
+ *
+ * @retval NULL
+ */
+static void*
+Mcb_FootSession(void* pArg);
+
+/**
+ * Flags the completion of the config over cyclic request
+ *
+ * @param[in] ptInst
+ *  Instance
+ * @param[in] pMcbMsg
+ *  Reply
+ */
+static void
+Mcb_FootCompl(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+
+int main(void)
+{
+    uint16_t u16Value = FOOT_VALUE;
+
+    /** Slaves allocate their registers on first use, done here so the session does not count the heap */
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    Mcb_SimSetReg(0, FOOT_NODE, FOOT_ADDR_ACTUAL, &u16Value, (uint16_t)1U);
+    Mcb_SimSetReg(0, (uint16_t)(FOOT_NODE + 1U), FOOT_ADDR_ACTUAL, &u16Value, (uint16_t)1U);
+
+    size_t szIdle = Mcb_FootStack(Mcb_FootIdle);
+    size_t szSession = Mcb_FootStack(Mcb_FootSession);
+
+#ifdef MCB_COMPACT
+    printf("configuration       compact\n");
+#else
+    printf("configuration       default\n");
+#endif
+    printf("sizeof(Mcb_TInst)   %6lu\n", (unsigned long)sizeof(Mcb_TInst));
+    printf("sizeof(Mcb_TIntf)   %6lu\n", (unsigned long)sizeof(Mcb_TIntf));
+    printf("sizeof(Mcb_TFrame)  %6lu\n", (unsigned long)sizeof(Mcb_TFrame));
+    printf("stack high-water    %6lu\n", (unsigned long)((szSession > szIdle) ? (szSession - szIdle) : 0U));
+
+    return Mcb_TestResult();
+}
+
+static size_t Mcb_FootStack(void* (*Session)(void* pArg))
+{
+    pthread_attr_t tAttr;
+    pthread_t tThread;
+    uint8_t* pu8Stack = NULL;
+    size_t szUsed = (size_t)0U;
+
+    if (posix_memalign((void**)&pu8Stack, (size_t)4096U, FOOT_STACK_SZ) != 0)
+    {
+        MCB_TEST_CHECK(false);
+        return szUsed;
+    }
+    memset((void*)pu8Stack, FOOT_PAINT, FOOT_STACK_SZ);
+
+    (void)pthread_attr_init(&tAttr);
+    MCB_TEST_CHECK(pthread_attr_setstack(&tAttr, (void*)pu8Stack, FOOT_STACK_SZ) == 0);
+    MCB_TEST_CHECK(pthread_create(&tThread, &tAttr, Session, NULL) == 0);
+    (void)pthread_join(tThread, NULL);
+    (void)pthread_attr_destroy(&tAttr);
+
+    /** The stack grows down, the lowest overwritten byte is the deepest one */
+    for (size_t szIdx = (size_t)0U; szIdx < FOOT_STACK_SZ; szIdx++)
+    {
+        if (pu8Stack[szIdx] != FOOT_PAINT)
+        {
+            szUsed = FOOT_STACK_SZ - szIdx;
+            break;
+        }
+    }
+    free(pu8Stack);
+
+    return szUsed;
+}
+
+static void* Mcb_FootIdle(void* pArg)
+{
+    (void)pArg;
+
+    return NULL;
+}
+
+static void* Mcb_FootSession(void* pArg)
+{
+    /** Kept off the stack, only the library is measured */
+    static uint16_t u16Addr[FOOT_BATCH];
+    static Mcb_TMsg tMsg[FOOT_BATCH];
+    Mcb_TMapEntry tRx[1];
+    Mcb_TMapEntry tTx[1];
+    Mcb_EStatus eCfgStat;
+    uint16_t u16Snap[1];
+    uint16_t u16Value = FOOT_VALUE;
+    uint16_t u16Cycle;
+
+    (void)pArg;
+
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    Mcb_SetNode(&tInst, FOOT_NODE);
+
+    /** Config traffic on two nodes */
+    for (uint16_t u16Node = FOOT_NODE; u16Node <= (uint16_t)(FOOT_NODE + 1U); u16Node++)
+    {
+        tMsg[0].u16Node = u16Node;
+        tMsg[0].u16Addr = FOOT_ADDR_CONFIG;
+        tMsg[0].u16Size = (uint16_t)1U;
+        tMsg[0].u16Data[0] = u16Value;
+        do
+        {
+            tInst.Mcb_Write(&tInst, &tMsg[0]);
+        } while ((tMsg[0].eStatus != MCB_WRITE_SUCCESS) && (tMsg[0].eStatus != MCB_WRITE_ERROR));
+        MCB_TEST_CHECK(tMsg[0].eStatus == MCB_WRITE_SUCCESS);
+        do
+        {
+            tInst.Mcb_Read(&tInst, &tMsg[0]);
+        } while ((tMsg[0].eStatus != MCB_READ_SUCCESS) && (tMsg[0].eStatus != MCB_READ_ERROR));
+        MCB_TEST_CHECK((tMsg[0].eStatus == MCB_READ_SUCCESS) && (tMsg[0].u16Data[0] == u16Value));
+    }
+
+    /** Cyclic frames, with a config over cyclic read, then back to config mode */
+    tRx[0].u16Addr = FOOT_ADDR_SETPOINT;
+    tRx[0].u16Sz = (uint16_t)2U;
+    tTx[0].u16Addr = FOOT_ADDR_ACTUAL;
+    tTx[0].u16Sz = (uint16_t)2U;
+    MCB_TEST_CHECK(Mcb_MapBatch(&tInst, tRx, (uint8_t)1U, tTx, (uint8_t)1U) > 0);
+
+    tMsg[0].u16Node = FOOT_NODE;
+    tMsg[0].u16Addr = FOOT_ADDR_CONFIG;
+    tMsg[0].u16Size = (uint16_t)1U;
+    tMsg[0].ComplEvnt = Mcb_FootCompl;
+    tMsg[0].pUsrCtx = NULL;
+    isCfgDone = false;
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[0], false) != false);
+    for (u16Cycle = (uint16_t)0U; u16Cycle < FOOT_CYCLES; u16Cycle++)
+    {
+        MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+        MCB_TEST_CHECK(Mcb_CyclicFrameProcess(&tInst) != false);
+    }
+    MCB_TEST_CHECK(isCfgDone != false);
+    (void)Mcb_CyclicRxSnapshot(&tInst, u16Snap, (uint16_t)1U);
+    MCB_TEST_CHECK(u16Snap[0] == u16Value);
+
+    (void)Mcb_DisableCyclic(&tInst);
+    for (u16Cycle = (uint16_t)0U; u16Cycle < FOOT_CYCLES; u16Cycle++)
+    {
+        if (Mcb_CyclicProcessLatch(&tInst, &eCfgStat) == false)
+        {
+            break;
+        }
+        (void)Mcb_CyclicFrameProcess(&tInst);
+    }
+    MCB_TEST_CHECK(Mcb_SimIsCyclic(0, FOOT_NODE) == false);
+    Mcb_Deinit(&tInst);
+
+    /** Batch read, only in blocking mode */
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < FOOT_BATCH; u16Idx++)
+    {
+        u16Addr[u16Idx] = (uint16_t)(FOOT_ADDR_CONFIG + u16Idx);
+    }
+    MCB_TEST_CHECK(Mcb_ReadBatch(&tInst, FOOT_NODE, u16Addr, tMsg, FOOT_BATCH) == FOOT_BATCH);
+    MCB_TEST_CHECK(tMsg[0].u16Data[0] == u16Value);
+    Mcb_Deinit(&tInst);
+
+    return NULL;
+}
+
+static void Mcb_FootCompl(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
+{
+    (void)ptInst;
+
+    MCB_TEST_CHECK((pMcbMsg->eStatus == MCB_READ_SUCCESS) && (pMcbMsg->u16Data[0] == FOOT_VALUE));
+    isCfgDone = true;
+}
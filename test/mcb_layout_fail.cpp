@@ -0,0 +1,37 @@
+/**
+ * @file mcb_layout_fail.cpp
+ * @brief Cyclic layouts the build must reject
+ *
+ * Each MCB_LAYOUT_FAIL_* case is compiled on its own by ctest, which expects
+ * the build to fail with the static assertion of that case.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_layout.hpp"
+
+using TFailLayout = mcb::Layout<mcb::Reg<0x020U, INT32_TYPE>, mcb::Reg<0x021U, FLOAT_TYPE>>;
+
+#if defined(MCB_LAYOUT_FAIL_REGS)
+/** One register more than MAX_MAPPED_REG */
+using TFailRegs = mcb::Layout<
+    mcb::Reg<0x100U, INT16_TYPE>, mcb::Reg<0x101U, INT16_TYPE>, mcb::Reg<0x102U, INT16_TYPE>,
+    mcb::Reg<0x103U, INT16_TYPE>, mcb::Reg<0x104U, INT16_TYPE>, mcb::Reg<0x105U, INT16_TYPE>,
+    mcb::Reg<0x106U, INT16_TYPE>, mcb::Reg<0x107U, INT16_TYPE>, mcb::Reg<0x108U, INT16_TYPE>,
+    mcb::Reg<0x109U, INT16_TYPE>, mcb::Reg<0x10AU, INT16_TYPE>, mcb::Reg<0x10BU, INT16_TYPE>,
+    mcb::Reg<0x10CU, INT16_TYPE>, mcb::Reg<0x10DU, INT16_TYPE>, mcb::Reg<0x10EU, INT16_TYPE>,
+    mcb::Reg<0x10FU, INT16_TYPE>>;
+static_assert(TFailRegs::u8Num != 0U, "Layout instantiated");
+#elif defined(MCB_LAYOUT_FAIL_TWICE)
+using TFailTwice = mcb::Layout<mcb::Reg<0x020U, INT32_TYPE>, mcb::Reg<0x020U, INT32_TYPE>>;
+static_assert(TFailTwice::u8Num != 0U, "Layout instantiated");
+#elif defined(MCB_LAYOUT_FAIL_STRING)
+using TFailString = mcb::Layout<mcb::Reg<0x020U, STRING_TYPE>>;
+static_assert(TFailString::u8Num != 0U, "Layout instantiated");
+#elif defined(MCB_LAYOUT_FAIL_MISSING)
+void Mcb_LayoutFail(mcb::Cyclic<TFailLayout, TFailLayout>& tCyclic)
+{
+    tCyclic.rx<0x022U>() = 0;
+}
+#endif
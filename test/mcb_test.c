@@ -0,0 +1,70 @@
+/**
+ * @file mcb_test.c
+ * @brief Checks, time stamps and reference routines shared by the tests
+ *        and benchmarks
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test.h"
+#include <time.h>
+
+static uint32_t u32TestFailed;
+
+void Mcb_TestCheck(bool isCond, const char* szCond, const char* szFile, int32_t i32Line)
+{
+    if (isCond == false)
+    {
+        printf("%s:%d: check failed: %s\n", szFile, (int)i32Line, szCond);
+        u32TestFailed++;
+    }
+}
+
+int Mcb_TestResult(void)
+{
+    printf("%s\n", (u32TestFailed == (uint32_t)0UL) ? "PASS" : "FAIL");
+
+    return (u32TestFailed == (uint32_t)0UL) ? 0 : 1;
+}
+
+uint64_t Mcb_TestNanos(void)
+{
+    struct timespec tNow;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &tNow);
+
+    return ((uint64_t)tNow.tv_sec * 1000000000ULL) + (uint64_t)tNow.tv_nsec;
+}
+
+uint16_t Mcb_TestCrcRef(uint16_t u16Crc, const uint16_t* pu16Buf, size_t szWords)
+{
+    for (size_t szIdx = 0U; szIdx < szWords; szIdx++)
+    {
+        for (int32_t i32Bit = 15; i32Bit >= 0; i32Bit--)
+        {
+            bool isFeedback = ((((u16Crc >> 15U) ^ (pu16Buf[szIdx] >> (uint16_t)i32Bit)) & 1U) != 0U);
+
+            u16Crc = (uint16_t)(u16Crc << 1U);
+            if (isFeedback != false)
+            {
+                u16Crc ^= (uint16_t)0x1021U;
+            }
+        }
+    }
+
+    return u16Crc;
+}
+
+uint32_t Mcb_TestRand(uint32_t* pu32State)
+{
+    /** Xorshift32 */
+    uint32_t u32X = *pu32State;
+
+    u32X ^= u32X << 13U;
+    u32X ^= u32X >> 17U;
+    u32X ^= u32X << 5U;
+    *pu32State = u32X;
+
+    return u32X;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file mcb_test.h
+ * @brief Checks, time stamps and reference routines shared by the tests
+ *        and benchmarks
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#ifndef MCB_TEST_H
+#define MCB_TEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Checks a test condition, the failure is reported and the test goes on */
+#define MCB_TEST_CHECK(isCond) Mcb_TestCheck((isCond), #isCond, __FILE__, __LINE__)
+
+/**
+ * Reports a failed check
+ *
+ * @param[in] isCond
+ *  Checked condition
+ * @param[in] szCond
+ *  Condition text
+ * @param[in] szFile
+ *  Source file
+ * @param[in] i32Line
+ *  Source line
+ */
+void
+Mcb_TestCheck(bool isCond, const char* szCond, const char* szFile, int32_t i32Line);
+
+/**
+ * Gets the exit code of a test, printing its result
+ *
+ * @retval 0 if every check passed, 1 otherwise
+ */
+int
+Mcb_TestResult(void);
+
+/**
+ * Gets a monotonic time stamp
+ *
+ * @retval nanoseconds
+ */
+uint64_t
+Mcb_TestNanos(void);
+
+/**
+ * Bit by bit CRC-CCITT (XModem) of a word buffer, the reference every table
+ * and carry-less multiplication routine is compared with
+ *
+ * @param[in] u16Crc
+ *  CRC state to be updated
+ * @param[in] pu16Buf
+ *  Words, most significant byte first
+ * @param[in] szWords
+ *  Number of words
+ *
+ * @retval Updated CRC state
+ */
+uint16_t
+Mcb_TestCrcRef(uint16_t u16Crc, const uint16_t* pu16Buf, size_t szWords);
+
+/**
+ * Pseudo random generator of the tests, reproducible between runs
+ *
+ * @param[in,out] pu32State
+ *  Generator state, any non zero seed
+ *
+ * @retval Next pseudo random value
+ */
+uint32_t
+Mcb_TestRand(uint32_t* pu32State);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCB_TEST_H */
@@ -0,0 +1,265 @@
+/**
+ * @file mcb_test_cfg_queue.c
+ * @brief Test of the config over cyclic queue
+ *
+ * Requests queued in cyclic mode are served by the cyclic frames, in order
+ * and each one once, and a full queue rejects the request. Writes larger
+ * than a queue slot are only queued on an empty queue, and are sent whole as
+ * the larger replies are received. A blocking request which times out before
+ * being served is dropped by the cyclic functions without reaching the
+ * slave, and the queue keeps serving the next requests.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include <pthread.h>
+#include <string.h>
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_CONFIG    (uint16_t)0x100U
+#define TEST_ADDR_SETPOINT  (uint16_t)0x200U
+#define TEST_ADDR_ACTUAL    (uint16_t)0x300U
+/** Register larger than a config frame */
+#define TEST_ADDR_LARGE     (uint16_t)0x180U
+#define TEST_LARGE_SZ       (uint16_t)10U
+/** Instance timeout (ms) */
+#define TEST_TIMEOUT        (uint32_t)20UL
+/** Cycles given to the queued requests */
+#define TEST_MAX_CYCLES     (uint16_t)64U
+
+static Mcb_TInst tInst;
+
+/** Requests completed and acknowledged, as reported by the instance */
+static uint16_t u16Compl;
+static uint16_t u16Acked;
+
+/** Last completed message */
+static Mcb_TMsg tRpy;
+
+/** Set by the producer once the cyclic thread can stop */
+static volatile bool isProducerDone;
+
+/**
+ * Config over cyclic callback, counts the completions
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in] pMcbMsg
+ *  Completed message
+ */
+static void
+Mcb_TestCfgEvnt(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+
+/**
+ * Enters cyclic mode on the instance node
+ *
+ * @param[in] eMode
+ *  Instance mode
+ */
+static void
+Mcb_TestStart(Mcb_EMode eMode);
+
+/**
+ * Runs cyclic frames
+ *
+ * @param[in] u16Cycles
+ *  Cycles run
+ */
+static void
+Mcb_TestCycles(uint16_t u16Cycles);
+
+/**
+ * Runs cyclic frames until the producer is done
+ *
+ * @param[in] pArg
+ *  Not used
+ *
+ * @retval NULL
+ */
+static void*
+Mcb_TestCyclic(void* pArg);
+
+/**
+ * Prepares a write request
+ *
+ * @param[out] pMcbMsg
+ *  Request
+ * @param[in] u16Addr
+ *  Register address
+ * @param[in] u16Value
+ *  Value written
+ */
+static void
+Mcb_TestMsg(Mcb_TMsg* pMcbMsg, uint16_t u16Addr, uint16_t u16Value);
+
+int main(void)
+{
+    pthread_t tCyclic;
+    Mcb_TMsg tMsg;
+    uint16_t u16Value[MCB_MAX_DATA_SZ];
+    uint32_t u32Writes;
+    uint16_t u16Cycle;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+
+    /** Queue filled, the next request is rejected */
+    Mcb_TestStart(MCB_NON_BLOCKING);
+    Mcb_AttachCfgOverCyclicCB(&tInst, Mcb_TestCfgEvnt);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < MCB_CFG_QUEUE_SZ; u16Idx++)
+    {
+        Mcb_TestMsg(&tMsg, (TEST_ADDR_CONFIG + u16Idx), ((uint16_t)0x4000U + u16Idx));
+        tInst.Mcb_Write(&tInst, &tMsg);
+        MCB_TEST_CHECK(tMsg.eStatus == MCB_STANDBY);
+    }
+    Mcb_TestMsg(&tMsg, (TEST_ADDR_CONFIG + MCB_CFG_QUEUE_SZ), (uint16_t)0x4FFFU);
+    tInst.Mcb_Write(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_WRITE_ERROR);
+
+    /** Served by the cyclic frames, each request once */
+    u32Writes = Mcb_SimWrites(0, TEST_NODE);
+    for (u16Cycle = (uint16_t)0U; (u16Cycle < TEST_MAX_CYCLES) && (u16Compl < MCB_CFG_QUEUE_SZ); u16Cycle++)
+    {
+        Mcb_TestCycles((uint16_t)1U);
+    }
+    MCB_TEST_CHECK((u16Compl == MCB_CFG_QUEUE_SZ) && (u16Acked == MCB_CFG_QUEUE_SZ));
+    MCB_TEST_CHECK((Mcb_SimWrites(0, TEST_NODE) - u32Writes) == (uint32_t)MCB_CFG_QUEUE_SZ);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < MCB_CFG_QUEUE_SZ; u16Idx++)
+    {
+        (void)Mcb_SimGetReg(0, TEST_NODE, (TEST_ADDR_CONFIG + u16Idx), u16Value);
+        MCB_TEST_CHECK(u16Value[0] == ((uint16_t)0x4000U + u16Idx));
+    }
+    (void)Mcb_SimGetReg(0, TEST_NODE, (TEST_ADDR_CONFIG + MCB_CFG_QUEUE_SZ), u16Value);
+    MCB_TEST_CHECK(u16Value[0] != (uint16_t)0x4FFFU);
+
+    /** Room again once served */
+    tInst.Mcb_Write(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_STANDBY);
+    Mcb_TestCycles(TEST_MAX_CYCLES);
+    MCB_TEST_CHECK(u16Acked == (MCB_CFG_QUEUE_SZ + 1U));
+    (void)Mcb_SimGetReg(0, TEST_NODE, (TEST_ADDR_CONFIG + MCB_CFG_QUEUE_SZ), u16Value);
+    MCB_TEST_CHECK(u16Value[0] == (uint16_t)0x4FFFU);
+
+    /** Large writes wait for an empty queue, large replies are received whole */
+    Mcb_TestMsg(&tMsg, TEST_ADDR_CONFIG, (uint16_t)0x4000U);
+    tInst.Mcb_Write(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_STANDBY);
+    Mcb_TestMsg(&tMsg, TEST_ADDR_LARGE, (uint16_t)0U);
+    tMsg.u16Size = TEST_LARGE_SZ;
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_LARGE_SZ; u16Idx++)
+    {
+        tMsg.u16Data[u16Idx] = (uint16_t)0x4800U + u16Idx;
+    }
+    tInst.Mcb_Write(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_WRITE_ERROR);
+    Mcb_TestCycles(TEST_MAX_CYCLES);
+    tInst.Mcb_Write(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_STANDBY);
+    Mcb_TestCycles(TEST_MAX_CYCLES);
+    MCB_TEST_CHECK(Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_LARGE, u16Value) >= TEST_LARGE_SZ);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_LARGE_SZ; u16Idx++)
+    {
+        MCB_TEST_CHECK(u16Value[u16Idx] == ((uint16_t)0x4800U + u16Idx));
+    }
+
+    Mcb_TestMsg(&tMsg, TEST_ADDR_LARGE, (uint16_t)0U);
+    tInst.Mcb_Read(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_STANDBY);
+    Mcb_TestCycles(TEST_MAX_CYCLES);
+    MCB_TEST_CHECK((tRpy.eStatus == MCB_READ_SUCCESS) && (tRpy.u16Addr == TEST_ADDR_LARGE));
+    MCB_TEST_CHECK(tRpy.u16Size >= TEST_LARGE_SZ);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_LARGE_SZ; u16Idx++)
+    {
+        MCB_TEST_CHECK(tRpy.u16Data[u16Idx] == ((uint16_t)0x4800U + u16Idx));
+    }
+    Mcb_Deinit(&tInst);
+    Mcb_SimResetNode(0, TEST_NODE);
+
+    /** Blocking request given up before any cyclic frame, dropped without reaching the slave */
+    Mcb_TestStart(MCB_BLOCKING);
+    u32Writes = Mcb_SimWrites(0, TEST_NODE);
+    Mcb_TestMsg(&tMsg, TEST_ADDR_CONFIG, (uint16_t)0x5000U);
+    tInst.Mcb_Write(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_WRITE_ERROR);
+    Mcb_TestCycles(TEST_MAX_CYCLES);
+    MCB_TEST_CHECK(Mcb_SimWrites(0, TEST_NODE) == u32Writes);
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_CONFIG, u16Value);
+    MCB_TEST_CHECK(u16Value[0] == (uint16_t)0x4000U);
+
+    /** The next request is served */
+    isProducerDone = false;
+    MCB_TEST_CHECK(pthread_create(&tCyclic, NULL, Mcb_TestCyclic, NULL) == 0);
+    Mcb_TestMsg(&tMsg, TEST_ADDR_CONFIG, (uint16_t)0x5001U);
+    tInst.Mcb_Write(&tInst, &tMsg);
+    isProducerDone = true;
+    (void)pthread_join(tCyclic, NULL);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_WRITE_SUCCESS);
+    MCB_TEST_CHECK((Mcb_SimWrites(0, TEST_NODE) - u32Writes) == (uint32_t)1UL);
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_CONFIG, u16Value);
+    MCB_TEST_CHECK(u16Value[0] == (uint16_t)0x5001U);
+    Mcb_Deinit(&tInst);
+
+    return Mcb_TestResult();
+}
+
+static void Mcb_TestCfgEvnt(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
+{
+    (void)ptInst;
+
+    memcpy((void*)&tRpy, (const void*)pMcbMsg, sizeof(Mcb_TMsg));
+    u16Compl++;
+    if (pMcbMsg->eStatus == MCB_WRITE_SUCCESS)
+    {
+        u16Acked++;
+    }
+}
+
+static void Mcb_TestStart(Mcb_EMode eMode)
+{
+    uint16_t u16Value = (uint16_t)0x1111U;
+
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_ACTUAL, &u16Value, (uint16_t)1U);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, eMode, 0, true, TEST_TIMEOUT) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_SetNode(&tInst, TEST_NODE) != false);
+    MCB_TEST_CHECK(Mcb_RxMap(&tInst, TEST_ADDR_SETPOINT, (uint16_t)2U) != NULL);
+    MCB_TEST_CHECK(Mcb_TxMap(&tInst, TEST_ADDR_ACTUAL, (uint16_t)2U) != NULL);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+}
+
+static void Mcb_TestCycles(uint16_t u16Cycles)
+{
+    Mcb_EStatus eCfgStat;
+
+    for (uint16_t u16Cycle = (uint16_t)0U; u16Cycle < u16Cycles; u16Cycle++)
+    {
+        if (Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false)
+        {
+            (void)Mcb_CyclicFrameProcess(&tInst);
+        }
+    }
+}
+
+static void* Mcb_TestCyclic(void* pArg)
+{
+    (void)pArg;
+
+    while (isProducerDone == false)
+    {
+        Mcb_TestCycles((uint16_t)1U);
+    }
+
+    return NULL;
+}
+
+static void Mcb_TestMsg(Mcb_TMsg* pMcbMsg, uint16_t u16Addr, uint16_t u16Value)
+{
+    pMcbMsg->u16Node = TEST_NODE;
+    pMcbMsg->u16Addr = u16Addr;
+    pMcbMsg->u16Size = (uint16_t)1U;
+    pMcbMsg->u16Data[0] = u16Value;
+    pMcbMsg->eStatus = MCB_STANDBY;
+    pMcbMsg->ComplEvnt = NULL;
+    pMcbMsg->pUsrCtx = NULL;
+}
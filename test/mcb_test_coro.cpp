@@ -0,0 +1,200 @@
+/**
+ * @file mcb_test_coro.cpp
+ * @brief Test of the coroutine API over the non-blocking mode
+ *
+ * Coroutines awaiting writes and reads on the simulated drive are resumed
+ * with the replies, in queue order, registers larger than a config frame
+ * included. Each coroutine uses its own registers, as their requests are
+ * interleaved on the queue. A request the slave never answers fails once the instance
+ * timeout expires, and the bus serves the next requests afterwards.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include "mcb_coro.hpp"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_NODE_OTHER     (uint16_t)2U
+#define TEST_ADDR_SMALL     (uint16_t)0x100U
+#define TEST_ADDR_LARGE     (uint16_t)0x200U
+/** Register larger than a config frame */
+#define TEST_LARGE_SZ       (uint16_t)10U
+/** Instance timeout (ms) */
+#define TEST_TIMEOUT        (uint32_t)20UL
+/** Time given to the queued requests before the test gives up (ms) */
+#define TEST_MAX_MILLIS     (uint32_t)1000UL
+
+static Mcb_TInst tInst;
+
+/** Results of a coroutine, filled as it goes */
+struct TTestRun
+{
+    /** Offset of the registers of the coroutine from the test ones */
+    uint16_t u16Reg = 0U;
+    /** Order the coroutine finished in, 0 while it runs */
+    uint16_t u16Order = 0U;
+    /** Write statuses */
+    Mcb_EStatus eWrite[2] = { MCB_STANDBY, MCB_STANDBY };
+    /** Read replies */
+    Mcb_TMsg tRead[2] = {};
+};
+
+/** Number of coroutines finished so far */
+static uint16_t u16Finished;
+
+/**
+ * Writes a single word and a large register, then reads both back
+ *
+ * @param[in] tBus
+ *  Bus driving the requests
+ * @param[in] u16Seed
+ *  Seed of the written values
+ * @param[in, out] tRun
+ *  Coroutine registers and results
+ */
+static mcb::Task
+Mcb_TestRoundTrip(mcb::Bus& tBus, uint16_t u16Seed, TTestRun& tRun);
+
+/**
+ * Reads a register of a node
+ *
+ * @param[in] tBus
+ *  Bus driving the request
+ * @param[in] u16Addr
+ *  Register address
+ * @param[in] u16Node
+ *  Target slave
+ * @param[out] tRun
+ *  Coroutine results, the reply is the first read
+ */
+static mcb::Task
+Mcb_TestRead(mcb::Bus& tBus, uint16_t u16Addr, uint16_t u16Node, TTestRun& tRun);
+
+/**
+ * Polls the bus until no request is pending
+ *
+ * @param[in] tBus
+ *  Bus to be polled
+ *
+ * @retval true if every request finished
+ */
+static bool
+Mcb_TestDrain(mcb::Bus& tBus);
+
+/**
+ * Checks the replies of a round trip
+ *
+ * @param[in] tRun
+ *  Coroutine results
+ * @param[in] u16Seed
+ *  Seed of the written values
+ *
+ * @retval true if both writes succeeded and both reads returned their values
+ */
+static bool
+Mcb_TestCheckRun(const TTestRun& tRun, uint16_t u16Seed);
+
+int main(void)
+{
+    mcb::Bus tBus(tInst);
+    TTestRun tFirst;
+    TTestRun tSecond;
+    TTestRun tOther;
+    TTestRun tLost;
+    uint16_t u16Value = (uint16_t)0x0BADU;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, TEST_TIMEOUT) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_SetNode(&tInst, TEST_NODE) != false);
+    Mcb_SimSetReg(0, TEST_NODE_OTHER, TEST_ADDR_SMALL, &u16Value, (uint16_t)1U);
+
+    /** Round trips queued by two coroutines, served in order */
+    tSecond.u16Reg = 1U;
+    Mcb_TestRoundTrip(tBus, (uint16_t)0x1000U, tFirst);
+    Mcb_TestRoundTrip(tBus, (uint16_t)0x2000U, tSecond);
+    MCB_TEST_CHECK(tBus.pending() == 2U);
+    MCB_TEST_CHECK(Mcb_TestDrain(tBus));
+    MCB_TEST_CHECK(Mcb_TestCheckRun(tFirst, (uint16_t)0x1000U));
+    MCB_TEST_CHECK(Mcb_TestCheckRun(tSecond, (uint16_t)0x2000U));
+    MCB_TEST_CHECK((tFirst.u16Order == 1U) && (tSecond.u16Order == 2U));
+
+    /** Another node than the instance one */
+    Mcb_TestRead(tBus, TEST_ADDR_SMALL, TEST_NODE_OTHER, tOther);
+    MCB_TEST_CHECK(Mcb_TestDrain(tBus));
+    MCB_TEST_CHECK(tOther.tRead[0].eStatus == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(tOther.tRead[0].u16Data[0] == u16Value);
+
+    /** The slave never answers, the request fails on timeout */
+    Mcb_SimDeferIrq(0, true);
+    Mcb_TestRead(tBus, TEST_ADDR_SMALL, TEST_NODE, tLost);
+    MCB_TEST_CHECK(Mcb_TestDrain(tBus));
+    MCB_TEST_CHECK(tLost.tRead[0].eStatus == MCB_READ_ERROR);
+    Mcb_SimDeferIrq(0, false);
+    (void)Mcb_SimTakeIrq(0);
+
+    /** Requests are served again once the slave answers */
+    tFirst = TTestRun();
+    Mcb_TestRoundTrip(tBus, (uint16_t)0x3000U, tFirst);
+    MCB_TEST_CHECK(Mcb_TestDrain(tBus));
+    MCB_TEST_CHECK(Mcb_TestCheckRun(tFirst, (uint16_t)0x3000U));
+
+    Mcb_Deinit(&tInst);
+
+    return Mcb_TestResult();
+}
+
+static mcb::Task Mcb_TestRoundTrip(mcb::Bus& tBus, uint16_t u16Seed, TTestRun& tRun)
+{
+    uint16_t u16Large[TEST_LARGE_SZ];
+    Mcb_TMsg tRpy;
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_LARGE_SZ; u16Idx++)
+    {
+        u16Large[u16Idx] = (uint16_t)(u16Seed + u16Idx);
+    }
+
+    tRpy = co_await tBus.write((TEST_ADDR_SMALL + tRun.u16Reg), &u16Seed, (uint16_t)1U);
+    tRun.eWrite[0] = tRpy.eStatus;
+    tRpy = co_await tBus.write((TEST_ADDR_LARGE + tRun.u16Reg), u16Large, TEST_LARGE_SZ);
+    tRun.eWrite[1] = tRpy.eStatus;
+    tRun.tRead[0] = co_await tBus.read(TEST_ADDR_SMALL + tRun.u16Reg);
+    tRun.tRead[1] = co_await tBus.read(TEST_ADDR_LARGE + tRun.u16Reg);
+
+    tRun.u16Order = ++u16Finished;
+}
+
+static mcb::Task Mcb_TestRead(mcb::Bus& tBus, uint16_t u16Addr, uint16_t u16Node, TTestRun& tRun)
+{
+    tRun.tRead[0] = co_await tBus.read(u16Addr, u16Node);
+
+    tRun.u16Order = ++u16Finished;
+}
+
+static bool Mcb_TestDrain(mcb::Bus& tBus)
+{
+    uint32_t u32Millis = Mcb_GetMillis();
+
+    while ((tBus.poll() != false) && ((Mcb_GetMillis() - u32Millis) < TEST_MAX_MILLIS))
+    {
+        /** Nothing */
+    }
+
+    return (tBus.pending() == 0U);
+}
+
+static bool Mcb_TestCheckRun(const TTestRun& tRun, uint16_t u16Seed)
+{
+    bool isMatch = ((tRun.eWrite[0] == MCB_WRITE_SUCCESS) && (tRun.eWrite[1] == MCB_WRITE_SUCCESS)
+                    && (tRun.tRead[0].eStatus == MCB_READ_SUCCESS) && (tRun.tRead[1].eStatus == MCB_READ_SUCCESS)
+                    && (tRun.tRead[0].u16Data[0] == u16Seed) && (tRun.tRead[1].u16Size >= TEST_LARGE_SZ));
+
+    for (uint16_t u16Idx = (uint16_t)0U; (isMatch != false) && (u16Idx < TEST_LARGE_SZ); u16Idx++)
+    {
+        isMatch = (tRun.tRead[1].u16Data[u16Idx] == (uint16_t)(u16Seed + u16Idx));
+    }
+
+    return isMatch;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file mcb_test_crc.c
+ * @brief Differential test of the CRC-CCITT implementations
+ *
+ * The slicing-by-8 table routine, the carry-less multiplication routine (when
+ * built and supported by the CPU) and the run time dispatched interface
+ * functions are checked against the bit by bit reference. Lengths cover the
+ * tails of every block size, the starting CRC is random so partial updates
+ * are exercised, and buffers start at every word offset of a block.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test.h"
+#include "mcb_checksum.h"
+#include "mcb_usr.h"
+
+/** Random buffers checked per length */
+#define TEST_ROUNDS         (uint16_t)16U
+/** Largest buffer (words), several 128 bit blocks and all the tails */
+#define TEST_MAX_WORDS      (uint16_t)300U
+/** Word offsets of the buffer start */
+#define TEST_MAX_OFFSET     (uint16_t)8U
+
+static uint16_t u16Buf[TEST_MAX_WORDS + TEST_MAX_OFFSET];
+
+/**
+ * Checks every implementation over a buffer
+ *
+ * @param[in] u16Crc
+ *  Starting CRC state
+ * @param[in] pu16Words
+ *  Words, most significant byte first
+ * @param[in] u16Words
+ *  Number of words
+ */
+static void
+Mcb_TestCrcWords(uint16_t u16Crc, const uint16_t* pu16Words, uint16_t u16Words);
+
+int main(void)
+{
+    uint32_t u32Seed = (uint32_t)0xBEEFUL;
+
+#ifdef CRC_CCITT_CLMUL
+    printf("clmul %s\n", (crc_ccitt_clmul_available() != false) ? "available" : "not available");
+#else
+    printf("clmul not built\n");
+#endif
+
+    /** Known answer, "123456789" is 0x31C3 on XModem */
+    MCB_TEST_CHECK(crc_xmodem((const unsigned char*)"123456789", 9U) == (uint16_t)0x31C3U);
+
+    for (uint16_t u16Words = (uint16_t)0U; u16Words <= TEST_MAX_WORDS; u16Words++)
+    {
+        for (uint16_t u16Round = (uint16_t)0U; u16Round < TEST_ROUNDS; u16Round++)
+        {
+            for (uint16_t u16Idx = (uint16_t)0U; u16Idx < (uint16_t)(TEST_MAX_WORDS + TEST_MAX_OFFSET); u16Idx++)
+            {
+                u16Buf[u16Idx] = (uint16_t)Mcb_TestRand(&u32Seed);
+            }
+
+            uint16_t u16Offset = (uint16_t)(u16Round % TEST_MAX_OFFSET);
+            uint16_t u16Crc = (u16Round == (uint16_t)0U) ? (uint16_t)CRC_START_XMODEM
+                                                         : (uint16_t)Mcb_TestRand(&u32Seed);
+
+            Mcb_TestCrcWords(u16Crc, &u16Buf[u16Offset], u16Words);
+        }
+    }
+
+    /** Constant patterns, the all ones one stresses the folding */
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_MAX_WORDS; u16Idx++)
+    {
+        u16Buf[u16Idx] = (uint16_t)0xFFFFU;
+    }
+    Mcb_TestCrcWords((uint16_t)0xFFFFU, u16Buf, TEST_MAX_WORDS);
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_MAX_WORDS; u16Idx++)
+    {
+        u16Buf[u16Idx] = (uint16_t)0U;
+    }
+    Mcb_TestCrcWords((uint16_t)0U, u16Buf, TEST_MAX_WORDS);
+
+    return Mcb_TestResult();
+}
+
+static void Mcb_TestCrcWords(uint16_t u16Crc, const uint16_t* pu16Words, uint16_t u16Words)
+{
+    unsigned char u8Bytes[2U * TEST_MAX_WORDS];
+    uint16_t u16Ref = Mcb_TestCrcRef(u16Crc, pu16Words, u16Words);
+    uint16_t u16Split = (uint16_t)(u16Words / 3U);
+
+    MCB_TEST_CHECK(crc_ccitt_words(u16Crc, pu16Words, u16Words) == u16Ref);
+
+#ifdef CRC_CCITT_CLMUL
+    if (crc_ccitt_clmul_available() != false)
+    {
+        MCB_TEST_CHECK(crc_ccitt_words_clmul(u16Crc, pu16Words, u16Words) == u16Ref);
+
+        /** Resumed in the middle of a block */
+        MCB_TEST_CHECK(crc_ccitt_words_clmul(crc_ccitt_words_clmul(u16Crc, pu16Words, u16Split),
+                                             &pu16Words[u16Split], (u16Words - u16Split)) == u16Ref);
+    }
+#endif
+
+    /** Dispatched routine, resumed as done with the idle frames */
+    MCB_TEST_CHECK(Mcb_IntfCrcUpdate(u16Crc, pu16Words, u16Words) == u16Ref);
+    MCB_TEST_CHECK(Mcb_IntfCrcUpdate(Mcb_IntfCrcUpdate(u16Crc, pu16Words, u16Split),
+                                     &pu16Words[u16Split], (u16Words - u16Split)) == u16Ref);
+
+    if (u16Crc == (uint16_t)CRC_START_XMODEM)
+    {
+        uint16_t u16Ref0 = Mcb_TestCrcRef(Mcb_IntfCrcInit(), pu16Words, u16Words);
+
+        MCB_TEST_CHECK(Mcb_IntfComputeCrc(pu16Words, u16Words) == u16Ref0);
+
+        /** The byte routine sees the words as transmitted */
+        for (uint16_t u16Idx = (uint16_t)0U; u16Idx < u16Words; u16Idx++)
+        {
+            u8Bytes[2U * u16Idx] = (unsigned char)(pu16Words[u16Idx] >> 8U);
+            u8Bytes[(2U * u16Idx) + 1U] = (unsigned char)(pu16Words[u16Idx] & 0xFFU);
+        }
+        MCB_TEST_CHECK(crc_xmodem(u8Bytes, (2U * (size_t)u16Words)) == u16Ref0);
+    }
+}
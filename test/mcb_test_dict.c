@@ -0,0 +1,209 @@
+/**
+ * @file mcb_test_dict.c
+ * @brief Test of the persistent get info dictionary
+ *
+ * A dictionary built from the simulated drive is saved and loaded back, and
+ * lookups must answer without using the bus. Files with a wrong checksum or
+ * format version, and files of another firmware, must be rejected. The
+ * firmware identity is read from the drive, and instances that cannot read
+ * it are rejected without any transfer.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include "mcb_dict.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_PATH           "mcb_test_dict.bin"
+/** Registers of the dictionary, duplicated ones included */
+#define TEST_ADDR_NUM       (uint16_t)6U
+/** Distinct registers of the dictionary */
+#define TEST_DICT_NUM       (uint16_t)5U
+/** Register out of the dictionary */
+#define TEST_ADDR_MISSING   (uint16_t)0x400U
+
+static Mcb_TInst tInst;
+
+/** Registers given to the build, neither sorted nor unique */
+static const uint16_t u16TestAddr[TEST_ADDR_NUM] =
+{
+    (uint16_t)0x300U, (uint16_t)0x100U, (uint16_t)0x204U, (uint16_t)0x100U, (uint16_t)0x020U, (uint16_t)0x301U
+};
+
+/**
+ * Gets the access type given to a register
+ *
+ * @param[in] u16Addr
+ *  Register address
+ *
+ * @retval RW_ACCESS, RO_ACCESS or WO_ACCESS
+ */
+static uint8_t
+Mcb_TestAccess(uint16_t u16Addr);
+
+/**
+ * Gets the size given to a register
+ *
+ * @param[in] u16Addr
+ *  Register address
+ *
+ * @retval Register size (words)
+ */
+static uint16_t
+Mcb_TestSize(uint16_t u16Addr);
+
+/**
+ * Sets the firmware version of the drive
+ *
+ * @param[in] u16Build
+ *  Build number, last word of the version
+ */
+static void
+Mcb_TestSetFw(uint16_t u16Build);
+
+/**
+ * Rewrites a word of the saved dictionary file
+ *
+ * @param[in] szOffset
+ *  Byte offset of the word
+ * @param[in] u16Xor
+ *  Bits flipped on the word
+ *
+ * @retval true if the file has been rewritten
+ */
+static bool
+Mcb_TestPatch(size_t szOffset, uint16_t u16Xor);
+
+int main(void)
+{
+    Mcb_TDictEntry tBuf[TEST_ADDR_NUM];
+    Mcb_TDict tDict;
+    Mcb_TDict tLoad;
+    Mcb_TInfoData tInfo;
+    Mcb_TInfoMsg tInfoMsg;
+    uint32_t u32FwId;
+    uint32_t u32Frames;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    Mcb_TestSetFw((uint16_t)7U);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_ADDR_NUM; u16Idx++)
+    {
+        uint16_t u16Value[2] = { u16TestAddr[u16Idx], (uint16_t)0U };
+
+        Mcb_SimSetReg(0, TEST_NODE, u16TestAddr[u16Idx], u16Value, Mcb_TestSize(u16TestAddr[u16Idx]));
+        Mcb_SimSetInfo(0, TEST_NODE, u16TestAddr[u16Idx], Mcb_TestAccess(u16TestAddr[u16Idx]), (uint8_t)0U);
+    }
+
+    /** Instances which cannot read the firmware identity */
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    u32Frames = Mcb_SimFrames(0);
+    MCB_TEST_CHECK(Mcb_DictBuild(&tDict, &tInst, TEST_NODE, u16TestAddr, TEST_ADDR_NUM, tBuf)
+                   == MCB_DICT_ERR_STATE);
+    MCB_TEST_CHECK(tDict.u16Num == (uint16_t)0U);
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_ERR_STATE);
+    MCB_TEST_CHECK(Mcb_SimFrames(0) == u32Frames);
+    Mcb_Deinit(&tInst);
+
+    /** Build, sorted and without duplicates */
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_DictBuild(&tDict, &tInst, TEST_NODE, u16TestAddr, TEST_ADDR_NUM, tBuf) == MCB_DICT_OK);
+    MCB_TEST_CHECK(tDict.u16Num == TEST_DICT_NUM);
+    for (uint16_t u16Idx = (uint16_t)1U; u16Idx < tDict.u16Num; u16Idx++)
+    {
+        MCB_TEST_CHECK(tDict.ptEntry[u16Idx - 1U].u16Addr < tDict.ptEntry[u16Idx].u16Addr);
+    }
+    MCB_TEST_CHECK(Mcb_DictReadFwId(&tInst, TEST_NODE, &u32FwId) == MCB_DICT_OK);
+    MCB_TEST_CHECK(tDict.u32FwId == u32FwId);
+
+    /** Save and load round trip, lookups without any transfer */
+    MCB_TEST_CHECK(Mcb_DictSave(&tDict, TEST_PATH) == MCB_DICT_OK);
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_OK);
+    MCB_TEST_CHECK(tLoad.u16Num == TEST_DICT_NUM);
+    MCB_TEST_CHECK(tLoad.u32FwId == u32FwId);
+    u32Frames = Mcb_SimFrames(0);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_ADDR_NUM; u16Idx++)
+    {
+        MCB_TEST_CHECK(Mcb_DictLookup(&tLoad, u16TestAddr[u16Idx], &tInfo) != false);
+        MCB_TEST_CHECK(tInfo.u8AccessType == Mcb_TestAccess(u16TestAddr[u16Idx]));
+        MCB_TEST_CHECK(tInfo.u8Size == (uint8_t)(Mcb_TestSize(u16TestAddr[u16Idx]) * 2U));
+    }
+    tInfoMsg.u16Node = TEST_NODE;
+    tInfoMsg.u16Addr = u16TestAddr[0];
+    Mcb_DictGetInfo(&tLoad, &tInst, &tInfoMsg);
+    MCB_TEST_CHECK(tInfoMsg.eStatus == MCB_GETINFO_SUCCESS);
+    MCB_TEST_CHECK(Mcb_SimFrames(0) == u32Frames);
+    MCB_TEST_CHECK(Mcb_DictLookup(&tLoad, TEST_ADDR_MISSING, &tInfo) == false);
+    tInfoMsg.u16Addr = TEST_ADDR_MISSING;
+    Mcb_DictGetInfo(&tLoad, &tInst, &tInfoMsg);
+    MCB_TEST_CHECK(tInfoMsg.eStatus == MCB_GETINFO_SUCCESS);
+    MCB_TEST_CHECK(Mcb_SimFrames(0) != u32Frames);
+    Mcb_DictClose(&tLoad);
+
+    /** Damaged entries */
+    MCB_TEST_CHECK(Mcb_TestPatch((sizeof(Mcb_TDictHeader) + offsetof(Mcb_TDictEntry, u16Info)), (uint16_t)0x0100U));
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_ERR_FORMAT);
+    MCB_TEST_CHECK(tLoad.u16Num == (uint16_t)0U);
+    MCB_TEST_CHECK(Mcb_TestPatch((sizeof(Mcb_TDictHeader) + offsetof(Mcb_TDictEntry, u16Info)), (uint16_t)0x0100U));
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_OK);
+    Mcb_DictClose(&tLoad);
+
+    /** Another format version */
+    MCB_TEST_CHECK(Mcb_TestPatch(offsetof(Mcb_TDictHeader, u16Version), (uint16_t)0x0003U));
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_ERR_FORMAT);
+    MCB_TEST_CHECK(Mcb_TestPatch(offsetof(Mcb_TDictHeader, u16Version), (uint16_t)0x0003U));
+
+    /** The drive has been updated */
+    Mcb_TestSetFw((uint16_t)8U);
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_ERR_FW);
+    MCB_TEST_CHECK(tLoad.u16Num == (uint16_t)0U);
+    Mcb_TestSetFw((uint16_t)7U);
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_OK);
+    Mcb_DictClose(&tLoad);
+
+    /** Missing file */
+    MCB_TEST_CHECK(remove(TEST_PATH) == 0);
+    MCB_TEST_CHECK(Mcb_DictLoad(&tLoad, TEST_PATH, &tInst, TEST_NODE) == MCB_DICT_ERR_IO);
+    Mcb_Deinit(&tInst);
+
+    return Mcb_TestResult();
+}
+
+static uint8_t Mcb_TestAccess(uint16_t u16Addr)
+{
+    return (uint8_t)((u16Addr >> 8U) % 3U);
+}
+
+static uint16_t Mcb_TestSize(uint16_t u16Addr)
+{
+    return (uint16_t)((u16Addr & 1U) + 1U);
+}
+
+static void Mcb_TestSetFw(uint16_t u16Build)
+{
+    uint16_t u16Version[4] = { (uint16_t)2U, (uint16_t)4U, (uint16_t)1U, u16Build };
+
+    Mcb_SimSetReg(0, TEST_NODE, MCB_DICT_ADDR_FW_VERSION, u16Version, (uint16_t)4U);
+}
+
+static bool Mcb_TestPatch(size_t szOffset, uint16_t u16Xor)
+{
+    bool isPatched = false;
+    uint16_t u16Word;
+    FILE* ptFile = fopen(TEST_PATH, "r+b");
+
+    if (ptFile != NULL)
+    {
+        if ((fseek(ptFile, (long)szOffset, SEEK_SET) == 0) && (fread(&u16Word, sizeof(u16Word), 1U, ptFile) == 1U))
+        {
+            u16Word ^= u16Xor;
+            isPatched = ((fseek(ptFile, (long)szOffset, SEEK_SET) == 0)
+                         && (fwrite(&u16Word, sizeof(u16Word), 1U, ptFile) == 1U));
+        }
+        isPatched = ((fclose(ptFile) == 0) && (isPatched != false));
+    }
+
+    return isPatched;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file mcb_test_layout.cpp
+ * @brief Test of the compile time cyclic layout
+ *
+ * Register offsets and cyclic sizes are checked at compile time. The layouts
+ * are then mapped on the simulated drive through Mcb_MapBatch, and values
+ * written and read through the typed references must reach the slave
+ * registers and come back from them.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include "mcb_layout.hpp"
+#include <type_traits>
+
+#define TEST_NODE           (uint16_t)1U
+/** Slave mapping registers */
+#define TEST_RX_MAP_BASE    (uint16_t)0x650U
+#define TEST_TX_MAP_BASE    (uint16_t)0x660U
+
+using TTestRx = mcb::Layout<mcb::Reg<0x020U, INT32_TYPE>, mcb::Reg<0x021U, FLOAT_TYPE>,
+                            mcb::Reg<0x022U, UINT16_TYPE>>;
+using TTestTx = mcb::Layout<mcb::Reg<0x030U, INT16_TYPE>, mcb::Reg<0x031U, UINT32_TYPE>>;
+
+static_assert(TTestRx::u8Num == 3U, "Rx layout registers");
+static_assert(TTestRx::u16Words == 5U, "Rx layout size");
+static_assert(TTestRx::offset<0x020U>() == 0U, "Rx offset of 0x020");
+static_assert(TTestRx::offset<0x021U>() == 2U, "Rx offset of 0x021");
+static_assert(TTestRx::offset<0x022U>() == 4U, "Rx offset of 0x022");
+static_assert(TTestTx::u16Words == 3U, "Tx layout size");
+static_assert(TTestTx::offset<0x031U>() == 1U, "Tx offset of 0x031, after a single word register");
+static_assert(std::is_same<TTestRx::type<0x021U>, float>::value, "Rx type of 0x021");
+static_assert(std::is_same<TTestTx::type<0x030U>, int16_t>::value, "Tx type of 0x030");
+
+static Mcb_TInst tInst;
+
+/**
+ * Runs a cyclic transfer and processes its reply
+ *
+ * @retval true if the received cyclic data is valid
+ */
+static bool
+Mcb_TestCycle(void);
+
+/**
+ * Checks a mapping entry of the slave
+ *
+ * @param[in] u16Entry
+ *  Entry address, the mapping base for the counter
+ * @param[in] u16Addr
+ *  Expected register address, or number of registers for the counter
+ * @param[in] u16Sz
+ *  Expected register size (bytes), 0 for the counter
+ *
+ * @retval true if the entry matches
+ */
+static bool
+Mcb_TestEntry(uint16_t u16Entry, uint16_t u16Addr, uint16_t u16Sz);
+
+int main(void)
+{
+    mcb::Cyclic<TTestRx, TTestTx> tCyclic(tInst);
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+    int16_t i16Actual = (int16_t)-1234;
+    uint32_t u32Actual = (uint32_t)0x89ABCDEFUL;
+    float fSetpoint = 1.5F;
+    int32_t i32Setpoint = (int32_t)-100000L;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_SetNode(&tInst, TEST_NODE) != false);
+
+    std::memcpy(u16Data, &i16Actual, sizeof(i16Actual));
+    Mcb_SimSetReg(0, TEST_NODE, (uint16_t)0x030U, u16Data, (uint16_t)1U);
+    std::memcpy(u16Data, &u32Actual, sizeof(u32Actual));
+    Mcb_SimSetReg(0, TEST_NODE, (uint16_t)0x031U, u16Data, (uint16_t)2U);
+
+    /** Both layouts mapped in order, as computed at compile time */
+    MCB_TEST_CHECK(tCyclic.enable() > 0);
+    MCB_TEST_CHECK(Mcb_SimIsCyclic(0, TEST_NODE) != false);
+    MCB_TEST_CHECK(tInst.tCyclicRxList.u16MappedSize == TTestRx::u16Words);
+    MCB_TEST_CHECK(tInst.tCyclicTxList.u16MappedSize == TTestTx::u16Words);
+    MCB_TEST_CHECK(Mcb_TestEntry(TEST_RX_MAP_BASE, (uint16_t)TTestRx::u8Num, (uint16_t)0U));
+    MCB_TEST_CHECK(Mcb_TestEntry((TEST_RX_MAP_BASE + 1U), (uint16_t)0x020U, (uint16_t)4U));
+    MCB_TEST_CHECK(Mcb_TestEntry((TEST_RX_MAP_BASE + 2U), (uint16_t)0x021U, (uint16_t)4U));
+    MCB_TEST_CHECK(Mcb_TestEntry((TEST_RX_MAP_BASE + 3U), (uint16_t)0x022U, (uint16_t)2U));
+    MCB_TEST_CHECK(Mcb_TestEntry(TEST_TX_MAP_BASE, (uint16_t)TTestTx::u8Num, (uint16_t)0U));
+    MCB_TEST_CHECK(Mcb_TestEntry((TEST_TX_MAP_BASE + 1U), (uint16_t)0x030U, (uint16_t)2U));
+    MCB_TEST_CHECK(Mcb_TestEntry((TEST_TX_MAP_BASE + 2U), (uint16_t)0x031U, (uint16_t)4U));
+
+    /** Setpoints reach the slave registers */
+    tCyclic.rx<0x020U>() = i32Setpoint;
+    tCyclic.rx<0x021U>() = fSetpoint;
+    tCyclic.rx<0x022U>() = (uint16_t)0xCAFEU;
+    MCB_TEST_CHECK(static_cast<float>(tCyclic.rx<0x021U>()) == fSetpoint);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+
+    (void)Mcb_SimGetReg(0, TEST_NODE, (uint16_t)0x020U, u16Data);
+    MCB_TEST_CHECK(std::memcmp(u16Data, &i32Setpoint, sizeof(i32Setpoint)) == 0);
+    (void)Mcb_SimGetReg(0, TEST_NODE, (uint16_t)0x021U, u16Data);
+    MCB_TEST_CHECK(std::memcmp(u16Data, &fSetpoint, sizeof(fSetpoint)) == 0);
+    (void)Mcb_SimGetReg(0, TEST_NODE, (uint16_t)0x022U, u16Data);
+    MCB_TEST_CHECK(u16Data[0] == (uint16_t)0xCAFEU);
+
+    /** Values come back typed, the one after a single word register included */
+    MCB_TEST_CHECK(static_cast<int16_t>(tCyclic.tx<0x030U>()) == i16Actual);
+    MCB_TEST_CHECK(static_cast<uint32_t>(tCyclic.tx<0x031U>()) == u32Actual);
+
+    return Mcb_TestResult();
+}
+
+static bool Mcb_TestCycle(void)
+{
+    Mcb_EStatus eCfgStat;
+
+    MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+
+    return Mcb_CyclicFrameProcess(&tInst);
+}
+
+static bool Mcb_TestEntry(uint16_t u16Entry, uint16_t u16Addr, uint16_t u16Sz)
+{
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+
+    (void)Mcb_SimGetReg(0, TEST_NODE, u16Entry, u16Data);
+
+    return ((u16Data[0] == u16Addr) && ((u16Sz == (uint16_t)0U) || (u16Data[1] == u16Sz)));
+}
@@ -0,0 +1,169 @@
+/**
+ * @file mcb_test_map.c
+ * @brief Test of the batch mapping of cyclic registers
+ *
+ * A batch not fitting in the cyclic area of the frame is rejected before
+ * any frame is sent, keeping the local mapping as it was. A batch which
+ * fits is mapped and cyclic mode is entered. Enabling the same mapping again
+ * only rewrites the slave entries which do not match, and a slave reset gets
+ * the whole mapping back.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_RX        (uint16_t)0x100U
+#define TEST_ADDR_TX        (uint16_t)0x200U
+/** Entries of an oversized table, odd sizes rounded up to 3 words each */
+#define TEST_BIG_NUM        (uint8_t)12U
+#define TEST_BIG_SZ         (uint16_t)5U
+/** Cycles given to the stop request */
+#define TEST_MAX_CYCLES     (uint16_t)16U
+/** Slave mapping registers */
+#define TEST_RX_MAP_BASE    (uint16_t)0x650U
+#define TEST_TX_MAP_BASE    (uint16_t)0x660U
+
+static Mcb_TInst tInst;
+
+/**
+ * Fills a mapping table of consecutive registers
+ *
+ * @param[out] ptTable
+ *  Mapping table
+ * @param[in] u8Num
+ *  Number of entries
+ * @param[in] u16Addr
+ *  Address of the first register
+ * @param[in] u16Sz
+ *  Size (bytes) of every register
+ */
+static void
+Mcb_TestTable(Mcb_TMapEntry* ptTable, uint8_t u8Num, uint16_t u16Addr, uint16_t u16Sz);
+
+/**
+ * Leaves cyclic mode
+ *
+ * @retval true if the slave is out of cyclic mode
+ */
+static bool
+Mcb_TestStop(void);
+
+/**
+ * Checks the slave keeps the local mapping
+ *
+ * @retval true if every counter and entry matches
+ */
+static bool
+Mcb_TestSlaveMap(void);
+
+int main(void)
+{
+    Mcb_TMapEntry tRx[MAX_MAPPED_REG];
+    Mcb_TMapEntry tTx[MAX_MAPPED_REG];
+    uint32_t u32Frames;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    Mcb_SetNode(&tInst, TEST_NODE);
+
+    /** Oversized tables fail without any frame nor local change */
+    u32Frames = Mcb_SimFrames(0);
+    Mcb_TestTable(tRx, TEST_BIG_NUM, TEST_ADDR_RX, TEST_BIG_SZ);
+    Mcb_TestTable(tTx, (uint8_t)1U, TEST_ADDR_TX, (uint16_t)2U);
+    MCB_TEST_CHECK(Mcb_MapBatch(&tInst, tRx, TEST_BIG_NUM, tTx, (uint8_t)1U) == CYCLIC_ERR_RX_MAP);
+
+    Mcb_TestTable(tRx, (uint8_t)1U, TEST_ADDR_RX, (uint16_t)2U);
+    Mcb_TestTable(tTx, TEST_BIG_NUM, TEST_ADDR_TX, TEST_BIG_SZ);
+    MCB_TEST_CHECK(Mcb_MapBatch(&tInst, tRx, (uint8_t)1U, tTx, TEST_BIG_NUM) == CYCLIC_ERR_TX_MAP);
+
+    MCB_TEST_CHECK(Mcb_SimFrames(0) == u32Frames);
+    MCB_TEST_CHECK(tInst.tCyclicRxList.u8Mapped == (uint8_t)0U);
+    MCB_TEST_CHECK(tInst.tCyclicTxList.u8Mapped == (uint8_t)0U);
+    MCB_TEST_CHECK((tRx[0].pData == NULL) && (tTx[0].pData == NULL));
+
+    /** A full cyclic area is still accepted */
+    Mcb_TestTable(tRx, (uint8_t)(MCB_FRM_MAX_CYCLIC_SZ / 4U), TEST_ADDR_RX, (uint16_t)8U);
+    Mcb_TestTable(tTx, (uint8_t)1U, TEST_ADDR_TX, (uint16_t)2U);
+    MCB_TEST_CHECK(Mcb_MapBatch(&tInst, tRx, (uint8_t)(MCB_FRM_MAX_CYCLIC_SZ / 4U), tTx, (uint8_t)1U) > 0);
+    MCB_TEST_CHECK(tInst.tCyclicRxList.u8Mapped == (uint8_t)(MCB_FRM_MAX_CYCLIC_SZ / 4U));
+    MCB_TEST_CHECK(Mcb_SimIsCyclic(0, TEST_NODE) != false);
+    MCB_TEST_CHECK(Mcb_TestSlaveMap() != false);
+
+    /** Same mapping kept by the slave, nothing but the cyclic start is written */
+    MCB_TEST_CHECK(Mcb_TestStop() != false);
+    u32Frames = Mcb_SimFrames(0);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    uint32_t u32Kept = Mcb_SimFrames(0) - u32Frames;
+
+    /** A single entry lost, only that one and the counters are written */
+    uint16_t u16Entry[2] = { (uint16_t)0U, (uint16_t)0U };
+    MCB_TEST_CHECK(Mcb_TestStop() != false);
+    Mcb_SimSetReg(0, TEST_NODE, (uint16_t)(TEST_RX_MAP_BASE + 3U), u16Entry, (uint16_t)2U);
+    u32Frames = Mcb_SimFrames(0);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    MCB_TEST_CHECK((Mcb_SimFrames(0) - u32Frames) <= (u32Kept + 4U));
+    MCB_TEST_CHECK(Mcb_TestSlaveMap() != false);
+
+    /** Whole mapping lost on a slave reset */
+    MCB_TEST_CHECK(Mcb_TestStop() != false);
+    Mcb_SimResetNode(0, TEST_NODE);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    MCB_TEST_CHECK(Mcb_SimIsCyclic(0, TEST_NODE) != false);
+    MCB_TEST_CHECK(Mcb_TestSlaveMap() != false);
+
+    return Mcb_TestResult();
+}
+
+static void Mcb_TestTable(Mcb_TMapEntry* ptTable, uint8_t u8Num, uint16_t u16Addr, uint16_t u16Sz)
+{
+    for (uint8_t u8Idx = (uint8_t)0U; u8Idx < u8Num; u8Idx++)
+    {
+        ptTable[u8Idx].u16Addr = (uint16_t)(u16Addr + u8Idx);
+        ptTable[u8Idx].u16Sz = u16Sz;
+        ptTable[u8Idx].pData = NULL;
+    }
+}
+
+static bool Mcb_TestStop(void)
+{
+    Mcb_EStatus eCfgStat;
+
+    (void)Mcb_DisableCyclic(&tInst);
+    for (uint16_t u16Cycle = (uint16_t)0U; u16Cycle < TEST_MAX_CYCLES; u16Cycle++)
+    {
+        if (Mcb_CyclicProcessLatch(&tInst, &eCfgStat) == false)
+        {
+            break;
+        }
+        (void)Mcb_CyclicFrameProcess(&tInst);
+    }
+
+    return (Mcb_SimIsCyclic(0, TEST_NODE) == false);
+}
+
+static bool Mcb_TestSlaveMap(void)
+{
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+    const uint16_t u16Base[2] = { TEST_RX_MAP_BASE, TEST_TX_MAP_BASE };
+    const Mcb_TMappingList* ptList[2] = { &tInst.tCyclicRxList, &tInst.tCyclicTxList };
+    bool isMatch = true;
+
+    for (uint8_t u8List = (uint8_t)0U; u8List < (uint8_t)2U; u8List++)
+    {
+        (void)Mcb_SimGetReg(0, TEST_NODE, u16Base[u8List], u16Data);
+        isMatch = isMatch && (u16Data[0] == ptList[u8List]->u8Mapped);
+
+        for (uint8_t u8Idx = (uint8_t)0U; u8Idx < ptList[u8List]->u8Mapped; u8Idx++)
+        {
+            (void)Mcb_SimGetReg(0, TEST_NODE, (uint16_t)(u16Base[u8List] + u8Idx + 1U), u16Data);
+            isMatch = isMatch && (u16Data[0] == ptList[u8List]->u16Addr[u8Idx])
+                      && (u16Data[1] == ptList[u8List]->u16Sz[u8Idx]);
+        }
+    }
+
+    return isMatch;
+}
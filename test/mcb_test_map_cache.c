@@ -0,0 +1,174 @@
+/**
+ * @file mcb_test_map_cache.c
+ * @brief Test of the cyclic mapping along with the read cache
+ *
+ * The mapping counters are cacheable registers. The mapping check on a
+ * cyclic start must not be served from the cache, so a slave reset is still
+ * detected, and mapping registers written by a batch mapping must not be
+ * read back from the cache with their former values.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_RX        (uint16_t)0x100U
+#define TEST_ADDR_TX        (uint16_t)0x200U
+/** Registers mapped on each direction */
+#define TEST_MAP_NUM        (uint16_t)2U
+/** Cycles given to the stop request */
+#define TEST_MAX_CYCLES     (uint16_t)16U
+/** Slave mapping registers */
+#define TEST_RX_MAP_BASE    (uint16_t)0x650U
+#define TEST_TX_MAP_BASE    (uint16_t)0x660U
+
+static Mcb_TInst tInst;
+
+/**
+ * Maps consecutive registers of a word and enables cyclic mode
+ *
+ * @param[in] u8Num
+ *  Number of Rx & Tx registers
+ *
+ * @retval Mcb_MapBatch result
+ */
+static int32_t
+Mcb_TestMap(uint8_t u8Num);
+
+/**
+ * Leaves cyclic mode
+ *
+ * @retval true if the slave is out of cyclic mode
+ */
+static bool
+Mcb_TestStop(void);
+
+/**
+ * Gets the info of a register, so the read cache learns its access type
+ *
+ * @param[in] u16Addr
+ *  Register address
+ *
+ * @retval true if the info has been read
+ */
+static bool
+Mcb_TestInfo(uint16_t u16Addr);
+
+/**
+ * Reads a register through the instance, i.e. through the read cache
+ *
+ * @param[in] u16Addr
+ *  Register address
+ *
+ * @retval First word of the register, 0xFFFF on error
+ */
+static uint16_t
+Mcb_TestRead(uint16_t u16Addr);
+
+int main(void)
+{
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    Mcb_SetNode(&tInst, TEST_NODE);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx <= TEST_MAP_NUM; u16Idx++)
+    {
+        Mcb_SimSetInfo(0, TEST_NODE, (uint16_t)(TEST_RX_MAP_BASE + u16Idx), RW_ACCESS, (uint8_t)0U);
+        Mcb_SimSetInfo(0, TEST_NODE, (uint16_t)(TEST_TX_MAP_BASE + u16Idx), RW_ACCESS, (uint8_t)0U);
+        MCB_TEST_CHECK(Mcb_TestInfo((uint16_t)(TEST_RX_MAP_BASE + u16Idx)) != false);
+        MCB_TEST_CHECK(Mcb_TestInfo((uint16_t)(TEST_TX_MAP_BASE + u16Idx)) != false);
+    }
+
+    /** Counters and entries cached while the first mapping is active */
+    MCB_TEST_CHECK(Mcb_TestMap((uint8_t)TEST_MAP_NUM) > 0);
+    MCB_TEST_CHECK(Mcb_TestStop() != false);
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx <= TEST_MAP_NUM; u16Idx++)
+    {
+        (void)Mcb_TestRead((uint16_t)(TEST_RX_MAP_BASE + u16Idx));
+        (void)Mcb_TestRead((uint16_t)(TEST_TX_MAP_BASE + u16Idx));
+    }
+    uint32_t u32Hits = tInst.tReadCache.u32Hits;
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_RX_MAP_BASE) == TEST_MAP_NUM);
+    MCB_TEST_CHECK(tInst.tReadCache.u32Hits > u32Hits);
+
+    /** A slave reset is seen through the cached counters */
+    Mcb_SimResetNode(0, TEST_NODE);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    MCB_TEST_CHECK(Mcb_SimIsCyclic(0, TEST_NODE) != false);
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_RX_MAP_BASE, u16Data);
+    MCB_TEST_CHECK(u16Data[0] == TEST_MAP_NUM);
+
+    /** Counters written by a new mapping are read back from the slave */
+    MCB_TEST_CHECK(Mcb_TestStop() != false);
+    MCB_TEST_CHECK(Mcb_TestMap((uint8_t)(TEST_MAP_NUM - 1U)) > 0);
+    MCB_TEST_CHECK(Mcb_TestStop() != false);
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_RX_MAP_BASE) == (uint16_t)(TEST_MAP_NUM - 1U));
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_TX_MAP_BASE) == (uint16_t)(TEST_MAP_NUM - 1U));
+
+    return Mcb_TestResult();
+}
+
+static int32_t Mcb_TestMap(uint8_t u8Num)
+{
+    Mcb_TMapEntry tRx[MAX_MAPPED_REG];
+    Mcb_TMapEntry tTx[MAX_MAPPED_REG];
+
+    for (uint8_t u8Idx = (uint8_t)0U; u8Idx < u8Num; u8Idx++)
+    {
+        tRx[u8Idx].u16Addr = (uint16_t)(TEST_ADDR_RX + u8Idx);
+        tRx[u8Idx].u16Sz = (uint16_t)2U;
+        tTx[u8Idx].u16Addr = (uint16_t)(TEST_ADDR_TX + u8Idx);
+        tTx[u8Idx].u16Sz = (uint16_t)2U;
+    }
+
+    return Mcb_MapBatch(&tInst, tRx, u8Num, tTx, u8Num);
+}
+
+static bool Mcb_TestStop(void)
+{
+    Mcb_EStatus eCfgStat;
+
+    (void)Mcb_DisableCyclic(&tInst);
+    for (uint16_t u16Cycle = (uint16_t)0U; u16Cycle < TEST_MAX_CYCLES; u16Cycle++)
+    {
+        if (Mcb_CyclicProcessLatch(&tInst, &eCfgStat) == false)
+        {
+            break;
+        }
+        (void)Mcb_CyclicFrameProcess(&tInst);
+    }
+
+    return (Mcb_SimIsCyclic(0, TEST_NODE) == false);
+}
+
+static bool Mcb_TestInfo(uint16_t u16Addr)
+{
+    Mcb_TInfoMsg tInfo;
+
+    tInfo.u16Node = TEST_NODE;
+    tInfo.u16Addr = u16Addr;
+    do
+    {
+        tInst.Mcb_GetInfo(&tInst, &tInfo);
+    } while ((tInfo.eStatus != MCB_GETINFO_SUCCESS) && (tInfo.eStatus != MCB_GETINFO_ERROR));
+
+    return (tInfo.eStatus == MCB_GETINFO_SUCCESS);
+}
+
+static uint16_t Mcb_TestRead(uint16_t u16Addr)
+{
+    Mcb_TMsg tMsg;
+
+    tMsg.u16Node = TEST_NODE;
+    tMsg.u16Addr = u16Addr;
+    tMsg.u16Size = (uint16_t)1U;
+    do
+    {
+        tInst.Mcb_Read(&tInst, &tMsg);
+    } while ((tMsg.eStatus != MCB_READ_SUCCESS) && (tMsg.eStatus != MCB_READ_ERROR));
+
+    return (tMsg.eStatus == MCB_READ_SUCCESS) ? tMsg.u16Data[0] : (uint16_t)0xFFFFU;
+}
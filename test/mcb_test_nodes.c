@@ -0,0 +1,188 @@
+/**
+ * @file mcb_test_nodes.c
+ * @brief Test of the config transactions addressed to several nodes
+ *
+ * Interleaved transactions on different nodes must each get the reply of
+ * their own node, also when more nodes are interleaved than replies can be
+ * parked. Nodes without transaction state of their own are rejected
+ * without any transfer, and config over cyclic requests are only accepted
+ * for the cyclic node.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_ADDR_SETPOINT  (uint16_t)0x100U
+#define TEST_ADDR_ACTUAL    (uint16_t)0x200U
+#define TEST_ADDR_TAG       (uint16_t)0x300U
+/** Nodes read at once, more than the replies that can be parked */
+#define TEST_NODES          (uint16_t)3U
+/** Cycles given to a config over cyclic request */
+#define TEST_MAX_CYCLES     (uint16_t)16U
+
+static Mcb_TInst tInst;
+
+/** Last config over cyclic reply */
+static Mcb_TMsg tCfgRpy;
+static bool isCfgRpy;
+
+/**
+ * Gets the tag held by a node
+ *
+ * @param[in] u16Node
+ *  Target node
+ *
+ * @retval Tag
+ */
+static uint16_t
+Mcb_TestTag(uint16_t u16Node);
+
+/**
+ * Runs cyclic frames until a config over cyclic request is completed
+ *
+ * @param[in] u16Node
+ *  Target node
+ * @param[in] isWrite
+ *  Write request if true, read request otherwise
+ *
+ * @retval Completion state
+ */
+static Mcb_EStatus
+Mcb_TestCfgOverCyclic(uint16_t u16Node, bool isWrite);
+
+/**
+ * Stores the reply of a config over cyclic request
+ *
+ * @param[in] ptInst
+ *  Instance
+ * @param[in] pMcbMsg
+ *  Reply
+ */
+static void
+Mcb_TestCfgEvnt(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+
+int main(void)
+{
+    Mcb_TMsg tMsg[TEST_NODES];
+    Mcb_TInfoMsg tInfo;
+    uint32_t u32Frames;
+    bool isDone[TEST_NODES];
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    Mcb_AttachCfgOverCyclicCB(&tInst, Mcb_TestCfgEvnt);
+
+    for (uint16_t u16Node = (uint16_t)0U; u16Node < MCB_SIM_NODES; u16Node++)
+    {
+        uint16_t u16Tag = Mcb_TestTag(u16Node);
+
+        Mcb_SimSetReg(0, u16Node, TEST_ADDR_TAG, &u16Tag, (uint16_t)1U);
+    }
+
+    /** Reads of two and then three nodes, one transfer of each in turns */
+    for (uint16_t u16Num = (uint16_t)2U; u16Num <= TEST_NODES; u16Num++)
+    {
+        for (uint16_t u16Idx = (uint16_t)0U; u16Idx < u16Num; u16Idx++)
+        {
+            tMsg[u16Idx].u16Node = (uint16_t)(u16Idx + 1U);
+            tMsg[u16Idx].u16Addr = TEST_ADDR_TAG;
+            isDone[u16Idx] = false;
+        }
+        for (uint16_t u16Left = u16Num; u16Left != (uint16_t)0U;)
+        {
+            for (uint16_t u16Idx = (uint16_t)0U; u16Idx < u16Num; u16Idx++)
+            {
+                if (isDone[u16Idx] == false)
+                {
+                    tInst.Mcb_Read(&tInst, &tMsg[u16Idx]);
+                    isDone[u16Idx] = ((tMsg[u16Idx].eStatus == MCB_READ_SUCCESS)
+                                      || (tMsg[u16Idx].eStatus == MCB_READ_ERROR));
+                    u16Left -= (isDone[u16Idx] != false) ? (uint16_t)1U : (uint16_t)0U;
+                }
+            }
+        }
+        for (uint16_t u16Idx = (uint16_t)0U; u16Idx < u16Num; u16Idx++)
+        {
+            MCB_TEST_CHECK(tMsg[u16Idx].eStatus == MCB_READ_SUCCESS);
+            MCB_TEST_CHECK(tMsg[u16Idx].u16Data[0] == Mcb_TestTag((uint16_t)(u16Idx + 1U)));
+        }
+    }
+
+    /** Nodes out of range fail at once */
+    u32Frames = Mcb_SimFrames(0);
+    tMsg[0].u16Node = MCB_NUMBER_NODES;
+    tMsg[0].u16Size = (uint16_t)1U;
+    tInst.Mcb_Read(&tInst, &tMsg[0]);
+    MCB_TEST_CHECK(tMsg[0].eStatus == MCB_READ_ERROR);
+    tInst.Mcb_Write(&tInst, &tMsg[0]);
+    MCB_TEST_CHECK(tMsg[0].eStatus == MCB_WRITE_ERROR);
+    tInfo.u16Node = (uint16_t)(MCB_NUMBER_NODES + 1U);
+    tInfo.u16Addr = TEST_ADDR_TAG;
+    tInst.Mcb_GetInfo(&tInst, &tInfo);
+    MCB_TEST_CHECK(tInfo.eStatus == MCB_GETINFO_ERROR);
+    MCB_TEST_CHECK(Mcb_SimFrames(0) == u32Frames);
+    MCB_TEST_CHECK(Mcb_SetNode(&tInst, MCB_NUMBER_NODES) == false);
+
+    /** Config over cyclic requests only reach the cyclic node */
+    Mcb_SetNode(&tInst, (uint16_t)1U);
+    MCB_TEST_CHECK(Mcb_RxMap(&tInst, TEST_ADDR_SETPOINT, (uint16_t)2U) != NULL);
+    MCB_TEST_CHECK(Mcb_TxMap(&tInst, TEST_ADDR_ACTUAL, (uint16_t)2U) != NULL);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+
+    MCB_TEST_CHECK(Mcb_TestCfgOverCyclic((uint16_t)2U, false) == MCB_READ_ERROR);
+    MCB_TEST_CHECK(Mcb_TestCfgOverCyclic((uint16_t)2U, true) == MCB_WRITE_ERROR);
+    MCB_TEST_CHECK(Mcb_TestCfgOverCyclic((uint16_t)1U, false) == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(tCfgRpy.u16Data[0] == Mcb_TestTag((uint16_t)1U));
+
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+    (void)Mcb_SimGetReg(0, (uint16_t)2U, TEST_ADDR_TAG, u16Data);
+    MCB_TEST_CHECK(u16Data[0] == Mcb_TestTag((uint16_t)2U));
+
+    return Mcb_TestResult();
+}
+
+static uint16_t Mcb_TestTag(uint16_t u16Node)
+{
+    return (uint16_t)(0xA000U | u16Node);
+}
+
+static Mcb_EStatus Mcb_TestCfgOverCyclic(uint16_t u16Node, bool isWrite)
+{
+    Mcb_TMsg tMsg;
+    Mcb_EStatus eCfgStat;
+
+    tMsg.u16Node = u16Node;
+    tMsg.u16Addr = TEST_ADDR_TAG;
+    tMsg.u16Size = (uint16_t)1U;
+    tMsg.u16Data[0] = (uint16_t)0xDEADU;
+    tCfgRpy.eStatus = MCB_STANDBY;
+    isCfgRpy = false;
+
+    if (isWrite != false)
+    {
+        tInst.Mcb_Write(&tInst, &tMsg);
+    }
+    else
+    {
+        tInst.Mcb_Read(&tInst, &tMsg);
+    }
+
+    for (uint16_t u16Cycle = (uint16_t)0U; (isCfgRpy == false) && (u16Cycle < TEST_MAX_CYCLES); u16Cycle++)
+    {
+        MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+        (void)Mcb_CyclicFrameProcess(&tInst);
+    }
+
+    return tCfgRpy.eStatus;
+}
+
+static void Mcb_TestCfgEvnt(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
+{
+    (void)ptInst;
+
+    tCfgRpy = *pMcbMsg;
+    isCfgRpy = true;
+}
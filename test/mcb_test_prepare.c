@@ -0,0 +1,107 @@
+/**
+ * @file mcb_test_prepare.c
+ * @brief Test of the idle cyclic frames assembled in advance
+ *
+ * A frame prepared while the stop request is on the wire is never sent, as
+ * cyclic mode is left on that cycle. The config frames sent afterwards and
+ * the next cyclic start must not pick it up, the first cyclic frame carries
+ * the setpoints written meanwhile.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_SETPOINT  (uint16_t)0x100U
+#define TEST_ADDR_ACTUAL    (uint16_t)0x200U
+#define TEST_ADDR_CONFIG    (uint16_t)0x300U
+/** Cycles given to the stop request */
+#define TEST_MAX_CYCLES     (uint16_t)16U
+
+static Mcb_TInst tInst;
+
+/**
+ * Gets the setpoint register of the slave
+ *
+ * @retval Setpoint value
+ */
+static uint16_t
+Mcb_TestSetpoint(void);
+
+int main(void)
+{
+    Mcb_TMsg tMsg;
+    Mcb_EStatus eCfgStat;
+    uint16_t u16Cycle;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    Mcb_SetNode(&tInst, TEST_NODE);
+
+    uint16_t* pu16Setpoint = (uint16_t*)Mcb_RxMap(&tInst, TEST_ADDR_SETPOINT, (uint16_t)2U);
+    MCB_TEST_CHECK(Mcb_TxMap(&tInst, TEST_ADDR_ACTUAL, (uint16_t)2U) != NULL);
+    MCB_TEST_CHECK(pu16Setpoint != NULL);
+    if (pu16Setpoint == NULL)
+    {
+        return Mcb_TestResult();
+    }
+
+    *pu16Setpoint = (uint16_t)0x1111U;
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+    (void)Mcb_CyclicFrameProcess(&tInst);
+    MCB_TEST_CHECK(Mcb_TestSetpoint() == (uint16_t)0x1111U);
+
+    /** Stop, preparing the next frame while every transfer is on the wire */
+    (void)Mcb_DisableCyclic(&tInst);
+    for (u16Cycle = (uint16_t)0U; u16Cycle < TEST_MAX_CYCLES; u16Cycle++)
+    {
+        if (Mcb_CyclicProcessLatch(&tInst, &eCfgStat) == false)
+        {
+            break;
+        }
+        (void)Mcb_CyclicPrepare(&tInst);
+        (void)Mcb_CyclicFrameProcess(&tInst);
+    }
+    MCB_TEST_CHECK(u16Cycle < TEST_MAX_CYCLES);
+    MCB_TEST_CHECK(Mcb_SimIsCyclic(0, TEST_NODE) == false);
+
+    /** Config traffic out of cyclic mode */
+    tMsg.u16Node = TEST_NODE;
+    tMsg.u16Addr = TEST_ADDR_CONFIG;
+    tMsg.u16Size = (uint16_t)1U;
+    tMsg.u16Data[0] = (uint16_t)0x5555U;
+    do
+    {
+        tInst.Mcb_Write(&tInst, &tMsg);
+    } while ((tMsg.eStatus != MCB_WRITE_SUCCESS) && (tMsg.eStatus != MCB_WRITE_ERROR));
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_WRITE_SUCCESS);
+
+    /** The first frame after the restart sends the new setpoint */
+    *pu16Setpoint = (uint16_t)0x2222U;
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+    MCB_TEST_CHECK(Mcb_CyclicFrameProcess(&tInst) != false);
+    MCB_TEST_CHECK(Mcb_TestSetpoint() == (uint16_t)0x2222U);
+
+    /** Prepared frames are still used within cyclic mode */
+    *pu16Setpoint = (uint16_t)0x3333U;
+    MCB_TEST_CHECK(Mcb_CyclicPrepare(&tInst) != false);
+    MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+    MCB_TEST_CHECK(Mcb_CyclicFrameProcess(&tInst) != false);
+    MCB_TEST_CHECK(Mcb_TestSetpoint() == (uint16_t)0x3333U);
+
+    return Mcb_TestResult();
+}
+
+static uint16_t Mcb_TestSetpoint(void)
+{
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_SETPOINT, u16Data);
+
+    return u16Data[0];
+}
@@ -0,0 +1,164 @@
+/**
+ * @file mcb_test_read_batch.c
+ * @brief Test of the pipelined read of a list of registers
+ *
+ * Registers larger than a config frame and registers replying an error are
+ * mixed into the list. Each of them must be read again on its own once the
+ * segments still pending on the slave have been clocked out, so the data of
+ * every register, before and after it, is the one of that register. With
+ * corrupted frames, registers may fail but never get wrong data.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_BASE      (uint16_t)0x400U
+/** Registers of the list, wider than a read batch chunk */
+#define TEST_REGS           (uint16_t)24U
+/** Size of the segmented registers, three frames of the default config size */
+#define TEST_SEG_SZ         (uint16_t)10U
+/** Frames corrupted on the second run, one of every */
+#define TEST_CORRUPT_EVERY  (uint32_t)7UL
+
+static Mcb_TInst tInst;
+
+/**
+ * Gets the kind of a register of the list
+ *
+ * @param[in] u16Idx
+ *  Register index
+ *
+ * @retval 0 plain register, 1 segmented register, 2 write only register
+ */
+static uint16_t
+Mcb_TestKind(uint16_t u16Idx);
+
+/**
+ * Gets a word of a register of the list
+ *
+ * @param[in] u16Idx
+ *  Register index
+ * @param[in] u16Word
+ *  Word index
+ *
+ * @retval Word value
+ */
+static uint16_t
+Mcb_TestWord(uint16_t u16Idx, uint16_t u16Word);
+
+/**
+ * Reads the whole list and checks every register
+ *
+ * @param[in] isLossy
+ *  Frames are corrupted, registers may fail
+ */
+static void
+Mcb_TestBatch(bool isLossy);
+
+int main(void)
+{
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_REGS; u16Idx++)
+    {
+        uint16_t u16Sz = (Mcb_TestKind(u16Idx) == (uint16_t)1U) ? TEST_SEG_SZ : (uint16_t)1U;
+
+        for (uint16_t u16Word = (uint16_t)0U; u16Word < u16Sz; u16Word++)
+        {
+            u16Data[u16Word] = Mcb_TestWord(u16Idx, u16Word);
+        }
+        Mcb_SimSetReg(0, TEST_NODE, (uint16_t)(TEST_ADDR_BASE + u16Idx), u16Data, u16Sz);
+        Mcb_SimSetInfo(0, TEST_NODE, (uint16_t)(TEST_ADDR_BASE + u16Idx),
+                       (Mcb_TestKind(u16Idx) == (uint16_t)2U) ? WO_ACCESS : RW_ACCESS, (uint8_t)0U);
+    }
+
+    Mcb_TestBatch(false);
+
+    Mcb_SimCorruptEvery(0, TEST_CORRUPT_EVERY);
+    Mcb_TestBatch(true);
+
+    /** The bus is left clean for the next transaction */
+    Mcb_SimCorruptEvery(0, (uint32_t)0UL);
+    Mcb_TestBatch(false);
+
+    return Mcb_TestResult();
+}
+
+static uint16_t Mcb_TestKind(uint16_t u16Idx)
+{
+    uint16_t u16Kind = (uint16_t)0U;
+
+    /** Segmented registers alone, in a row and at the end of a chunk, then a write only one */
+    if ((u16Idx == (uint16_t)1U) || (u16Idx == (uint16_t)5U) || (u16Idx == (uint16_t)6U)
+        || (u16Idx == (uint16_t)(MCB_READ_BATCH_SZ - 1U)) || (u16Idx == (uint16_t)(TEST_REGS - 1U)))
+    {
+        u16Kind = (uint16_t)1U;
+    }
+    else if ((u16Idx == (uint16_t)2U) || (u16Idx == (uint16_t)9U))
+    {
+        u16Kind = (uint16_t)2U;
+    }
+    else
+    {
+        /** Nothing */
+    }
+
+    return u16Kind;
+}
+
+static uint16_t Mcb_TestWord(uint16_t u16Idx, uint16_t u16Word)
+{
+    return (uint16_t)(0xB000U | (u16Idx << 4U) | u16Word);
+}
+
+static void Mcb_TestBatch(bool isLossy)
+{
+    uint16_t u16Addr[TEST_REGS];
+    Mcb_TMsg tMsg[TEST_REGS];
+    uint16_t u16Read;
+    uint16_t u16Ok = (uint16_t)0U;
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_REGS; u16Idx++)
+    {
+        u16Addr[u16Idx] = (uint16_t)(TEST_ADDR_BASE + u16Idx);
+    }
+
+    u16Read = Mcb_ReadBatch(&tInst, TEST_NODE, u16Addr, tMsg, TEST_REGS);
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_REGS; u16Idx++)
+    {
+        uint16_t u16Kind = Mcb_TestKind(u16Idx);
+        uint16_t u16Sz = (u16Kind == (uint16_t)1U) ? TEST_SEG_SZ : (uint16_t)1U;
+
+        MCB_TEST_CHECK(tMsg[u16Idx].u16Addr == u16Addr[u16Idx]);
+        if (tMsg[u16Idx].eStatus != MCB_READ_SUCCESS)
+        {
+            MCB_TEST_CHECK((isLossy != false) || (u16Kind == (uint16_t)2U));
+            continue;
+        }
+
+        MCB_TEST_CHECK(u16Kind != (uint16_t)2U);
+        MCB_TEST_CHECK(tMsg[u16Idx].u16Size >= u16Sz);
+        for (uint16_t u16Word = (uint16_t)0U; u16Word < u16Sz; u16Word++)
+        {
+            if (tMsg[u16Idx].u16Data[u16Word] != Mcb_TestWord(u16Idx, u16Word))
+            {
+                printf("reg %u word %u: %04x, expected %04x\n", (unsigned)u16Idx, (unsigned)u16Word,
+                       (unsigned)tMsg[u16Idx].u16Data[u16Word], (unsigned)Mcb_TestWord(u16Idx, u16Word));
+                MCB_TEST_CHECK(false);
+            }
+        }
+        u16Ok++;
+    }
+
+    MCB_TEST_CHECK(u16Read == u16Ok);
+    MCB_TEST_CHECK(u16Ok > (uint16_t)0U);
+    MCB_TEST_CHECK((isLossy != false) || (u16Ok == (uint16_t)(TEST_REGS - 2U)));
+}
@@ -0,0 +1,155 @@
+/**
+ * @file mcb_test_read_cache.c
+ * @brief Test of the read cache in blocking mode
+ *
+ * Read only registers are served from the cache after their first read,
+ * read / write ones until they are written and write only ones never. Two
+ * registers sharing a slot must not evict each other on every read, the
+ * colliding one is read from the slave with a single config transaction.
+ * Misses only count reads of cached registers.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_RO        (uint16_t)0x100U
+#define TEST_ADDR_RW        (uint16_t)0x101U
+#define TEST_ADDR_WO        (uint16_t)0x102U
+/** Register sharing the cache slot of TEST_ADDR_RO */
+#define TEST_ADDR_COLLIDE   (uint16_t)(TEST_ADDR_RO + MCB_READ_CACHE_SZ)
+/** Transfers of a single word read, request and reply */
+#define TEST_READ_FRAMES    (uint32_t)2UL
+/** Reads of the colliding registers */
+#define TEST_READS          (uint16_t)8U
+
+static Mcb_TInst tInst;
+
+/**
+ * Reads a register through the instance
+ *
+ * @param[in] u16Addr
+ *  Register address
+ * @param[out] pu16Value
+ *  First word of the register
+ *
+ * @retval Read status
+ */
+static Mcb_EStatus
+Mcb_TestRead(uint16_t u16Addr, uint16_t* pu16Value);
+
+/**
+ * Writes a register through the instance
+ *
+ * @param[in] u16Addr
+ *  Register address
+ * @param[in] u16Value
+ *  Register value
+ *
+ * @retval Write status
+ */
+static Mcb_EStatus
+Mcb_TestWrite(uint16_t u16Addr, uint16_t u16Value);
+
+int main(void)
+{
+    uint16_t u16Value;
+    uint32_t u32Hits;
+    uint32_t u32Misses;
+    uint32_t u32Frames;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+
+    u16Value = (uint16_t)0x1111U;
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_RO, &u16Value, (uint16_t)1U);
+    Mcb_SimSetInfo(0, TEST_NODE, TEST_ADDR_RO, RO_ACCESS, (uint8_t)0U);
+    u16Value = (uint16_t)0x2222U;
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_RW, &u16Value, (uint16_t)1U);
+    Mcb_SimSetInfo(0, TEST_NODE, TEST_ADDR_RW, RW_ACCESS, (uint8_t)0U);
+    u16Value = (uint16_t)0x3333U;
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_WO, &u16Value, (uint16_t)1U);
+    Mcb_SimSetInfo(0, TEST_NODE, TEST_ADDR_WO, WO_ACCESS, (uint8_t)0U);
+    u16Value = (uint16_t)0x4444U;
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_COLLIDE, &u16Value, (uint16_t)1U);
+    Mcb_SimSetInfo(0, TEST_NODE, TEST_ADDR_COLLIDE, RO_ACCESS, (uint8_t)0U);
+
+    /** Read only, learnt and read from the slave once */
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_RO, &u16Value) == MCB_READ_SUCCESS);
+    u32Frames = Mcb_SimFrames(0);
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_RO, &u16Value) == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(u16Value == (uint16_t)0x1111U);
+    MCB_TEST_CHECK(Mcb_SimFrames(0) == u32Frames);
+    Mcb_ReadCacheStats(&tInst, &u32Hits, &u32Misses);
+    MCB_TEST_CHECK((u32Hits == (uint32_t)1UL) && (u32Misses == (uint32_t)1UL));
+
+    /** Read / write, read again from the slave once written */
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_RW, &u16Value) == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_RW, &u16Value) == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(Mcb_TestWrite(TEST_ADDR_RW, (uint16_t)0x2223U) == MCB_WRITE_SUCCESS);
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_RW, &u16Value) == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(u16Value == (uint16_t)0x2223U);
+    Mcb_ReadCacheStats(&tInst, &u32Hits, &u32Misses);
+    MCB_TEST_CHECK((u32Hits == (uint32_t)2UL) && (u32Misses == (uint32_t)3UL));
+
+    /** Write only, never cached nor counted */
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_WO, &u16Value) == MCB_READ_ERROR);
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_WO, &u16Value) == MCB_READ_ERROR);
+    Mcb_ReadCacheStats(&tInst, &u32Hits, &u32Misses);
+    MCB_TEST_CHECK((u32Hits == (uint32_t)2UL) && (u32Misses == (uint32_t)3UL));
+
+    /** Colliding register, read from the slave without get info while the first one keeps its slot */
+    for (uint16_t u16Read = (uint16_t)0U; u16Read < TEST_READS; u16Read++)
+    {
+        u32Frames = Mcb_SimFrames(0);
+        MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_COLLIDE, &u16Value) == MCB_READ_SUCCESS);
+        MCB_TEST_CHECK(u16Value == (uint16_t)0x4444U);
+        MCB_TEST_CHECK((Mcb_SimFrames(0) - u32Frames) == TEST_READ_FRAMES);
+
+        u32Frames = Mcb_SimFrames(0);
+        MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_RO, &u16Value) == MCB_READ_SUCCESS);
+        MCB_TEST_CHECK(u16Value == (uint16_t)0x1111U);
+        MCB_TEST_CHECK(Mcb_SimFrames(0) == u32Frames);
+    }
+    Mcb_ReadCacheStats(&tInst, &u32Hits, &u32Misses);
+    MCB_TEST_CHECK((u32Hits == (uint32_t)(2UL + TEST_READS)) && (u32Misses == (uint32_t)3UL));
+
+    /** A flush frees every slot */
+    Mcb_ReadCacheFlush(&tInst);
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_COLLIDE, &u16Value) == MCB_READ_SUCCESS);
+    u32Frames = Mcb_SimFrames(0);
+    MCB_TEST_CHECK(Mcb_TestRead(TEST_ADDR_COLLIDE, &u16Value) == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(Mcb_SimFrames(0) == u32Frames);
+
+    Mcb_Deinit(&tInst);
+
+    return Mcb_TestResult();
+}
+
+static Mcb_EStatus Mcb_TestRead(uint16_t u16Addr, uint16_t* pu16Value)
+{
+    Mcb_TMsg tMsg;
+
+    tMsg.u16Node = TEST_NODE;
+    tMsg.u16Addr = u16Addr;
+    tInst.Mcb_Read(&tInst, &tMsg);
+    *pu16Value = tMsg.u16Data[0];
+
+    return tMsg.eStatus;
+}
+
+static Mcb_EStatus Mcb_TestWrite(uint16_t u16Addr, uint16_t u16Value)
+{
+    Mcb_TMsg tMsg;
+
+    tMsg.u16Node = TEST_NODE;
+    tMsg.u16Addr = u16Addr;
+    tMsg.u16Size = (uint16_t)1U;
+    tMsg.u16Data[0] = u16Value;
+    tInst.Mcb_Write(&tInst, &tMsg);
+
+    return tMsg.eStatus;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file mcb_test_seqlock.c
+ * @brief Stress test of the cyclic reception snapshots
+ *
+ * A thread runs the cyclic frames while another one keeps taking snapshots
+ * of the reception buffer. On every cycle the slave sends all its mapped
+ * registers derived from the cycle count, so a snapshot mixing two frames
+ * shows up as registers which do not match each other. Versions seen by the
+ * reader must never be odd nor go backwards.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include <pthread.h>
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_SETPOINT  (uint16_t)0x100U
+#define TEST_ADDR_ACTUAL    (uint16_t)0x200U
+/** Mapped Tx registers, one word each */
+#define TEST_TX_REGS        (uint16_t)12U
+/** Cyclic frames run while the reader is taking snapshots */
+#define TEST_CYCLES         (uint32_t)200000UL
+
+static Mcb_TInst tInst;
+
+/** Set by the cyclic thread once it is done */
+static volatile bool isCyclicDone;
+
+/** Snapshots taken, and snapshots torn or going backwards */
+static uint32_t u32Snapshots;
+static uint32_t u32Torn;
+
+/**
+ * Gets the value of a Tx register on a cycle
+ *
+ * @param[in] u32Cycle
+ *  Cycle count
+ * @param[in] u16Reg
+ *  Register index
+ *
+ * @retval Register value
+ */
+static uint16_t
+Mcb_TestValue(uint32_t u32Cycle, uint16_t u16Reg);
+
+/**
+ * Takes snapshots until the cyclic thread is done
+ *
+ * @param[in] pArg
+ *  Not used
+ *
+ * @retval NULL
+ */
+static void*
+Mcb_TestReader(void* pArg);
+
+int main(void)
+{
+    pthread_t tReader;
+    Mcb_EStatus eCfgStat;
+    uint32_t u32Bad = (uint32_t)0UL;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    Mcb_SetNode(&tInst, TEST_NODE);
+
+    MCB_TEST_CHECK(Mcb_RxMap(&tInst, TEST_ADDR_SETPOINT, (uint16_t)2U) != NULL);
+    for (uint16_t u16Reg = (uint16_t)0U; u16Reg < TEST_TX_REGS; u16Reg++)
+    {
+        uint16_t u16Value = Mcb_TestValue((uint32_t)0UL, u16Reg);
+
+        Mcb_SimSetReg(0, TEST_NODE, (uint16_t)(TEST_ADDR_ACTUAL + u16Reg), &u16Value, (uint16_t)1U);
+        MCB_TEST_CHECK(Mcb_TxMap(&tInst, (uint16_t)(TEST_ADDR_ACTUAL + u16Reg), (uint16_t)2U) != NULL);
+    }
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+
+    isCyclicDone = false;
+    MCB_TEST_CHECK(pthread_create(&tReader, NULL, Mcb_TestReader, NULL) == 0);
+
+    for (uint32_t u32Cycle = (uint32_t)1UL; u32Cycle <= TEST_CYCLES; u32Cycle++)
+    {
+        for (uint16_t u16Reg = (uint16_t)0U; u16Reg < TEST_TX_REGS; u16Reg++)
+        {
+            uint16_t u16Value = Mcb_TestValue(u32Cycle, u16Reg);
+
+            Mcb_SimSetReg(0, TEST_NODE, (uint16_t)(TEST_ADDR_ACTUAL + u16Reg), &u16Value, (uint16_t)1U);
+        }
+
+        if ((Mcb_CyclicProcessLatch(&tInst, &eCfgStat) == false) || (Mcb_CyclicFrameProcess(&tInst) == false))
+        {
+            u32Bad++;
+        }
+    }
+
+    isCyclicDone = true;
+    (void)pthread_join(tReader, NULL);
+
+    printf("%lu cycles, %lu snapshots\n", (unsigned long)TEST_CYCLES, (unsigned long)u32Snapshots);
+    MCB_TEST_CHECK(u32Bad == (uint32_t)0UL);
+    MCB_TEST_CHECK(u32Torn == (uint32_t)0UL);
+    MCB_TEST_CHECK(u32Snapshots > (uint32_t)0UL);
+
+    return Mcb_TestResult();
+}
+
+static uint16_t Mcb_TestValue(uint32_t u32Cycle, uint16_t u16Reg)
+{
+    /** Mixes the cycle count so every word changes on every cycle */
+    return (uint16_t)((u32Cycle * 0x9E37UL) + u16Reg);
+}
+
+static void* Mcb_TestReader(void* pArg)
+{
+    uint16_t u16Buf[TEST_TX_REGS];
+    uint32_t u32LastSeq = (uint32_t)0UL;
+    uint32_t u32Seq;
+
+    (void)pArg;
+
+    while (isCyclicDone == false)
+    {
+        u32Seq = Mcb_CyclicRxSnapshot(&tInst, u16Buf, TEST_TX_REGS);
+        u32Snapshots++;
+
+        /** Registers of a single frame, recover its cycle from the first one. Nothing received on version 0 */
+        for (uint16_t u16Reg = (uint16_t)1U; (u32Seq != (uint32_t)0UL) && (u16Reg < TEST_TX_REGS); u16Reg++)
+        {
+            if (u16Buf[u16Reg] != (uint16_t)(u16Buf[0] + u16Reg))
+            {
+                u32Torn++;
+                break;
+            }
+        }
+
+        if ((u32Seq & (uint32_t)1UL) || (u32Seq < u32LastSeq))
+        {
+            u32Torn++;
+        }
+        u32LastSeq = u32Seq;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,483 @@
+/**
+ * @file mcb_test_sim.c
+ * @brief Simulated MCB slaves and host platform hooks used by the tests
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_ADDR_COMM_STATE (uint16_t)0x640U
+#define SIM_RX_MAP_BASE     (uint16_t)0x650U
+#define SIM_TX_MAP_BASE     (uint16_t)0x660U
+
+/** Info flag of the registers with an info set by the test */
+#define SIM_INFO_SET        (uint16_t)0x8000U
+
+/** Registers of a slave */
+typedef struct
+{
+    /** Register values */
+    uint16_t u16Data[MCB_SIM_REGS][MCB_MAX_DATA_SZ];
+    /** Register sizes (words), 0 if never written */
+    uint16_t u16Sz[MCB_SIM_REGS];
+    /** Access type (bits 0-2) and cyclic type (bits 3-4) of the register */
+    uint16_t u16Info[MCB_SIM_REGS];
+} Mcb_TSimRegs;
+
+/** Simulated slave */
+typedef struct
+{
+    /** Registers, allocated on the first access */
+    Mcb_TSimRegs* ptRegs;
+    /** Command of the reply being clocked out, MCB_REQ_IDLE if there is none */
+    uint16_t u16RpyCmd;
+    /** Address of the reply */
+    uint16_t u16RpyAddr;
+    /** Reply data */
+    uint16_t u16RpyBuf[MCB_MAX_DATA_SZ];
+    /** Reply size (words) */
+    uint16_t u16RpySz;
+    /** Reply words already clocked out */
+    uint16_t u16RpyPos;
+    /** Data of a segmented write being received */
+    uint16_t u16WrBuf[MCB_MAX_DATA_SZ];
+    /** Words of the segmented write received so far */
+    uint16_t u16WrSz;
+    /** Number of completed register writes */
+    uint32_t u32Writes;
+} Mcb_TSimNode;
+
+/** Simulated bus */
+typedef struct
+{
+    /** Interface notified on transfer completion */
+    Mcb_TIntf* ptIntf;
+    /** Config words per frame */
+    uint16_t u16CfgSz;
+    /** Node selected for the next transfer */
+    uint16_t u16Node;
+    /** Number of transfers */
+    uint32_t u32Frames;
+    /** Reply CRC corruption period, 0 if disabled */
+    uint32_t u32CorruptEvery;
+    /** Frames received with a wrong CRC */
+    uint32_t u32CrcErrors;
+    /** Indicates if the IRQ event is left to the test instead of raised on transfer completion */
+    bool isDeferIrq;
+    /** 1 if a transfer has completed and its IRQ event is still to be raised by the test */
+    int iIrqPending;
+    /** Slaves */
+    Mcb_TSimNode tNode[MCB_SIM_NODES];
+} Mcb_TSimBus;
+
+static Mcb_TSimBus tSimBus[MCB_NUMBER_RESOURCES];
+
+/**
+ * Gets the registers of a slave
+ *
+ * @param[in] ptNode
+ *  Target slave
+ *
+ * @retval Registers
+ */
+static Mcb_TSimRegs*
+Mcb_SimRegs(Mcb_TSimNode* ptNode);
+
+/**
+ * Clocks out the next segment of the pending reply
+ *
+ * @param[in] ptNode
+ *  Target slave
+ * @param[out] pu16Out
+ *  Frame to be sent
+ * @param[in] u16CfgSz
+ *  Config words per frame
+ */
+static void
+Mcb_SimReplyOut(Mcb_TSimNode* ptNode, uint16_t* pu16Out, uint16_t u16CfgSz);
+
+/**
+ * Processes the config request of a received frame
+ *
+ * @param[in] ptNode
+ *  Target slave
+ * @param[in] pu16In
+ *  Received frame
+ * @param[in] u16CfgSz
+ *  Config words per frame
+ */
+static void
+Mcb_SimRequest(Mcb_TSimNode* ptNode, const uint16_t* pu16In, uint16_t u16CfgSz);
+
+/**
+ * Copies the cyclic words between a frame and the registers of a mapping
+ *
+ * @param[in] ptNode
+ *  Target slave
+ * @param[in] u16Base
+ *  Mapping base address, SIM_RX_MAP_BASE or SIM_TX_MAP_BASE
+ * @param[in,out] pu16Cyclic
+ *  Cyclic area of the frame
+ * @param[in] u16CyclicSz
+ *  Cyclic area size (words)
+ */
+static void
+Mcb_SimCyclic(Mcb_TSimNode* ptNode, uint16_t u16Base, uint16_t* pu16Cyclic, uint16_t u16CyclicSz);
+
+void Mcb_SimInit(void)
+{
+    for (uint16_t u16Id = (uint16_t)0U; u16Id < MCB_NUMBER_RESOURCES; u16Id++)
+    {
+        for (uint16_t u16Node = (uint16_t)0U; u16Node < MCB_SIM_NODES; u16Node++)
+        {
+            free(tSimBus[u16Id].tNode[u16Node].ptRegs);
+        }
+        memset((void*)&tSimBus[u16Id], 0, sizeof(tSimBus[u16Id]));
+
+        tSimBus[u16Id].u16CfgSz = MCB_FRM_CONFIG_SZ;
+        for (uint16_t u16Node = (uint16_t)0U; u16Node < MCB_SIM_NODES; u16Node++)
+        {
+            tSimBus[u16Id].tNode[u16Node].u16RpyCmd = MCB_REQ_IDLE;
+        }
+    }
+}
+
+void Mcb_SimAttach(uint16_t u16Id, Mcb_TIntf* ptIntf)
+{
+    tSimBus[u16Id].ptIntf = ptIntf;
+}
+
+void Mcb_SimSetConfigSize(uint16_t u16Id, uint16_t u16CfgSz)
+{
+    tSimBus[u16Id].u16CfgSz = u16CfgSz;
+}
+
+void Mcb_SimSetReg(uint16_t u16Id, uint16_t u16Node, uint16_t u16Addr, const uint16_t* pu16Data, uint16_t u16Sz)
+{
+    Mcb_TSimRegs* ptRegs = Mcb_SimRegs(&tSimBus[u16Id].tNode[u16Node]);
+
+    memcpy((void*)ptRegs->u16Data[u16Addr], (const void*)pu16Data, (u16Sz * sizeof(uint16_t)));
+    ptRegs->u16Sz[u16Addr] = u16Sz;
+}
+
+uint16_t Mcb_SimGetReg(uint16_t u16Id, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu16Data)
+{
+    Mcb_TSimRegs* ptRegs = Mcb_SimRegs(&tSimBus[u16Id].tNode[u16Node]);
+
+    memcpy((void*)pu16Data, (const void*)ptRegs->u16Data[u16Addr], sizeof(ptRegs->u16Data[u16Addr]));
+
+    return ptRegs->u16Sz[u16Addr];
+}
+
+void Mcb_SimSetInfo(uint16_t u16Id, uint16_t u16Node, uint16_t u16Addr, uint8_t u8AccessType, uint8_t u8CyclicType)
+{
+    Mcb_TSimRegs* ptRegs = Mcb_SimRegs(&tSimBus[u16Id].tNode[u16Node]);
+
+    ptRegs->u16Info[u16Addr] = (uint16_t)(SIM_INFO_SET | (u8AccessType & 0x7U) | ((u8CyclicType & 0x3U) << 3U));
+}
+
+void Mcb_SimResetNode(uint16_t u16Id, uint16_t u16Node)
+{
+    Mcb_TSimNode* ptNode = &tSimBus[u16Id].tNode[u16Node];
+    Mcb_TSimRegs* ptRegs = Mcb_SimRegs(ptNode);
+
+    ptRegs->u16Data[SIM_ADDR_COMM_STATE][0] = (uint16_t)0U;
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < (uint16_t)16U; u16Idx++)
+    {
+        memset((void*)ptRegs->u16Data[SIM_RX_MAP_BASE + u16Idx], 0, sizeof(ptRegs->u16Data[0]));
+        memset((void*)ptRegs->u16Data[SIM_TX_MAP_BASE + u16Idx], 0, sizeof(ptRegs->u16Data[0]));
+    }
+
+    ptNode->u16RpyCmd = MCB_REQ_IDLE;
+    ptNode->u16WrSz = (uint16_t)0U;
+}
+
+void Mcb_SimCorruptEvery(uint16_t u16Id, uint32_t u32Every)
+{
+    tSimBus[u16Id].u32CorruptEvery = u32Every;
+}
+
+void Mcb_SimDeferIrq(uint16_t u16Id, bool isDefer)
+{
+    tSimBus[u16Id].isDeferIrq = isDefer;
+}
+
+bool Mcb_SimTakeIrq(uint16_t u16Id)
+{
+    return (__atomic_exchange_n(&tSimBus[u16Id].iIrqPending, 0, __ATOMIC_ACQUIRE) != 0);
+}
+
+uint32_t Mcb_SimFrames(uint16_t u16Id)
+{
+    return tSimBus[u16Id].u32Frames;
+}
+
+uint32_t Mcb_SimCrcErrors(uint16_t u16Id)
+{
+    return tSimBus[u16Id].u32CrcErrors;
+}
+
+uint32_t Mcb_SimWrites(uint16_t u16Id, uint16_t u16Node)
+{
+    return tSimBus[u16Id].tNode[u16Node].u32Writes;
+}
+
+bool Mcb_SimIsCyclic(uint16_t u16Id, uint16_t u16Node)
+{
+    return (Mcb_SimRegs(&tSimBus[u16Id].tNode[u16Node])->u16Data[SIM_ADDR_COMM_STATE][0] == (uint16_t)2U);
+}
+
+void Mcb_IntfSPITransfer(uint16_t u16Id, uint16_t* pu16In, uint16_t* pu16Out, uint16_t u16Sz)
+{
+    Mcb_TSimBus* ptBus = &tSimBus[u16Id];
+    uint16_t u16Out[MCB_FRM_MAX_SZ];
+    uint16_t u16In[MCB_FRM_MAX_SZ];
+    uint16_t u16CfgSz = ptBus->u16CfgSz;
+    uint16_t u16CyclicSz = (uint16_t)0U;
+
+    memcpy((void*)u16In, (const void*)pu16In, (u16Sz * sizeof(uint16_t)));
+
+    if (u16Sz > (MCB_FRM_HEAD_SZ + u16CfgSz + MCB_FRM_CRC_SZ))
+    {
+        u16CyclicSz = u16Sz - (MCB_FRM_HEAD_SZ + u16CfgSz + MCB_FRM_CRC_SZ);
+    }
+
+    if (ptBus->u16Node < MCB_SIM_NODES)
+    {
+        Mcb_TSimNode* ptNode = &ptBus->tNode[ptBus->u16Node];
+        bool isCyclic = (Mcb_SimRegs(ptNode)->u16Data[SIM_ADDR_COMM_STATE][0] == (uint16_t)2U);
+
+        /** The reply is shifted out while the request is shifted in */
+        memset((void*)u16Out, 0, sizeof(u16Out));
+        Mcb_SimReplyOut(ptNode, u16Out, u16CfgSz);
+        if ((isCyclic != false) && (u16CyclicSz != (uint16_t)0U))
+        {
+            Mcb_SimCyclic(ptNode, SIM_TX_MAP_BASE, &u16Out[MCB_FRM_HEAD_SZ + u16CfgSz], u16CyclicSz);
+        }
+        u16Out[u16Sz - 1U] = Mcb_IntfComputeCrc(u16Out, (uint16_t)(u16Sz - 1U));
+
+        if ((ptBus->u32CorruptEvery != (uint32_t)0UL)
+            && ((ptBus->u32Frames % ptBus->u32CorruptEvery) == (ptBus->u32CorruptEvery - 1UL)))
+        {
+            u16Out[u16Sz - 1U] ^= (uint16_t)1U;
+        }
+
+        if (Mcb_IntfCheckCrc(u16Id, u16In, u16Sz) != false)
+        {
+            if ((isCyclic != false) && (u16CyclicSz != (uint16_t)0U))
+            {
+                Mcb_SimCyclic(ptNode, SIM_RX_MAP_BASE, &u16In[MCB_FRM_HEAD_SZ + u16CfgSz], u16CyclicSz);
+            }
+            Mcb_SimRequest(ptNode, u16In, u16CfgSz);
+        }
+        else
+        {
+            ptBus->u32CrcErrors++;
+        }
+    }
+    else
+    {
+        /** Nobody drives the line */
+        memset((void*)u16Out, 0xFF, sizeof(u16Out));
+    }
+
+    memcpy((void*)pu16Out, (const void*)u16Out, (u16Sz * sizeof(uint16_t)));
+    ptBus->u32Frames++;
+
+    if (ptBus->isDeferIrq != false)
+    {
+        __atomic_store_n(&ptBus->iIrqPending, 1, __ATOMIC_RELEASE);
+    }
+    else if (ptBus->ptIntf != NULL)
+    {
+        Mcb_IntfIRQEvent(ptBus->ptIntf);
+    }
+    else
+    {
+        /** Nothing */
+    }
+}
+
+void Mcb_IntfSelectNode(uint16_t u16Id, uint16_t u16Node)
+{
+    tSimBus[u16Id].u16Node = u16Node;
+}
+
+bool Mcb_IntfIsReady(uint16_t u16Id)
+{
+    (void)u16Id;
+
+    return true;
+}
+
+uint8_t Mcb_IntfReadIRQ(uint16_t u16Id)
+{
+    (void)u16Id;
+
+    return (uint8_t)1U;
+}
+
+uint32_t Mcb_GetMillis(void)
+{
+    return (uint32_t)(Mcb_TestNanos() / 1000000ULL);
+}
+
+static Mcb_TSimRegs* Mcb_SimRegs(Mcb_TSimNode* ptNode)
+{
+    if (ptNode->ptRegs == NULL)
+    {
+        ptNode->ptRegs = (Mcb_TSimRegs*)calloc(1U, sizeof(Mcb_TSimRegs));
+        if (ptNode->ptRegs == NULL)
+        {
+            printf("out of memory\n");
+            exit(1);
+        }
+    }
+
+    return ptNode->ptRegs;
+}
+
+static void Mcb_SimReplyOut(Mcb_TSimNode* ptNode, uint16_t* pu16Out, uint16_t u16CfgSz)
+{
+    uint16_t u16Rem;
+    uint16_t u16Seg = (uint16_t)0U;
+
+    if (ptNode->u16RpyCmd == MCB_REQ_IDLE)
+    {
+        pu16Out[MCB_FRM_HEAD_IDX] = (uint16_t)(MCB_REQ_IDLE << 1U);
+    }
+    else
+    {
+        u16Rem = ptNode->u16RpySz - ptNode->u16RpyPos;
+        if (u16Rem > u16CfgSz)
+        {
+            u16Seg = (uint16_t)1U;
+            u16Rem = u16CfgSz;
+        }
+
+        pu16Out[MCB_FRM_HEAD_IDX] = (uint16_t)((ptNode->u16RpyAddr << 4U) | (ptNode->u16RpyCmd << 1U) | u16Seg);
+        memcpy((void*)&pu16Out[MCB_FRM_CONFIG_IDX], (const void*)&ptNode->u16RpyBuf[ptNode->u16RpyPos],
+               (u16Rem * sizeof(uint16_t)));
+        ptNode->u16RpyPos += u16Rem;
+
+        if (u16Seg == (uint16_t)0U)
+        {
+            ptNode->u16RpyCmd = MCB_REQ_IDLE;
+        }
+    }
+}
+
+static void Mcb_SimRequest(Mcb_TSimNode* ptNode, const uint16_t* pu16In, uint16_t u16CfgSz)
+{
+    Mcb_TSimRegs* ptRegs = Mcb_SimRegs(ptNode);
+    uint16_t u16Addr = (uint16_t)(pu16In[MCB_FRM_HEAD_IDX] >> 4U);
+    uint16_t u16Cmd = (uint16_t)((pu16In[MCB_FRM_HEAD_IDX] >> 1U) & 0x7U);
+    bool isSeg = ((pu16In[MCB_FRM_HEAD_IDX] & 0x1U) != 0U);
+    uint8_t u8Access = (uint8_t)(ptRegs->u16Info[u16Addr] & 0x7U);
+    Mcb_TInfoMsgData tInfo;
+
+    /** Requests are not taken until a segmented reply is completely clocked out */
+    if ((u16Cmd == MCB_REQ_IDLE) || (ptNode->u16RpyCmd != MCB_REQ_IDLE))
+    {
+        return;
+    }
+
+    ptNode->u16RpyAddr = u16Addr;
+    ptNode->u16RpyPos = (uint16_t)0U;
+
+    switch (u16Cmd)
+    {
+        case MCB_REQ_READ:
+            ptNode->u16RpySz = (ptRegs->u16Sz[u16Addr] != (uint16_t)0U) ? ptRegs->u16Sz[u16Addr] : (uint16_t)1U;
+            memcpy((void*)ptNode->u16RpyBuf, (const void*)ptRegs->u16Data[u16Addr],
+                   (ptNode->u16RpySz * sizeof(uint16_t)));
+            ptNode->u16RpyCmd = (u8Access == WO_ACCESS) ? MCB_REP_READ_ERROR : MCB_REP_ACK;
+            break;
+        case MCB_REQ_WRITE:
+            if ((ptNode->u16WrSz + u16CfgSz) <= MCB_MAX_DATA_SZ)
+            {
+                memcpy((void*)&ptNode->u16WrBuf[ptNode->u16WrSz], (const void*)&pu16In[MCB_FRM_CONFIG_IDX],
+                       (u16CfgSz * sizeof(uint16_t)));
+                ptNode->u16WrSz += u16CfgSz;
+            }
+
+            /** Written words are echoed on the acknowledge */
+            ptNode->u16RpySz = u16CfgSz;
+            memcpy((void*)ptNode->u16RpyBuf, (const void*)&pu16In[MCB_FRM_CONFIG_IDX], (u16CfgSz * sizeof(uint16_t)));
+            ptNode->u16RpyCmd = MCB_REP_ACK;
+
+            if (u8Access == RO_ACCESS)
+            {
+                ptNode->u16RpyCmd = MCB_REP_WRITE_ERROR;
+                ptNode->u16WrSz = (uint16_t)0U;
+            }
+            else if (isSeg == false)
+            {
+                if (ptRegs->u16Sz[u16Addr] == (uint16_t)0U)
+                {
+                    ptRegs->u16Sz[u16Addr] = ptNode->u16WrSz;
+                }
+                memcpy((void*)ptRegs->u16Data[u16Addr], (const void*)ptNode->u16WrBuf,
+                       (ptNode->u16WrSz * sizeof(uint16_t)));
+                ptNode->u16WrSz = (uint16_t)0U;
+                ptNode->u32Writes++;
+            }
+            else
+            {
+                /** Nothing */
+            }
+            break;
+        case MCB_REQ_GETINFO:
+            memset((void*)&tInfo, 0, sizeof(tInfo));
+            tInfo.tInfoData.u8Size = (ptRegs->u16Sz[u16Addr] != (uint16_t)0U) ? (ptRegs->u16Sz[u16Addr] * 2U) : 2U;
+            tInfo.tInfoData.u8DataType = UINT16_TYPE;
+            tInfo.tInfoData.u8CyclicType = (ptRegs->u16Info[u16Addr] >> 3U) & 0x3U;
+            tInfo.tInfoData.u8AccessType = u8Access;
+            ptNode->u16RpySz = (uint16_t)(sizeof(Mcb_TInfoData) / sizeof(uint16_t));
+            memcpy((void*)ptNode->u16RpyBuf, (const void*)tInfo.u16Data, sizeof(Mcb_TInfoData));
+            ptNode->u16RpyCmd = MCB_REP_ACK;
+            break;
+        default:
+            ptNode->u16RpySz = (uint16_t)0U;
+            ptNode->u16RpyCmd = MCB_REP_ERROR;
+            break;
+    }
+}
+
+static void Mcb_SimCyclic(Mcb_TSimNode* ptNode, uint16_t u16Base, uint16_t* pu16Cyclic, uint16_t u16CyclicSz)
+{
+    Mcb_TSimRegs* ptRegs = Mcb_SimRegs(ptNode);
+    uint16_t u16Offset = (uint16_t)0U;
+    uint16_t u16Mapped = ptRegs->u16Data[u16Base][0];
+    uint16_t u16Addr;
+    uint16_t u16Words;
+
+    for (uint16_t u16Idx = (uint16_t)1U; (u16Idx <= u16Mapped) && (u16Idx < (uint16_t)16U); u16Idx++)
+    {
+        u16Addr = ptRegs->u16Data[u16Base + u16Idx][0] & (MCB_SIM_REGS - 1U);
+        u16Words = (uint16_t)((ptRegs->u16Data[u16Base + u16Idx][1] + 1U) >> 1U);
+
+        if ((u16Offset + u16Words) > u16CyclicSz)
+        {
+            break;
+        }
+
+        if (u16Base == SIM_TX_MAP_BASE)
+        {
+            memcpy((void*)&pu16Cyclic[u16Offset], (const void*)ptRegs->u16Data[u16Addr], (u16Words * sizeof(uint16_t)));
+        }
+        else
+        {
+            memcpy((void*)ptRegs->u16Data[u16Addr], (const void*)&pu16Cyclic[u16Offset], (u16Words * sizeof(uint16_t)));
+            if (ptRegs->u16Sz[u16Addr] == (uint16_t)0U)
+            {
+                ptRegs->u16Sz[u16Addr] = u16Words;
+            }
+        }
+        u16Offset += u16Words;
+    }
+}
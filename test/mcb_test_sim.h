@@ -0,0 +1,213 @@
+/**
+ * @file mcb_test_sim.h
+ * @brief Simulated MCB slaves and host platform hooks used by the tests
+ *
+ * Each resource id is a bus with up to MCB_SIM_NODES slaves. A slave keeps
+ * its registers, answers config requests one transfer later (segmenting the
+ * replies larger than the config size) and exchanges the registers mapped
+ * through 0x650/0x660 on cyclic frames once 0x640 is set to 2.
+ * Transfers complete immediately, the IRQ event of the attached interface is
+ * raised before Mcb_IntfSPITransfer returns unless the test defers it.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#ifndef MCB_TEST_SIM_H
+#define MCB_TEST_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mcb.h"
+#include "mcb_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of simulated slaves on each bus */
+#define MCB_SIM_NODES       (uint16_t)32U
+
+/** Register address space of a slave */
+#define MCB_SIM_REGS        (uint16_t)0x1000U
+
+/**
+ * Resets every simulated bus, slaves lose their registers
+ */
+void
+Mcb_SimInit(void);
+
+/**
+ * Attaches the interface notified by the transfers of a bus
+ *
+ * @param[in] u16Id
+ *  Bus (resource) id
+ * @param[in] ptIntf
+ *  Interface of the instance driving the bus
+ */
+void
+Mcb_SimAttach(uint16_t u16Id, Mcb_TIntf* ptIntf);
+
+/**
+ * Sets the config data size of the slaves of a bus
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u16CfgSz
+ *  Config words per frame
+ */
+void
+Mcb_SimSetConfigSize(uint16_t u16Id, uint16_t u16CfgSz);
+
+/**
+ * Sets the value of a slave register
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u16Node
+ *  Slave node
+ * @param[in] u16Addr
+ *  Register address
+ * @param[in] pu16Data
+ *  Register value
+ * @param[in] u16Sz
+ *  Register size (words)
+ */
+void
+Mcb_SimSetReg(uint16_t u16Id, uint16_t u16Node, uint16_t u16Addr, const uint16_t* pu16Data, uint16_t u16Sz);
+
+/**
+ * Gets the value of a slave register
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u16Node
+ *  Slave node
+ * @param[in] u16Addr
+ *  Register address
+ * @param[out] pu16Data
+ *  Register value, MCB_MAX_DATA_SZ words
+ *
+ * @retval Register size (words)
+ */
+uint16_t
+Mcb_SimGetReg(uint16_t u16Id, uint16_t u16Node, uint16_t u16Addr, uint16_t* pu16Data);
+
+/**
+ * Sets the info returned by get info requests of a register. Registers
+ * without info are reported as read-write, not cyclic.
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u16Node
+ *  Slave node
+ * @param[in] u16Addr
+ *  Register address
+ * @param[in] u8AccessType
+ *  RW_ACCESS, RO_ACCESS or WO_ACCESS
+ * @param[in] u8CyclicType
+ *  0 if the register can not be mapped
+ */
+void
+Mcb_SimSetInfo(uint16_t u16Id, uint16_t u16Node, uint16_t u16Addr, uint8_t u8AccessType, uint8_t u8CyclicType);
+
+/**
+ * Power cycles a slave, it loses its mapping and leaves cyclic mode
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u16Node
+ *  Slave node
+ */
+void
+Mcb_SimResetNode(uint16_t u16Id, uint16_t u16Node);
+
+/**
+ * Corrupts the CRC of one reply out of every u32Every, 0 disables it
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u32Every
+ *  Corruption period (frames)
+ */
+void
+Mcb_SimCorruptEvery(uint16_t u16Id, uint32_t u32Every);
+
+/**
+ * Leaves the IRQ event of the transfers of a bus to the test, which raises
+ * it from another thread to simulate the reply latency of the slaves
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] isDefer
+ *  true if the IRQ event is raised by the test, false if it is raised on
+ *  transfer completion
+ */
+void
+Mcb_SimDeferIrq(uint16_t u16Id, bool isDefer);
+
+/**
+ * Takes a deferred IRQ event, it may be called from any thread
+ *
+ * @param[in] u16Id
+ *  Bus id
+ *
+ * @retval true if a transfer has completed since the last call
+ */
+bool
+Mcb_SimTakeIrq(uint16_t u16Id);
+
+/**
+ * Gets the number of transfers of a bus
+ *
+ * @param[in] u16Id
+ *  Bus id
+ *
+ * @retval Number of transfers
+ */
+uint32_t
+Mcb_SimFrames(uint16_t u16Id);
+
+/**
+ * Gets the number of frames with a wrong CRC received by the slaves of a bus
+ *
+ * @param[in] u16Id
+ *  Bus id
+ *
+ * @retval Number of wrong frames
+ */
+uint32_t
+Mcb_SimCrcErrors(uint16_t u16Id);
+
+/**
+ * Gets the number of register writes completed by a slave, segmented ones
+ * count once
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u16Node
+ *  Slave node
+ *
+ * @retval Number of writes
+ */
+uint32_t
+Mcb_SimWrites(uint16_t u16Id, uint16_t u16Node);
+
+/**
+ * Checks if a slave is in cyclic mode
+ *
+ * @param[in] u16Id
+ *  Bus id
+ * @param[in] u16Node
+ *  Slave node
+ *
+ * @retval true if the slave exchanges cyclic data
+ */
+bool
+Mcb_SimIsCyclic(uint16_t u16Id, uint16_t u16Node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCB_TEST_SIM_H */
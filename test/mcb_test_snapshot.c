@@ -0,0 +1,182 @@
+/**
+ * @file mcb_test_snapshot.c
+ * @brief Test of the parameter snapshot save and restore
+ *
+ * The RW parameters of the simulated drive are saved, changed and restored,
+ * a register larger than a config frame included. Snapshots of another
+ * firmware are rejected without any write. A reply lost while restoring
+ * stops the restore, and no write is sent twice.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include "mcb_snapshot.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_PATH           "mcb_test_snapshot.bin"
+/** Single word RW registers */
+#define TEST_ADDR_SMALL     (uint16_t)0x100U
+#define TEST_SMALL_NUM      (uint16_t)8U
+/** RW register larger than a config frame */
+#define TEST_ADDR_LARGE     (uint16_t)0x200U
+#define TEST_LARGE_SZ       (uint16_t)10U
+/** Read only register, not saved */
+#define TEST_ADDR_RO        (uint16_t)0x300U
+/** Registers of the dictionary */
+#define TEST_ADDR_NUM       (uint16_t)(TEST_SMALL_NUM + 2U)
+/** Registers of the snapshot */
+#define TEST_SNAP_NUM       (uint16_t)(TEST_SMALL_NUM + 1U)
+/** Frames of the firmware identity read, request and reply */
+#define TEST_FW_FRAMES      (uint32_t)2UL
+/** Frame of the restore whose reply is lost, counted from its first frame */
+#define TEST_LOST_FRAME     (uint32_t)5UL
+/** Writes sent until the lost reply, one per frame after the firmware identity read */
+#define TEST_LOST_WRITES    (uint32_t)((TEST_LOST_FRAME - TEST_FW_FRAMES) + 1UL)
+
+static Mcb_TInst tInst;
+
+/**
+ * Sets the RW registers of the drive
+ *
+ * @param[in] u16Seed
+ *  Seed of the register values
+ */
+static void
+Mcb_TestSetRegs(uint16_t u16Seed);
+
+/**
+ * Checks the RW registers of the drive
+ *
+ * @param[in] u16Seed
+ *  Seed of the expected register values
+ *
+ * @retval true if every register holds its value
+ */
+static bool
+Mcb_TestCheckRegs(uint16_t u16Seed);
+
+/**
+ * Sets the firmware version of the drive
+ *
+ * @param[in] u16Build
+ *  Build number, last word of the version
+ */
+static void
+Mcb_TestSetFw(uint16_t u16Build);
+
+int main(void)
+{
+    uint16_t u16Addr[TEST_ADDR_NUM];
+    Mcb_TDictEntry tBuf[TEST_ADDR_NUM];
+    Mcb_TDict tDict;
+    Mcb_TSnapStats tStats;
+    uint32_t u32Writes;
+    uint16_t u16Value = (uint16_t)0x5A5AU;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    Mcb_TestSetFw((uint16_t)7U);
+    Mcb_TestSetRegs((uint16_t)0x1000U);
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_RO, &u16Value, (uint16_t)1U);
+    Mcb_SimSetInfo(0, TEST_NODE, TEST_ADDR_RO, RO_ACCESS, (uint8_t)0U);
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_SMALL_NUM; u16Idx++)
+    {
+        u16Addr[u16Idx] = TEST_ADDR_SMALL + u16Idx;
+    }
+    u16Addr[TEST_SMALL_NUM] = TEST_ADDR_LARGE;
+    u16Addr[TEST_SMALL_NUM + 1U] = TEST_ADDR_RO;
+
+    /** Instances out of blocking mode */
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_SnapshotRestore(&tInst, TEST_NODE, TEST_PATH, &tStats) == MCB_SNAP_ERR_STATE);
+    Mcb_Deinit(&tInst);
+
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_DictBuild(&tDict, &tInst, TEST_NODE, u16Addr, TEST_ADDR_NUM, tBuf) == MCB_DICT_OK);
+
+    /** Save, read only registers skipped */
+    MCB_TEST_CHECK(Mcb_SnapshotSave(&tInst, TEST_NODE, &tDict, TEST_PATH, &tStats) == MCB_SNAP_OK);
+    MCB_TEST_CHECK((tStats.u16Regs == TEST_SNAP_NUM) && (tStats.u16Failed == (uint16_t)0U));
+
+    /** Restore of changed registers, each written once */
+    Mcb_TestSetRegs((uint16_t)0x2000U);
+    u32Writes = Mcb_SimWrites(0, TEST_NODE);
+    MCB_TEST_CHECK(Mcb_SnapshotRestore(&tInst, TEST_NODE, TEST_PATH, &tStats) == MCB_SNAP_OK);
+    MCB_TEST_CHECK((tStats.u16Regs == TEST_SNAP_NUM) && (tStats.u16Failed == (uint16_t)0U));
+    MCB_TEST_CHECK((Mcb_SimWrites(0, TEST_NODE) - u32Writes) == (uint32_t)TEST_SNAP_NUM);
+    MCB_TEST_CHECK(Mcb_TestCheckRegs((uint16_t)0x1000U));
+
+    /** The drive has been updated, nothing is written */
+    Mcb_TestSetFw((uint16_t)8U);
+    Mcb_TestSetRegs((uint16_t)0x2000U);
+    u32Writes = Mcb_SimWrites(0, TEST_NODE);
+    MCB_TEST_CHECK(Mcb_SnapshotRestore(&tInst, TEST_NODE, TEST_PATH, &tStats) == MCB_SNAP_ERR_FW);
+    MCB_TEST_CHECK(Mcb_SimWrites(0, TEST_NODE) == u32Writes);
+    MCB_TEST_CHECK(Mcb_TestCheckRegs((uint16_t)0x2000U));
+    Mcb_TestSetFw((uint16_t)7U);
+
+    /** Reply of a pipelined write lost, the restore stops without writing anything twice */
+    u32Writes = Mcb_SimWrites(0, TEST_NODE);
+    Mcb_SimCorruptEvery(0, (Mcb_SimFrames(0) + TEST_LOST_FRAME + 1UL));
+    MCB_TEST_CHECK(Mcb_SnapshotRestore(&tInst, TEST_NODE, TEST_PATH, &tStats) == MCB_SNAP_ERR_BUS);
+    Mcb_SimCorruptEvery(0, (uint32_t)0UL);
+    MCB_TEST_CHECK((Mcb_SimWrites(0, TEST_NODE) - u32Writes) == TEST_LOST_WRITES);
+
+    /** Restore again once the bus is back */
+    MCB_TEST_CHECK(Mcb_SnapshotRestore(&tInst, TEST_NODE, TEST_PATH, &tStats) == MCB_SNAP_OK);
+    MCB_TEST_CHECK(Mcb_TestCheckRegs((uint16_t)0x1000U));
+
+    /** Missing file */
+    MCB_TEST_CHECK(remove(TEST_PATH) == 0);
+    MCB_TEST_CHECK(Mcb_SnapshotRestore(&tInst, TEST_NODE, TEST_PATH, &tStats) == MCB_SNAP_ERR_IO);
+    Mcb_Deinit(&tInst);
+
+    return Mcb_TestResult();
+}
+
+static void Mcb_TestSetRegs(uint16_t u16Seed)
+{
+    uint16_t u16Value[TEST_LARGE_SZ];
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_SMALL_NUM; u16Idx++)
+    {
+        u16Value[0] = u16Seed + u16Idx;
+        Mcb_SimSetReg(0, TEST_NODE, (TEST_ADDR_SMALL + u16Idx), u16Value, (uint16_t)1U);
+    }
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_LARGE_SZ; u16Idx++)
+    {
+        u16Value[u16Idx] = u16Seed + (uint16_t)0x100U + u16Idx;
+    }
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_LARGE, u16Value, TEST_LARGE_SZ);
+}
+
+static bool Mcb_TestCheckRegs(uint16_t u16Seed)
+{
+    uint16_t u16Value[MCB_MAX_DATA_SZ];
+    bool isMatch = true;
+
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_SMALL_NUM; u16Idx++)
+    {
+        (void)Mcb_SimGetReg(0, TEST_NODE, (TEST_ADDR_SMALL + u16Idx), u16Value);
+        isMatch = ((isMatch != false) && (u16Value[0] == (uint16_t)(u16Seed + u16Idx)));
+    }
+
+    isMatch = ((isMatch != false) && (Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_LARGE, u16Value) == TEST_LARGE_SZ));
+    for (uint16_t u16Idx = (uint16_t)0U; u16Idx < TEST_LARGE_SZ; u16Idx++)
+    {
+        isMatch = ((isMatch != false) && (u16Value[u16Idx] == (uint16_t)(u16Seed + (uint16_t)0x100U + u16Idx)));
+    }
+
+    return isMatch;
+}
+
+static void Mcb_TestSetFw(uint16_t u16Build)
+{
+    uint16_t u16Version[4] = { (uint16_t)2U, (uint16_t)4U, (uint16_t)1U, u16Build };
+
+    Mcb_SimSetReg(0, TEST_NODE, MCB_DICT_ADDR_FW_VERSION, u16Version, (uint16_t)4U);
+}
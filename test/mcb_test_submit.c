@@ -0,0 +1,218 @@
+/**
+ * @file mcb_test_submit.c
+ * @brief Test of the requests completed through callbacks
+ *
+ * Requests submitted out of cyclic mode are served in order by Mcb_Poll and
+ * completed through their callbacks, which can submit new requests. A full
+ * queue rejects the request, and a request the slave never answers
+ * completes with an error once the instance timeout expires. In cyclic mode
+ * requests are completed by the cyclic functions, and in blocking mode
+ * before Mcb_Submit returns.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_CONFIG    (uint16_t)0x100U
+#define TEST_ADDR_SETPOINT  (uint16_t)0x200U
+#define TEST_ADDR_ACTUAL    (uint16_t)0x300U
+/** Instance timeout (ms) */
+#define TEST_TIMEOUT        (uint32_t)20UL
+/** Time given to the submitted requests before the test gives up (ms) */
+#define TEST_MAX_MILLIS     (uint32_t)1000UL
+/** Cycles given to a config over cyclic request */
+#define TEST_MAX_CYCLES     (uint16_t)64U
+
+static Mcb_TInst tInst;
+
+/** Completions, in call order */
+static Mcb_TMsg* ptCompl[MCB_SUBMIT_QUEUE_SZ + 2U];
+static uint8_t u8Compl;
+
+/** Request submitted from a completion callback, NULL if none */
+static Mcb_TMsg* ptChained;
+
+/**
+ * Completion callback, logs the message and submits the chained request
+ *
+ * @param[in] ptInst
+ *  Mcb instance
+ * @param[in] pMcbMsg
+ *  Completed message
+ */
+static void
+Mcb_TestCompl(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg);
+
+/**
+ * Prepares a request
+ *
+ * @param[out] pMcbMsg
+ *  Request
+ * @param[in] u16Addr
+ *  Register address
+ * @param[in] u16Value
+ *  Value written, if any
+ */
+static void
+Mcb_TestMsg(Mcb_TMsg* pMcbMsg, uint16_t u16Addr, uint16_t u16Value);
+
+/**
+ * Polls the instance until every submitted request is completed
+ *
+ * @retval true if every request completed
+ */
+static bool
+Mcb_TestPoll(void);
+
+/**
+ * Runs cyclic frames until a completion is logged
+ *
+ * @retval true if a request completed
+ */
+static bool
+Mcb_TestCycles(void);
+
+int main(void)
+{
+    Mcb_TMsg tMsg[MCB_SUBMIT_QUEUE_SZ + 1U];
+    Mcb_TMsg tNext;
+    uint16_t u16Value = (uint16_t)0x1111U;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_NON_BLOCKING, 0, true, TEST_TIMEOUT) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_SetNode(&tInst, TEST_NODE) != false);
+
+    /** Served in order, the first callback submits a request behind the queued one */
+    Mcb_TestMsg(&tMsg[0], TEST_ADDR_CONFIG, (uint16_t)0x2222U);
+    Mcb_TestMsg(&tMsg[1], TEST_ADDR_CONFIG, (uint16_t)0U);
+    Mcb_TestMsg(&tNext, TEST_ADDR_CONFIG, (uint16_t)0U);
+    ptChained = &tNext;
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[0], true) != false);
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[1], false) != false);
+    MCB_TEST_CHECK(Mcb_TestPoll() != false);
+    MCB_TEST_CHECK(u8Compl == (uint8_t)3U);
+    MCB_TEST_CHECK((ptCompl[0] == &tMsg[0]) && (ptCompl[1] == &tMsg[1]) && (ptCompl[2] == &tNext));
+    MCB_TEST_CHECK(tMsg[0].eStatus == MCB_WRITE_SUCCESS);
+    MCB_TEST_CHECK((tMsg[1].eStatus == MCB_READ_SUCCESS) && (tMsg[1].u16Data[0] == (uint16_t)0x2222U));
+    MCB_TEST_CHECK((tNext.eStatus == MCB_READ_SUCCESS) && (tNext.u16Data[0] == (uint16_t)0x2222U));
+
+    /** Full queue */
+    u8Compl = (uint8_t)0U;
+    for (uint8_t u8Idx = (uint8_t)0U; u8Idx < MCB_SUBMIT_QUEUE_SZ; u8Idx++)
+    {
+        Mcb_TestMsg(&tMsg[u8Idx], TEST_ADDR_CONFIG, (uint16_t)0U);
+        MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[u8Idx], false) != false);
+    }
+    Mcb_TestMsg(&tMsg[MCB_SUBMIT_QUEUE_SZ], TEST_ADDR_CONFIG, (uint16_t)0U);
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[MCB_SUBMIT_QUEUE_SZ], false) == false);
+    MCB_TEST_CHECK(Mcb_TestPoll() != false);
+    MCB_TEST_CHECK(u8Compl == MCB_SUBMIT_QUEUE_SZ);
+
+    /** The slave never answers, the request completes on timeout */
+    u8Compl = (uint8_t)0U;
+    Mcb_SimDeferIrq(0, true);
+    Mcb_TestMsg(&tMsg[0], TEST_ADDR_CONFIG, (uint16_t)0U);
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[0], false) != false);
+    MCB_TEST_CHECK(Mcb_TestPoll() != false);
+    MCB_TEST_CHECK((u8Compl == (uint8_t)1U) && (tMsg[0].eStatus == MCB_READ_ERROR));
+    Mcb_SimDeferIrq(0, false);
+    (void)Mcb_SimTakeIrq(0);
+    /** The late reply is dropped by the slave */
+    Mcb_SimResetNode(0, TEST_NODE);
+
+    /** Served again once the slave answers */
+    u8Compl = (uint8_t)0U;
+    Mcb_TestMsg(&tMsg[0], TEST_ADDR_CONFIG, (uint16_t)0U);
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[0], false) != false);
+    MCB_TEST_CHECK(Mcb_TestPoll() != false);
+    MCB_TEST_CHECK((u8Compl == (uint8_t)1U) && (tMsg[0].eStatus == MCB_READ_SUCCESS));
+
+    /** In cyclic mode, completed by the cyclic functions */
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_ACTUAL, &u16Value, (uint16_t)1U);
+    MCB_TEST_CHECK(Mcb_RxMap(&tInst, TEST_ADDR_SETPOINT, (uint16_t)2U) != NULL);
+    MCB_TEST_CHECK(Mcb_TxMap(&tInst, TEST_ADDR_ACTUAL, (uint16_t)2U) != NULL);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+
+    u8Compl = (uint8_t)0U;
+    Mcb_TestMsg(&tMsg[0], TEST_ADDR_CONFIG, (uint16_t)0x3333U);
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[0], true) != false);
+    MCB_TEST_CHECK(Mcb_TestCycles() != false);
+    MCB_TEST_CHECK((ptCompl[0] == &tMsg[0]) && (tMsg[0].eStatus == MCB_WRITE_SUCCESS));
+    Mcb_TestMsg(&tMsg[0], TEST_ADDR_CONFIG, (uint16_t)0U);
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[0], false) != false);
+    MCB_TEST_CHECK(Mcb_TestCycles() != false);
+    MCB_TEST_CHECK((tMsg[0].eStatus == MCB_READ_SUCCESS) && (tMsg[0].u16Data[0] == (uint16_t)0x3333U));
+    Mcb_Deinit(&tInst);
+
+    /** In blocking mode, completed before returning */
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, TEST_TIMEOUT) == MCB_INIT_OK);
+    u8Compl = (uint8_t)0U;
+    Mcb_TestMsg(&tMsg[0], TEST_ADDR_CONFIG, (uint16_t)0U);
+    MCB_TEST_CHECK(Mcb_Submit(&tInst, &tMsg[0], false) != false);
+    MCB_TEST_CHECK((u8Compl == (uint8_t)1U) && (tMsg[0].eStatus == MCB_READ_SUCCESS));
+    MCB_TEST_CHECK(tMsg[0].u16Data[0] == (uint16_t)0x3333U);
+    Mcb_Deinit(&tInst);
+
+    return Mcb_TestResult();
+}
+
+static void Mcb_TestCompl(Mcb_TInst* ptInst, Mcb_TMsg* pMcbMsg)
+{
+    Mcb_TMsg* ptNext = ptChained;
+
+    if (u8Compl < (uint8_t)(sizeof(ptCompl) / sizeof(ptCompl[0])))
+    {
+        ptCompl[u8Compl] = pMcbMsg;
+    }
+    u8Compl++;
+
+    if (ptNext != NULL)
+    {
+        ptChained = NULL;
+        MCB_TEST_CHECK(Mcb_Submit(ptInst, ptNext, false) != false);
+    }
+}
+
+static void Mcb_TestMsg(Mcb_TMsg* pMcbMsg, uint16_t u16Addr, uint16_t u16Value)
+{
+    pMcbMsg->u16Node = TEST_NODE;
+    pMcbMsg->u16Addr = u16Addr;
+    pMcbMsg->u16Size = (uint16_t)1U;
+    pMcbMsg->u16Data[0] = u16Value;
+    pMcbMsg->eStatus = MCB_STANDBY;
+    pMcbMsg->ComplEvnt = Mcb_TestCompl;
+    pMcbMsg->pUsrCtx = NULL;
+}
+
+static bool Mcb_TestPoll(void)
+{
+    uint32_t u32Millis = Mcb_GetMillis();
+    uint8_t u8Pending = Mcb_Poll(&tInst);
+
+    while ((u8Pending != (uint8_t)0U) && ((Mcb_GetMillis() - u32Millis) < TEST_MAX_MILLIS))
+    {
+        u8Pending = Mcb_Poll(&tInst);
+    }
+
+    return (u8Pending == (uint8_t)0U);
+}
+
+static bool Mcb_TestCycles(void)
+{
+    Mcb_EStatus eCfgStat;
+    uint8_t u8Compl0 = u8Compl;
+
+    for (uint16_t u16Cycle = (uint16_t)0U; (u16Cycle < TEST_MAX_CYCLES) && (u8Compl == u8Compl0); u16Cycle++)
+    {
+        if (Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false)
+        {
+            (void)Mcb_CyclicFrameProcess(&tInst);
+        }
+    }
+
+    return (u8Compl != u8Compl0);
+}
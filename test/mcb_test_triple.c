@@ -0,0 +1,204 @@
+/**
+ * @file mcb_test_triple.c
+ * @brief Test of the triple buffered cyclic transmission
+ *
+ * Setpoints written through the Mcb_RxMap pointers must only reach the slave
+ * once published, and the next cyclic frame must send the newest published
+ * set. A thread then keeps publishing pairs of setpoints derived from each
+ * other while the cyclic frames run, and the slave must never receive a
+ * pair mixing two sets.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define TEST_NODE           (uint16_t)1U
+/** Setpoint pair, 32 bits each */
+#define TEST_ADDR_FIRST     (uint16_t)0x200U
+#define TEST_ADDR_SECOND    (uint16_t)0x201U
+#define TEST_ADDR_ACTUAL    (uint16_t)0x300U
+/** Cyclic frames run while the publisher is writing setpoints */
+#define TEST_CYCLES         (uint32_t)100000UL
+
+static Mcb_TInst tInst;
+
+/** Setpoints written through the mapping pointers */
+static uint32_t* pu32First;
+static uint32_t* pu32Second;
+
+/** Set by the cyclic thread once it is done */
+static volatile bool isCyclicDone;
+
+/** Sets published */
+static uint32_t u32Published;
+
+/**
+ * Runs a cyclic frame
+ *
+ * @retval true if the received cyclic data is valid
+ */
+static bool
+Mcb_TestCycle(void);
+
+/**
+ * Writes a setpoint pair
+ *
+ * @param[in] u32Value
+ *  Value of the first setpoint, the second one is its complement
+ */
+static void
+Mcb_TestWrite(uint32_t u32Value);
+
+/**
+ * Reads the setpoint pair received by the slave
+ *
+ * @param[out] pu32Value
+ *  Value of the first setpoint
+ *
+ * @retval true if the second setpoint is the complement of the first one
+ */
+static bool
+Mcb_TestRead(uint32_t* pu32Value);
+
+/**
+ * Publishes setpoint pairs until the cyclic thread is done
+ *
+ * @param[in] pArg
+ *  Not used
+ *
+ * @retval NULL
+ */
+static void*
+Mcb_TestPublisher(void* pArg);
+
+int main(void)
+{
+    pthread_t tPublisher;
+    uint16_t u16Value = (uint16_t)0x1111U;
+    uint32_t u32Value;
+    uint32_t u32Last = (uint32_t)0UL;
+    uint32_t u32Torn = (uint32_t)0UL;
+    uint32_t u32Changes = (uint32_t)0UL;
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_ACTUAL, &u16Value, (uint16_t)1U);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    MCB_TEST_CHECK(Mcb_SetNode(&tInst, TEST_NODE) != false);
+
+    pu32First = (uint32_t*)Mcb_RxMap(&tInst, TEST_ADDR_FIRST, (uint16_t)4U);
+    pu32Second = (uint32_t*)Mcb_RxMap(&tInst, TEST_ADDR_SECOND, (uint16_t)4U);
+    MCB_TEST_CHECK((pu32First != NULL) && (pu32Second != NULL));
+    MCB_TEST_CHECK(Mcb_TxMap(&tInst, TEST_ADDR_ACTUAL, (uint16_t)2U) != NULL);
+
+    /** Setpoints written before enabling are sent from the first frame */
+    Mcb_TestWrite((uint32_t)0x1000UL);
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK((Mcb_TestRead(&u32Value) != false) && (u32Value == (uint32_t)0x1000UL));
+
+    /** Not published, not sent */
+    Mcb_TestWrite((uint32_t)0x2000UL);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK((Mcb_TestRead(&u32Value) != false) && (u32Value == (uint32_t)0x1000UL));
+
+    /** Sent on the next frame once published */
+    Mcb_CyclicTxPublish(&tInst);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK((Mcb_TestRead(&u32Value) != false) && (u32Value == (uint32_t)0x2000UL));
+
+    /** The newest of several published sets */
+    for (uint32_t u32Set = (uint32_t)0x3000UL; u32Set <= (uint32_t)0x3004UL; u32Set++)
+    {
+        Mcb_TestWrite(u32Set);
+        Mcb_CyclicTxPublish(&tInst);
+    }
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK((Mcb_TestRead(&u32Value) != false) && (u32Value == (uint32_t)0x3004UL));
+
+    /** Sets published from another thread while the frames run */
+    isCyclicDone = false;
+    MCB_TEST_CHECK(pthread_create(&tPublisher, NULL, Mcb_TestPublisher, NULL) == 0);
+
+    for (uint32_t u32Cycle = (uint32_t)0UL; u32Cycle < TEST_CYCLES; u32Cycle++)
+    {
+        (void)Mcb_TestCycle();
+        (void)sched_yield();
+
+        if (Mcb_TestRead(&u32Value) == false)
+        {
+            u32Torn++;
+        }
+        else if (u32Value != u32Last)
+        {
+            u32Changes++;
+            u32Last = u32Value;
+        }
+        else
+        {
+            /** Nothing published since the last frame */
+        }
+    }
+
+    isCyclicDone = true;
+    (void)pthread_join(tPublisher, NULL);
+
+    printf("%lu cycles, %lu sets published, %lu received\n", (unsigned long)TEST_CYCLES,
+           (unsigned long)u32Published, (unsigned long)u32Changes);
+    MCB_TEST_CHECK(u32Torn == (uint32_t)0UL);
+    MCB_TEST_CHECK(u32Changes > (uint32_t)0UL);
+
+    return Mcb_TestResult();
+}
+
+static bool Mcb_TestCycle(void)
+{
+    Mcb_EStatus eCfgStat;
+
+    MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+
+    return Mcb_CyclicFrameProcess(&tInst);
+}
+
+static void Mcb_TestWrite(uint32_t u32Value)
+{
+    *pu32First = u32Value;
+    *pu32Second = ~u32Value;
+}
+
+static bool Mcb_TestRead(uint32_t* pu32Value)
+{
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+    uint32_t u32Second;
+
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_FIRST, u16Data);
+    memcpy((void*)pu32Value, (const void*)u16Data, sizeof(uint32_t));
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_SECOND, u16Data);
+    memcpy((void*)&u32Second, (const void*)u16Data, sizeof(uint32_t));
+
+    return (u32Second == ~(*pu32Value));
+}
+
+static void* Mcb_TestPublisher(void* pArg)
+{
+    (void)pArg;
+
+    while (isCyclicDone == false)
+    {
+        u32Published++;
+
+        /** Let the frames run between both setpoints, a half written set must not be sent */
+        *pu32First = (uint32_t)0x10000UL + u32Published;
+        (void)sched_yield();
+        *pu32Second = ~(*pu32First);
+        Mcb_CyclicTxPublish(&tInst);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file mcb_test_zero_copy.c
+ * @brief Test of the zero-copy cyclic buffers
+ *
+ * Setpoints written through the Mcb_RxMap pointers before enabling cyclic
+ * mode must survive the config frames sent meanwhile, and values read
+ * through the Mcb_TxMap pointers must only change on frames with a valid CRC.
+ *
+ * @author  Firmware department
+ * @copyright Ingenia Motion Control (c) 2018. All rights reserved.
+ */
+
+#include "mcb_test_sim.h"
+
+#define TEST_NODE           (uint16_t)1U
+#define TEST_ADDR_SETPOINT  (uint16_t)0x100U
+#define TEST_ADDR_ACTUAL    (uint16_t)0x200U
+#define TEST_ADDR_CONFIG    (uint16_t)0x300U
+
+static Mcb_TInst tInst;
+
+/**
+ * Runs a cyclic transfer and processes its reply
+ *
+ * @retval true if the received cyclic data is valid
+ */
+static bool
+Mcb_TestCycle(void);
+
+int main(void)
+{
+    Mcb_TMsg tMsg;
+    uint16_t u16Value = (uint16_t)0xAAAAU;
+    uint16_t u16Data[MCB_MAX_DATA_SZ];
+
+    Mcb_SimInit();
+    Mcb_SimAttach(0, &tInst.tIntf);
+    MCB_TEST_CHECK(Mcb_Init(&tInst, MCB_BLOCKING, 0, true, (uint32_t)100UL) == MCB_INIT_OK);
+    Mcb_SetNode(&tInst, TEST_NODE);
+
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_ACTUAL, &u16Value, (uint16_t)1U);
+    Mcb_SimSetInfo(0, TEST_NODE, TEST_ADDR_SETPOINT, RW_ACCESS, (uint8_t)1U);
+    Mcb_SimSetInfo(0, TEST_NODE, TEST_ADDR_ACTUAL, RW_ACCESS, (uint8_t)1U);
+
+    uint16_t* pu16Setpoint = (uint16_t*)Mcb_RxMap(&tInst, TEST_ADDR_SETPOINT, (uint16_t)2U);
+    uint16_t* pu16Actual = (uint16_t*)Mcb_TxMap(&tInst, TEST_ADDR_ACTUAL, (uint16_t)2U);
+    MCB_TEST_CHECK((pu16Setpoint != NULL) && (pu16Actual != NULL));
+    if ((pu16Setpoint == NULL) || (pu16Actual == NULL))
+    {
+        return Mcb_TestResult();
+    }
+
+    /** Initial setpoint, followed by config traffic before enabling cyclic mode */
+    *pu16Setpoint = (uint16_t)0x1234U;
+
+    tMsg.u16Node = TEST_NODE;
+    tMsg.u16Addr = TEST_ADDR_CONFIG;
+    tMsg.u16Size = (uint16_t)1U;
+    tMsg.u16Data[0] = (uint16_t)0x5555U;
+    tInst.Mcb_Write(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_WRITE_SUCCESS);
+    tInst.Mcb_Read(&tInst, &tMsg);
+    MCB_TEST_CHECK(tMsg.eStatus == MCB_READ_SUCCESS);
+    MCB_TEST_CHECK(*pu16Setpoint == (uint16_t)0x1234U);
+
+    MCB_TEST_CHECK(Mcb_EnableCyclic(&tInst) > 0);
+    MCB_TEST_CHECK(*pu16Setpoint == (uint16_t)0x1234U);
+
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_SETPOINT, u16Data);
+    MCB_TEST_CHECK(u16Data[0] == (uint16_t)0x1234U);
+    MCB_TEST_CHECK(*pu16Actual == (uint16_t)0xAAAAU);
+
+    /** A corrupted frame must not reach the application */
+    u16Value = (uint16_t)0xBBBBU;
+    Mcb_SimSetReg(0, TEST_NODE, TEST_ADDR_ACTUAL, &u16Value, (uint16_t)1U);
+    Mcb_SimCorruptEvery(0, (uint32_t)1UL);
+    MCB_TEST_CHECK(Mcb_TestCycle() == false);
+    MCB_TEST_CHECK(*pu16Actual == (uint16_t)0xAAAAU);
+
+    Mcb_SimCorruptEvery(0, (uint32_t)0UL);
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    MCB_TEST_CHECK(*pu16Actual == (uint16_t)0xBBBBU);
+
+    /** Setpoints are still sent in place */
+    *pu16Setpoint = (uint16_t)0x4321U;
+    MCB_TEST_CHECK(Mcb_TestCycle() != false);
+    (void)Mcb_SimGetReg(0, TEST_NODE, TEST_ADDR_SETPOINT, u16Data);
+    MCB_TEST_CHECK(u16Data[0] == (uint16_t)0x4321U);
+
+    return Mcb_TestResult();
+}
+
+static bool Mcb_TestCycle(void)
+{
+    Mcb_EStatus eCfgStat;
+
+    MCB_TEST_CHECK(Mcb_CyclicProcessLatch(&tInst, &eCfgStat) != false);
+
+    return Mcb_CyclicFrameProcess(&tInst);
+}